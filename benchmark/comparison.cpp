@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <mixme/gift/comparison.hpp>
+#include <mixme/gift/memberwise.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace mixme::gift;
+
+namespace
+{
+	/// Long keys sharing a prefix, equality derived from two calls of <
+	struct Less_key : comparison::all<Less_key>
+	{
+		explicit Less_key(std::string text) : text(std::move(text)) {}
+		std::string text;
+	};
+	bool operator<(const Less_key& lhs, const Less_key& rhs) { return lhs.text < rhs.text; }
+
+	/// Same keys, every operator derived from a single compare
+	struct Compare_key : comparison::three_way<Compare_key>
+	{
+		explicit Compare_key(std::string text) : text(std::move(text)) {}
+		int compare(const Compare_key& other) const { return text.compare(other.text); }
+		std::string text;
+	};
+
+	template <typename Key>
+	std::vector<Key> make_text_keys()
+	{
+		std::vector<Key> keys;
+		for (std::size_t i = 0; i < 64; ++i)
+		{
+			keys.emplace_back(std::string(1024, 'k') + std::to_string(i / 2 % 8));
+		}
+		return keys;
+	}
+
+	template <typename Key>
+	void text_equal(benchmark::State& state)
+	{
+		const auto keys = make_text_keys<Key>();
+		for (auto _ : state)
+		{
+			std::size_t equal = 0;
+			for (std::size_t i = 1; i < keys.size(); ++i)
+			{
+				equal += keys[i - 1] == keys[i];
+			}
+			benchmark::DoNotOptimize(equal);
+		}
+		state.SetItemsProcessed(state.iterations() * (keys.size() - 1));
+	}
+
+	BENCHMARK_TEMPLATE(text_equal, Less_key);
+	BENCHMARK_TEMPLATE(text_equal, Compare_key);
+
+#ifdef MIXME_HAS_AUTO_TEMPLATE_PARAMETER
+	struct Address_fields
+	{
+		std::uint8_t bytes[12];
+		std::uint16_t port;
+	};
+
+	/// Hand-written lexicographic chain over the members
+	struct Tied_address : Address_fields
+	{
+		auto tie() const { return std::tie(bytes[0], bytes[1], bytes[2], bytes[3], bytes[4], bytes[5], bytes[6],
+				bytes[7], bytes[8], bytes[9], bytes[10], bytes[11], port); }
+	};
+	bool operator==(const Tied_address& lhs, const Tied_address& rhs) { return lhs.tie() == rhs.tie(); }
+
+	/// Same members, compared with a single memcmp
+	struct Memberwise_address : Address_fields,
+			comparison::memberwise<Memberwise_address, &Address_fields::bytes, &Address_fields::port> {};
+
+	template <typename Address>
+	void address_equal(benchmark::State& state)
+	{
+		std::vector<Address> addresses(256);
+		for (std::size_t i = 0; i < addresses.size(); ++i)
+		{
+			for (std::size_t b = 0; b < 12; ++b)
+			{
+				addresses[i].bytes[b] = static_cast<std::uint8_t>(b);
+			}
+			addresses[i].port = static_cast<std::uint16_t>(i % 4);
+		}
+		for (auto _ : state)
+		{
+			std::size_t equal = 0;
+			for (std::size_t i = 1; i < addresses.size(); ++i)
+			{
+				equal += addresses[i - 1] == addresses[i];
+			}
+			benchmark::DoNotOptimize(equal);
+		}
+		state.SetItemsProcessed(state.iterations() * (addresses.size() - 1));
+	}
+
+	BENCHMARK_TEMPLATE(address_equal, Tied_address);
+	BENCHMARK_TEMPLATE(address_equal, Memberwise_address);
+#endif
+}
+
+BENCHMARK_MAIN();
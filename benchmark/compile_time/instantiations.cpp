@@ -0,0 +1,95 @@
+// Translation unit compiled by benchmark_compile_time: instantiates the comparison gifts and the history
+// wrappers for MIXME_COMPILE_TIME_TYPES distinct types
+#include <mixme/gift/comparison.hpp>
+#include <mixme/wrap/history.hpp>
+#include <utility>
+
+#ifndef MIXME_COMPILE_TIME_TYPES
+	#define MIXME_COMPILE_TIME_TYPES 100
+#endif
+
+using namespace mixme;
+
+namespace
+{
+	/// Gets the operators derived from <
+	template <int I>
+	struct Less : gift::comparison::all<Less<I>>
+	{
+		int value;
+	};
+
+	template <int I>
+	bool operator<(const Less<I>& lhs, const Less<I>& rhs) { return lhs.value < rhs.value; }
+
+	/// Gets the operators derived from <=, after the other chains fail
+	template <int I>
+	struct Less_equal : gift::comparison::all<Less_equal<I>>
+	{
+		int value;
+	};
+
+	template <int I>
+	bool operator<=(const Less_equal<I>& lhs, const Less_equal<I>& rhs) { return lhs.value <= rhs.value; }
+
+	/// Gets the operators derived from compare
+	template <int I>
+	struct Three_way : gift::comparison::three_way<Three_way<I>>
+	{
+		int compare(const Three_way& other) const { return value - other.value; }
+		int value;
+	};
+
+	template <int I>
+	struct State
+	{
+		int values[4];
+	};
+
+	template <typename T>
+	int compare_all(const T& lhs, const T& rhs)
+	{
+		return (lhs == rhs) + (lhs != rhs) + (lhs < rhs) + (lhs <= rhs) + (lhs > rhs) + (lhs >= rhs);
+	}
+
+	template <typename T>
+	int edit(T& history)
+	{
+		history.save();
+		(*history).values[0]++;
+		history.undo();
+		return (*history).values[0];
+	}
+
+	template <int I>
+	int instantiate()
+	{
+		wrap::redoable<State<I>> single{};
+		wrap::undoable<State<I>, wrap::array_storage<State<I>, 4>> array{};
+		wrap::redoable<State<I>, wrap::vector_storage<State<I>>> vector{};
+		int result = compare_all(Less<I>{{}, I}, Less<I>{{}, I + 1});
+		result += compare_all(Less_equal<I>{{}, I}, Less_equal<I>{{}, I + 1});
+		result += compare_all(Three_way<I>{{}, I}, Three_way<I>{{}, I + 1});
+		result += edit(single) + edit(array) + edit(vector);
+		single.redo();
+		vector.redo();
+		return result;
+	}
+
+	template <int... I>
+	int instantiate_all(std::integer_sequence<int, I...>)
+	{
+		const int results[] = {instantiate<I>()...};
+		int sum = 0;
+		for (int result : results)
+		{
+			sum += result;
+		}
+		return sum;
+	}
+}
+
+int main()
+{
+	return instantiate_all(std::make_integer_sequence<int, MIXME_COMPILE_TIME_TYPES>()) == 0;
+}
@@ -0,0 +1,89 @@
+// Measures the compilation time and memory of instantiations.cpp for growing numbers of types, with the
+// detection mechanisms selected by the standard and with the C++14 ones forced by MIXME_LEGACY_DETECTION
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct Measure
+	{
+		bool success;
+		double wall; // seconds
+		double cpu; // seconds
+		double peak; // megabytes
+	};
+
+	double seconds(const timeval& time) { return static_cast<double>(time.tv_sec) + time.tv_usec / 1e6; }
+
+	Measure compile(int types, bool legacy)
+	{
+		std::vector<std::string> args = {MIXME_CXX_COMPILER, MIXME_CXX_STANDARD_OPTION, "-fsyntax-only",
+				"-I" MIXME_INCLUDE_DIR, "-DMIXME_COMPILE_TIME_TYPES=" + std::to_string(types), MIXME_SOURCE};
+		if (legacy)
+		{
+			args.push_back("-DMIXME_LEGACY_DETECTION");
+		}
+		std::vector<char*> argv;
+		for (std::string& arg : args)
+		{
+			argv.push_back(&arg[0]);
+		}
+		argv.push_back(nullptr);
+
+		const auto start = std::chrono::steady_clock::now();
+		const pid_t pid = fork();
+		if (pid == 0)
+		{
+			execvp(argv[0], argv.data());
+			_exit(127);
+		}
+		int status = 0;
+		rusage usage{};
+		if (pid < 0 || wait4(pid, &status, 0, &usage) != pid)
+		{
+			return {false, 0, 0, 0};
+		}
+		const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+		return {WIFEXITED(status) && WEXITSTATUS(status) == 0,
+				wall.count(),
+				seconds(usage.ru_utime) + seconds(usage.ru_stime),
+				usage.ru_maxrss / 1024.0};
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<int> counts;
+	for (int i = 1; i < argc; ++i)
+	{
+		counts.push_back(std::atoi(argv[i]));
+	}
+	if (counts.empty())
+	{
+		counts = {25, 50, 100};
+	}
+
+	std::printf("%-8s %-10s %10s %10s %12s %14s\n", "types", "detection", "wall [s]", "cpu [s]", "peak [MiB]",
+			"cpu/type [ms]");
+	for (int types : counts)
+	{
+		for (bool legacy : {false, true})
+		{
+			const Measure measure = compile(types, legacy);
+			if (!measure.success)
+			{
+				std::fprintf(stderr, "compilation with %d types failed\n", types);
+				return EXIT_FAILURE;
+			}
+			std::printf("%-8d %-10s %10.2f %10.2f %12.1f %14.2f\n", types, legacy ? "legacy" : "default",
+					measure.wall, measure.cpu, measure.peak, 1000 * measure.cpu / types);
+		}
+	}
+	return EXIT_SUCCESS;
+}
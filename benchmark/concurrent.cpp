@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+#include <mixme/wrap/concurrent.hpp>
+#include <mixme/wrap/history.hpp>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace mixme::wrap;
+
+namespace
+{
+	typedef std::vector<int> Document_t;
+
+	/// Editor thread modifying, saving and undoing while the benchmark threads read
+	class Writer
+	{
+	public:
+		template <typename F>
+		void start(F edit)
+		{
+			running_ = true;
+			thread_ = std::thread([this, edit]
+			{
+				for (int n = 1; running_.load(std::memory_order_relaxed); ++n)
+				{
+					edit(n);
+				}
+			});
+		}
+
+		void stop()
+		{
+			running_ = false;
+			thread_.join();
+		}
+	private:
+		std::atomic<bool> running_{false};
+		std::thread thread_;
+	};
+
+	void concurrent_read(benchmark::State& state)
+	{
+		static concurrent_redoable<Document_t> document(Document_t(256, 0));
+		static Writer writer;
+		if (state.thread_index() == 0)
+		{
+			writer.start([](int n)
+			{
+				document.modify([n](Document_t& value) { std::fill(value.begin(), value.end(), n); });
+				if (n % 4 == 0)
+				{
+					document.save();
+				}
+				if (n % 8 == 0)
+				{
+					document.undo();
+				}
+			});
+		}
+		for (auto _ : state)
+		{
+			auto view = document.read();
+			benchmark::DoNotOptimize(view->back());
+		}
+		if (state.thread_index() == 0)
+		{
+			writer.stop();
+		}
+	}
+
+	void locked_read(benchmark::State& state)
+	{
+		static redoable<Document_t, vector_storage<Document_t>> document(Document_t(256, 0));
+		static std::mutex mutex;
+		static Writer writer;
+		if (state.thread_index() == 0)
+		{
+			writer.start([](int n)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				std::fill(document->begin(), document->end(), n);
+				if (n % 4 == 0)
+				{
+					document.save();
+				}
+				if (n % 8 == 0)
+				{
+					document.undo();
+				}
+			});
+		}
+		for (auto _ : state)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			benchmark::DoNotOptimize(document->back());
+		}
+		if (state.thread_index() == 0)
+		{
+			writer.stop();
+		}
+	}
+}
+
+BENCHMARK(concurrent_read)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(locked_read)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+#include <mixme/gift/hash.hpp>
+
+#ifdef MIXME_HAS_AUTO_TEMPLATE_PARAMETER
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <unordered_set>
+#include <vector>
+
+using namespace mixme::gift;
+
+namespace
+{
+	struct Key_fields
+	{
+		std::uint32_t user;
+		std::uint32_t session;
+		std::uint64_t stamp;
+	};
+
+	struct Key : Key_fields, comparison::memberwise<Key, &Key_fields::user, &Key_fields::session, &Key_fields::stamp>,
+			hash<Key> {};
+
+	/// The usual hand-written hash: std::hash of each member, combined boost-style
+	struct Combined_hash
+	{
+		std::size_t operator()(const Key& key) const
+		{
+			std::size_t seed = std::hash<std::uint32_t>{}(key.user);
+			seed ^= std::hash<std::uint32_t>{}(key.session) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			seed ^= std::hash<std::uint64_t>{}(key.stamp) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			return seed;
+		}
+	};
+
+	std::vector<Key> make_keys()
+	{
+		std::vector<Key> keys(4096);
+		for (std::size_t i = 0; i < keys.size(); ++i)
+		{
+			keys[i].user = static_cast<std::uint32_t>(i % 64);
+			keys[i].session = static_cast<std::uint32_t>(i / 64);
+			keys[i].stamp = 1000000 + i * 4096;
+		}
+		return keys;
+	}
+
+	template <typename Hash>
+	void key_lookup(benchmark::State& state)
+	{
+		const auto keys = make_keys();
+		const std::unordered_set<Key, Hash> set(keys.begin(), keys.end());
+		for (auto _ : state)
+		{
+			std::size_t found = 0;
+			for (const Key& key : keys)
+			{
+				found += set.count(key);
+			}
+			benchmark::DoNotOptimize(found);
+		}
+		state.SetItemsProcessed(state.iterations() * keys.size());
+	}
+
+	// libstdc++ hashes integers as themselves, so the combined hash is cheaper here, with worse mixing
+	BENCHMARK_TEMPLATE(key_lookup, Combined_hash);
+	BENCHMARK_TEMPLATE(key_lookup, hasher<Key>);
+
+	struct Path_fields
+	{
+		std::string directory;
+		std::string name;
+	};
+
+	struct Path : Path_fields, comparison::memberwise<Path, &Path_fields::directory, &Path_fields::name>, hash<Path>
+	{
+		Path(std::string directory, std::string name) : Path_fields{std::move(directory), std::move(name)} {}
+	};
+
+	struct Combined_path_hash
+	{
+		std::size_t operator()(const Path& path) const
+		{
+			std::size_t seed = std::hash<std::string>{}(path.directory);
+			seed ^= std::hash<std::string>{}(path.name) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			return seed;
+		}
+	};
+
+	template <typename Hash>
+	void path_lookup(benchmark::State& state)
+	{
+		std::vector<Path> paths;
+		for (std::size_t i = 0; i < 4096; ++i)
+		{
+			paths.emplace_back("/home/user/projects/mixme/build/" + std::to_string(i % 64),
+					"object_file_" + std::to_string(i / 64) + ".o");
+		}
+		const std::unordered_set<Path, Hash> set(paths.begin(), paths.end());
+		for (auto _ : state)
+		{
+			std::size_t found = 0;
+			for (const Path& path : paths)
+			{
+				found += set.count(path);
+			}
+			benchmark::DoNotOptimize(found);
+		}
+		state.SetItemsProcessed(state.iterations() * paths.size());
+	}
+
+	BENCHMARK_TEMPLATE(path_lookup, Combined_path_hash);
+	BENCHMARK_TEMPLATE(path_lookup, hasher<Path>);
+
+	template <typename Hash>
+	void text_hash(benchmark::State& state)
+	{
+		const std::string text(static_cast<std::size_t>(state.range(0)), 't');
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(Hash{}(text));
+		}
+		state.SetBytesProcessed(state.iterations() * state.range(0));
+	}
+
+	BENCHMARK_TEMPLATE(text_hash, std::hash<std::string>)->Arg(16)->Arg(256)->Arg(4096);
+	BENCHMARK_TEMPLATE(text_hash, hasher<std::string>)->Arg(16)->Arg(256)->Arg(4096);
+}
+
+#endif
+
+BENCHMARK_MAIN();
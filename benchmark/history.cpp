@@ -0,0 +1,246 @@
+#include <benchmark/benchmark.h>
+#include <support/allocation_counter.hpp>
+#include <mixme/wrap/history.hpp>
+#include <mixme/wrap/boxed.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mixme::wrap;
+
+namespace
+{
+	/// Plain state, eligible for the raw memory fast path
+	template <std::size_t Size>
+	struct Trivial_state
+	{
+		unsigned char data[Size];
+	};
+
+	/// Same layout as Trivial_state, but going through the generic path
+	template <std::size_t Size>
+	struct Generic_state
+	{
+		Generic_state() = default;
+		Generic_state(const Generic_state& other) { std::copy(other.data, other.data + Size, data); }
+		Generic_state& operator=(const Generic_state& other)
+		{
+			std::copy(other.data, other.data + Size, data);
+			return *this;
+		}
+		~Generic_state() {}
+
+		unsigned char data[Size];
+	};
+
+	/// Owns its data on the heap, so it can only be moved to and from the history
+	template <std::size_t Size>
+	struct Move_only_state
+	{
+		Move_only_state() : data(new unsigned char[Size]()) {}
+
+		std::unique_ptr<unsigned char[]> data;
+	};
+
+	/// Owns its data on the heap, copied on every save
+	typedef std::vector<unsigned char> Heap_state;
+
+	/// Owns its characters on the heap, copied on every save
+	typedef std::string Text_state;
+
+	/// Same as Generic_state<4096>, but out of line: undo and redo exchange pointers
+	typedef boxed<Generic_state<4096>> Boxed_state;
+
+	/// Same as Heap_state, but relocated as raw bytes instead of being moved
+	struct Relocatable_heap_state : Heap_state, mixme::gift::trivially_relocatable<Relocatable_heap_state>
+	{
+		using Heap_state::Heap_state;
+	};
+
+	template <std::size_t Size>
+	void touch(Trivial_state<Size>& value) { value.data[0]++; }
+
+	template <std::size_t Size>
+	void touch(Generic_state<Size>& value) { value.data[0]++; }
+
+	template <std::size_t Size>
+	void touch(Move_only_state<Size>& value)
+	{
+		// Saving moved the data out
+		value.data.reset(new unsigned char[Size]());
+	}
+
+	void touch(Heap_state& value) { value[0]++; }
+
+	void touch(Text_state& value) { value[0]++; }
+
+	template <typename State>
+	State make_state() { return State(); }
+
+	template <>
+	Heap_state make_state<Heap_state>() { return Heap_state(4096); }
+
+	template <>
+	Text_state make_state<Text_state>() { return Text_state(4096, 'x'); }
+
+	template <>
+	Relocatable_heap_state make_state<Relocatable_heap_state>() { return Relocatable_heap_state(4096); }
+
+	template <typename Wrapper>
+	void save_undo(benchmark::State& state)
+	{
+		typedef typename Wrapper::value_type State;
+		Wrapper value(make_state<State>());
+		{
+			bench::allocation_report allocations(state);
+			for (auto _ : state)
+			{
+				value.save();
+				touch(*value);
+				value.undo();
+				benchmark::DoNotOptimize(value);
+			}
+		}
+	}
+
+	template <typename Wrapper>
+	void save_undo_redo(benchmark::State& state)
+	{
+		typedef typename Wrapper::value_type State;
+		Wrapper value(make_state<State>());
+		{
+			bench::allocation_report allocations(state);
+			for (auto _ : state)
+			{
+				value.save();
+				touch(*value);
+				value.undo();
+				value.redo();
+				benchmark::DoNotOptimize(value);
+			}
+		}
+	}
+
+	/**
+	 * Undoes and redoes a save per iteration. Only the transitions are measured: saving copies the value,
+	 * so the history is refilled with the timer paused and the allocations made meanwhile are not counted
+	 */
+	template <typename Wrapper>
+	void undo_redo(benchmark::State& state)
+	{
+		typedef typename Wrapper::value_type State;
+		Wrapper value(make_state<State>());
+		const std::size_t depth = std::min<std::size_t>(value.max_saves(), 16);
+		std::size_t allocations = 0;
+		std::size_t allocated_bytes = 0;
+		for (auto _ : state)
+		{
+			if (!value.has_save())
+			{
+				state.PauseTiming();
+				while (value.saves() < depth)
+				{
+					value.save();
+				}
+				state.ResumeTiming();
+			}
+			const std::size_t previous_allocations = bench::allocation_counter::allocations();
+			const std::size_t previous_bytes = bench::allocation_counter::bytes();
+			value.undo();
+			value.redo();
+			allocations += bench::allocation_counter::allocations() - previous_allocations;
+			allocated_bytes += bench::allocation_counter::bytes() - previous_bytes;
+			benchmark::DoNotOptimize(value);
+		}
+		state.counters["allocs/op"] = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+		state.counters["alloc_bytes/op"] =
+				benchmark::Counter(static_cast<double>(allocated_bytes), benchmark::Counter::kAvgIterations);
+	}
+
+	/// Moves a full history back and forth: 2 x 64 elements per iteration
+	template <typename State>
+	void move_array_history(benchmark::State& state)
+	{
+		typedef redoable<State, array_storage<State, 64>> Redo_t;
+		Redo_t value(make_state<State>());
+		while (value.saves() < value.max_saves())
+		{
+			value.save();
+		}
+		for (auto _ : state)
+		{
+			Redo_t moved = std::move(value);
+			value = std::move(moved);
+			benchmark::DoNotOptimize(value);
+		}
+	}
+
+	template <typename State>
+	void copy_array_history(benchmark::State& state)
+	{
+		typedef undoable<State, array_storage<State, 64>> Undo_t;
+		Undo_t value(make_state<State>());
+		for (int n = 0; n < 4; ++n)
+		{
+			value.save();
+		}
+		{
+			bench::allocation_report allocations(state);
+			for (auto _ : state)
+			{
+				Undo_t copy = value;
+				benchmark::DoNotOptimize(copy);
+			}
+		}
+	}
+}
+
+// Every state through every storage policy
+#define MIXME_HISTORY_BENCHMARKS(State) \
+	BENCHMARK_TEMPLATE(save_undo, undoable<State>); \
+	BENCHMARK_TEMPLATE(save_undo, undoable<State, array_storage<State, 16>>); \
+	BENCHMARK_TEMPLATE(save_undo, undoable<State, ring_storage<State, 16>>); \
+	BENCHMARK_TEMPLATE(save_undo, undoable<State, vector_storage<State>>); \
+	BENCHMARK_TEMPLATE(save_undo_redo, redoable<State>); \
+	BENCHMARK_TEMPLATE(save_undo_redo, redoable<State, array_storage<State, 16>>); \
+	BENCHMARK_TEMPLATE(save_undo_redo, redoable<State, ring_storage<State, 16>>); \
+	BENCHMARK_TEMPLATE(save_undo_redo, redoable<State, vector_storage<State>>)
+
+MIXME_HISTORY_BENCHMARKS(Trivial_state<16>);
+MIXME_HISTORY_BENCHMARKS(Generic_state<16>);
+MIXME_HISTORY_BENCHMARKS(Trivial_state<4096>);
+MIXME_HISTORY_BENCHMARKS(Generic_state<4096>);
+MIXME_HISTORY_BENCHMARKS(Move_only_state<4096>);
+MIXME_HISTORY_BENCHMARKS(Heap_state);
+MIXME_HISTORY_BENCHMARKS(Text_state);
+
+// Cost of the instrumentation
+BENCHMARK_TEMPLATE(save_undo,
+		undoable<Trivial_state<16>, single_element_storage<Trivial_state<16>>, counting_instrumentation>);
+BENCHMARK_TEMPLATE(save_undo_redo,
+		redoable<Heap_state, vector_storage<Heap_state>, counting_instrumentation>);
+
+// Heap owning payloads only move between the saves, the value and the edits
+#define MIXME_TRANSITION_BENCHMARKS(State) \
+	BENCHMARK_TEMPLATE(undo_redo, redoable<State, array_storage<State, 16>>); \
+	BENCHMARK_TEMPLATE(undo_redo, redoable<State, ring_storage<State, 16>>); \
+	BENCHMARK_TEMPLATE(undo_redo, redoable<State, vector_storage<State>>)
+
+MIXME_TRANSITION_BENCHMARKS(Text_state);
+MIXME_TRANSITION_BENCHMARKS(Heap_state);
+MIXME_TRANSITION_BENCHMARKS(Relocatable_heap_state);
+MIXME_TRANSITION_BENCHMARKS(Generic_state<4096>);
+MIXME_TRANSITION_BENCHMARKS(Boxed_state);
+
+BENCHMARK_TEMPLATE(move_array_history, Heap_state);
+BENCHMARK_TEMPLATE(move_array_history, Relocatable_heap_state);
+
+BENCHMARK_TEMPLATE(copy_array_history, Trivial_state<16>);
+BENCHMARK_TEMPLATE(copy_array_history, Generic_state<16>);
+BENCHMARK_TEMPLATE(copy_array_history, Trivial_state<4096>);
+BENCHMARK_TEMPLATE(copy_array_history, Generic_state<4096>);
+BENCHMARK_TEMPLATE(copy_array_history, Heap_state);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,53 @@
+#include <support/allocation_counter.hpp>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	thread_local std::size_t allocations = 0;
+	thread_local std::size_t allocated_bytes = 0;
+
+	void* allocate(std::size_t size)
+	{
+		allocations++;
+		allocated_bytes += size;
+		if (void* p = std::malloc(size ? size : 1))
+		{
+			return p;
+		}
+		throw std::bad_alloc();
+	}
+}
+
+namespace bench
+{
+	std::size_t allocation_counter::allocations() noexcept { return ::allocations; }
+
+	std::size_t allocation_counter::bytes() noexcept { return allocated_bytes; }
+}
+
+// The array and nothrow forms forward to these by default
+void* operator new(std::size_t size) { return allocate(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+#ifdef __cpp_aligned_new
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	allocations++;
+	allocated_bytes += size;
+	const std::size_t align = static_cast<std::size_t>(alignment);
+	const std::size_t rounded = (size) ? (size + align - 1) / align * align : align;
+	if (void* p = std::aligned_alloc(align, rounded))
+	{
+		return p;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+#endif
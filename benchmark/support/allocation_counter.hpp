@@ -0,0 +1,43 @@
+#ifndef MIXME_BENCHMARK_SUPPORT_ALLOCATION_COUNTER_HPP_
+#define MIXME_BENCHMARK_SUPPORT_ALLOCATION_COUNTER_HPP_
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+
+namespace bench
+{
+	/// Allocations made by the calling thread through the global operator new, which the benchmarks replace
+	struct allocation_counter
+	{
+		static std::size_t allocations() noexcept;
+
+		static std::size_t bytes() noexcept;
+	};
+
+	/// Reports the allocations made by the calling thread during its lifetime, per benchmark iteration
+	class allocation_report
+	{
+	public:
+		explicit allocation_report(benchmark::State& state)
+		: state_(state), allocations_(allocation_counter::allocations()), bytes_(allocation_counter::bytes())
+		{}
+
+		allocation_report(const allocation_report&) = delete;
+
+		allocation_report& operator=(const allocation_report&) = delete;
+
+		~allocation_report()
+		{
+			state_.counters["allocs/op"] = benchmark::Counter(
+					static_cast<double>(allocation_counter::allocations() - allocations_), benchmark::Counter::kAvgIterations);
+			state_.counters["alloc_bytes/op"] = benchmark::Counter(
+					static_cast<double>(allocation_counter::bytes() - bytes_), benchmark::Counter::kAvgIterations);
+		}
+	private:
+		benchmark::State& state_;
+		std::size_t allocations_;
+		std::size_t bytes_;
+	};
+}
+
+#endif
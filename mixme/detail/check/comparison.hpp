@@ -13,7 +13,13 @@
 #ifndef MIXME_DETAIL_CHECK_COMPARISON_HPP_
 #define MIXME_DETAIL_CHECK_COMPARISON_HPP_
 
+#include <mixme/detail/config.hpp>
 #include <type_traits>
+#include <utility>
+
+#ifdef MIXME_HAS_THREE_WAY_COMPARISON
+	#include <compare>
+#endif
 
 namespace mixme
 {
@@ -28,66 +34,230 @@ namespace mixme
 				template <typename T, typename U>
 				No operator==(const T&, const U&);
 
+#ifdef MIXME_HAS_CONCEPTS
+				template <typename T, typename U>
+				concept declares_eq = !std::is_same_v<decltype(std::declval<T&>() == std::declval<U&>()), No>;
+
+				/**
+				 * Whether T has an equal to operator declared
+				 */
+				template <typename T, typename U = T>
+				constexpr bool eq_v = declares_eq<T, U>;
+#else
+				/**
+				 * Whether T has an equal to operator declared
+				 */
+				template <typename T, typename U = T>
+				constexpr bool eq_v = !std::is_same<decltype(*(T*)(nullptr) == *(U*)(nullptr)), No>::value;
+#endif
+
 				/**
 				 * Checks whether T has an equal to operator declared
 				 */
 				template <typename T, typename U = T>
-				struct eq : std::integral_constant<bool,
-						!std::is_same<decltype(*(T*)(nullptr) == *(U*)(nullptr)), No>::value> {};
+				struct eq : std::integral_constant<bool, eq_v<T, U>> {};
 
 				template <typename T, typename U>
 				No operator!=(const T&, const U&);
 
+#ifdef MIXME_HAS_CONCEPTS
+				template <typename T, typename U>
+				concept declares_ne = !std::is_same_v<decltype(std::declval<T&>() != std::declval<U&>()), No>;
+
+				/**
+				 * Whether T has a not equal to operator declared
+				 */
+				template <typename T, typename U = T>
+				constexpr bool ne_v = declares_ne<T, U>;
+#else
+				/**
+				 * Whether T has a not equal to operator declared
+				 */
+				template <typename T, typename U = T>
+				constexpr bool ne_v = !std::is_same<decltype(*(T*)(nullptr) != *(U*)(nullptr)), No>::value;
+#endif
+
 				/**
 				 * Checks whether T has a not equal to operator declared
 				 */
 				template <typename T, typename U = T>
-				struct ne : std::integral_constant<bool,
-						!std::is_same<decltype(*(T*)(nullptr) != *(U*)(nullptr)), No>::value> {};
+				struct ne : std::integral_constant<bool, ne_v<T, U>> {};
 
 				template <typename T, typename U>
 				No operator<(const T&, const U&);
 
+#ifdef MIXME_HAS_CONCEPTS
+				template <typename T, typename U>
+				concept declares_lt = !std::is_same_v<decltype(std::declval<T&>() < std::declval<U&>()), No>;
+
+				/**
+				 * Whether T has a less than operator declared
+				 */
+				template <typename T, typename U = T>
+				constexpr bool lt_v = declares_lt<T, U>;
+#else
+				/**
+				 * Whether T has a less than operator declared
+				 */
+				template <typename T, typename U = T>
+				constexpr bool lt_v = !std::is_same<decltype(*(T*)(nullptr) < *(U*)(nullptr)), No>::value;
+#endif
+
 				/**
 				 * Checks whether T has a less than operator declared
 				 */
 				template <typename T, typename U = T>
-				struct lt : std::integral_constant<bool,
-						!std::is_same<decltype(*(T*)(nullptr) < *(U*)(nullptr)), No>::value> {};
+				struct lt : std::integral_constant<bool, lt_v<T, U>> {};
 
 				template <typename T, typename U>
 				No operator>(const T&, const U&);
 
+#ifdef MIXME_HAS_CONCEPTS
+				template <typename T, typename U>
+				concept declares_gt = !std::is_same_v<decltype(std::declval<T&>() > std::declval<U&>()), No>;
+
+				/**
+				 * Whether T has a greater than operator declared
+				 */
+				template <typename T, typename U = T>
+				constexpr bool gt_v = declares_gt<T, U>;
+#else
+				/**
+				 * Whether T has a greater than operator declared
+				 */
+				template <typename T, typename U = T>
+				constexpr bool gt_v = !std::is_same<decltype(*(T*)(nullptr) > *(U*)(nullptr)), No>::value;
+#endif
+
 				/**
 				 * Checks whether T has a greater than operator declared
 				 */
 				template <typename T, typename U = T>
-				struct gt : std::integral_constant<bool,
-						!std::is_same<decltype(*(T*)(nullptr) > *(U*)(nullptr)), No>::value> {};
+				struct gt : std::integral_constant<bool, gt_v<T, U>> {};
 
 				template <typename T, typename U>
 				No operator<=(const T&, const U&);
 
+#ifdef MIXME_HAS_CONCEPTS
+				template <typename T, typename U>
+				concept declares_le = !std::is_same_v<decltype(std::declval<T&>() <= std::declval<U&>()), No>;
+
+				/**
+				 * Whether T has a less than or equal to operator declared
+				 */
+				template <typename T, typename U = T>
+				constexpr bool le_v = declares_le<T, U>;
+#else
+				/**
+				 * Whether T has a less than or equal to operator declared
+				 */
+				template <typename T, typename U = T>
+				constexpr bool le_v = !std::is_same<decltype(*(T*)(nullptr) <= *(U*)(nullptr)), No>::value;
+#endif
+
 				/**
 				 * Checks whether T has a less than or equal to operator declared
 				 */
 				template <typename T, typename U = T>
-				struct le : std::integral_constant<bool,
-						!std::is_same<decltype(*(T*)(nullptr) <= *(U*)(nullptr)), No>::value> {};
+				struct le : std::integral_constant<bool, le_v<T, U>> {};
 
 				template <typename T, typename U>
 				No operator>=(const T&, const U&);
 
+#ifdef MIXME_HAS_CONCEPTS
+				template <typename T, typename U>
+				concept declares_ge = !std::is_same_v<decltype(std::declval<T&>() >= std::declval<U&>()), No>;
+
+				/**
+				 * Whether T has a greater than or equal to operator declared
+				 */
+				template <typename T, typename U = T>
+				constexpr bool ge_v = declares_ge<T, U>;
+#else
+				/**
+				 * Whether T has a greater than or equal to operator declared
+				 */
+				template <typename T, typename U = T>
+				constexpr bool ge_v = !std::is_same<decltype(*(T*)(nullptr) >= *(U*)(nullptr)), No>::value;
+#endif
+
 				/**
 				 * Checks whether T has a greater than or equal to operator declared
 				 */
 				template <typename T, typename U = T>
-				struct ge : std::integral_constant<bool,
-						!std::is_same<decltype(*(T*)(nullptr) >= *(U*)(nullptr)), No>::value> {};
+				struct ge : std::integral_constant<bool, ge_v<T, U>> {};
+
+#ifdef MIXME_HAS_CONCEPTS
+				template <typename T, typename U = T>
+				constexpr bool compare_v = requires(const T& lhs, const U& rhs) { lhs.compare(rhs) < 0; };
+#else
+				template <typename T, typename U>
+				struct compare_impl
+				{
+					template <typename V, typename W>
+					static auto test(V*) -> decltype(std::declval<const V&>().compare(std::declval<const W&>()) < 0,
+							std::true_type{});
+
+					template <typename, typename>
+					static auto test(...) -> std::false_type;
+
+					using type = decltype(test<T, U>(nullptr));
+				};
+
+				/**
+				 * Whether T has a compare member function, returning a value comparable to 0 like std::string::compare
+				 */
+				template <typename T, typename U = T>
+				constexpr bool compare_v = compare_impl<T, U>::type::value;
+#endif
+
+				/**
+				 * Checks whether T has a compare member function, returning a value
+				 * comparable to 0 like std::string::compare
+				 */
+				template <typename T, typename U = T>
+				struct compare : std::integral_constant<bool, compare_v<T, U>> {};
+
+#if defined(MIXME_HAS_CONCEPTS) && defined(MIXME_HAS_THREE_WAY_COMPARISON)
+				template <typename T, typename U = T>
+				constexpr bool three_way_v = requires(const T& lhs, const U& rhs) { lhs <=> rhs < 0; };
+#else
+				template <typename T, typename U>
+				struct three_way_impl
+				{
+#ifdef MIXME_HAS_THREE_WAY_COMPARISON
+					template <typename V, typename W>
+					static auto test(V*) -> decltype(std::declval<const V&>() <=> std::declval<const W&>() < 0,
+							std::true_type{});
+#endif
+
+					template <typename, typename>
+					static auto test(...) -> std::false_type;
+
+					using type = decltype(test<T, U>(nullptr));
+				};
+
+				/**
+				 * Whether T has a three-way comparison operator declared. Always false before C++20
+				 */
+				template <typename T, typename U = T>
+				constexpr bool three_way_v = three_way_impl<T, U>::type::value;
+#endif
+
+				/**
+				 * Checks whether T has a three-way comparison operator declared.
+				 * Always false before C++20
+				 */
+				template <typename T, typename U = T>
+				struct three_way : std::integral_constant<bool, three_way_v<T, U>> {};
 			}
 
 			namespace comparison_lax // check comparisons keeping track of inheritance
 			{
+#ifdef MIXME_HAS_CONCEPTS
+				template <typename T, typename U = T>
+				constexpr bool eq_v = requires { requires std::is_same_v<decltype(std::declval<T>() == std::declval<U>()), bool>; };
+#else
 				template <typename T, typename Y>
 				struct eq_impl
 				{
@@ -100,12 +270,20 @@ namespace mixme
 				    static constexpr auto value = std::is_same<bool, decltype(test<T, Y>(0))>::value;
 				};
 
+				template <typename T, typename U = T>
+				constexpr bool eq_v = eq_impl<T, U>::value;
+#endif
+
 				/**
 				 * Checks whether T has an equal to operator declared
 				 */
 				template <typename T, typename U = T>
-				struct eq : std::integral_constant<bool, eq_impl<T, T>::value> {};
+				struct eq : std::integral_constant<bool, eq_v<T, T>> {};
 
+#ifdef MIXME_HAS_CONCEPTS
+				template <typename T, typename U = T>
+				constexpr bool ne_v = requires { requires std::is_same_v<decltype(std::declval<T>() != std::declval<U>()), bool>; };
+#else
 				template <typename T, typename Y>
 				struct ne_impl
 				{
@@ -118,12 +296,20 @@ namespace mixme
 				    static constexpr auto value = std::is_same<bool, decltype(test<T, Y>(0))>::value;
 				};
 
+				template <typename T, typename U = T>
+				constexpr bool ne_v = ne_impl<T, U>::value;
+#endif
+
 				/**
 				 * Checks whether T has a not equal to operator declared
 				 */
 				template <typename T, typename U = T>
-				struct ne : std::integral_constant<bool, ne_impl<T, T>::value> {};
+				struct ne : std::integral_constant<bool, ne_v<T, T>> {};
 
+#ifdef MIXME_HAS_CONCEPTS
+				template <typename T, typename U = T>
+				constexpr bool lt_v = requires { requires std::is_same_v<decltype(std::declval<T>() < std::declval<U>()), bool>; };
+#else
 				template <typename T, typename Y>
 				struct lt_impl
 				{
@@ -136,12 +322,20 @@ namespace mixme
 				    static constexpr auto value = std::is_same<bool, decltype(test<T, Y>(0))>::value;
 				};
 
+				template <typename T, typename U = T>
+				constexpr bool lt_v = lt_impl<T, U>::value;
+#endif
+
 				/**
 				 * Checks whether T has a less than operator declared
 				 */
 				template <typename T, typename U = T>
-				struct lt : std::integral_constant<bool, lt_impl<T, T>::value> {};
+				struct lt : std::integral_constant<bool, lt_v<T, T>> {};
 
+#ifdef MIXME_HAS_CONCEPTS
+				template <typename T, typename U = T>
+				constexpr bool gt_v = requires { requires std::is_same_v<decltype(std::declval<T>() > std::declval<U>()), bool>; };
+#else
 				template <typename T, typename Y>
 				struct gt_impl
 				{
@@ -154,12 +348,20 @@ namespace mixme
 				    static constexpr auto value = std::is_same<bool, decltype(test<T, Y>(0))>::value;
 				};
 
+				template <typename T, typename U = T>
+				constexpr bool gt_v = gt_impl<T, U>::value;
+#endif
+
 				/**
 				 * Checks whether T has a greater than operator declared
 				 */
 				template <typename T, typename U = T>
-				struct gt : std::integral_constant<bool, gt_impl<T, T>::value> {};
+				struct gt : std::integral_constant<bool, gt_v<T, T>> {};
 
+#ifdef MIXME_HAS_CONCEPTS
+				template <typename T, typename U = T>
+				constexpr bool le_v = requires { requires std::is_same_v<decltype(std::declval<T>() <= std::declval<U>()), bool>; };
+#else
 				template <typename T, typename Y>
 				struct le_impl
 				{
@@ -172,12 +374,20 @@ namespace mixme
 				    static constexpr auto value = std::is_same<bool, decltype(test<T, Y>(0))>::value;
 				};
 
+				template <typename T, typename U = T>
+				constexpr bool le_v = le_impl<T, U>::value;
+#endif
+
 				/**
 				 * Checks whether T has a less than or equal to operator declared
 				 */
 				template <typename T, typename U = T>
-				struct le : std::integral_constant<bool, le_impl<T, T>::value> {};
+				struct le : std::integral_constant<bool, le_v<T, T>> {};
 
+#ifdef MIXME_HAS_CONCEPTS
+				template <typename T, typename U = T>
+				constexpr bool ge_v = requires { requires std::is_same_v<decltype(std::declval<T>() >= std::declval<U>()), bool>; };
+#else
 				template <typename T, typename Y>
 				struct ge_impl
 				{
@@ -190,11 +400,15 @@ namespace mixme
 				    static constexpr auto value = std::is_same<bool, decltype(test<T, Y>(0))>::value;
 				};
 
+				template <typename T, typename U = T>
+				constexpr bool ge_v = ge_impl<T, U>::value;
+#endif
+
 				/**
 				 * Checks whether T has a greater than or equal to operator declared
 				 */
 				template <typename T, typename U = T>
-				struct ge : std::integral_constant<bool, ge_impl<T, T>::value> {};
+				struct ge : std::integral_constant<bool, ge_v<T, T>> {};
 			}
 		}
 	}
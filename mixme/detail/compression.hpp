@@ -0,0 +1,232 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_DETAIL_COMPRESSION_HPP_
+#define MIXME_DETAIL_COMPRESSION_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include <stdexcept>
+
+namespace mixme
+{
+	namespace detail
+	{
+		/**
+		 * Small byte oriented LZ codec, tuned for redundant data such as sparse buffers.
+		 *
+		 * Format: the varint raw size, followed by tokens.
+		 * - A control byte c < 0x80 introduces c + 1 literal bytes.
+		 * - A control byte c >= 0x80 introduces a match of (c & 0x7F) + min_match bytes (0x7F means that a varint
+		 *   with the remaining length follows), followed by the varint distance of the match.
+		 * Runs of a repeated byte are matches at distance 1.
+		 */
+		namespace lz
+		{
+			constexpr std::size_t min_match = 4;
+			constexpr std::size_t max_literals = 0x80;
+			constexpr std::size_t hash_bits = 12;
+
+			inline void put_varint(std::vector<unsigned char>& out, std::size_t value)
+			{
+				while (value >= 0x80)
+				{
+					out.push_back(static_cast<unsigned char>(value | 0x80));
+					value >>= 7;
+				}
+				out.push_back(static_cast<unsigned char>(value));
+			}
+
+			inline std::size_t get_varint(const unsigned char*& in, const unsigned char* end)
+			{
+				std::size_t value = 0;
+				for (unsigned shift = 0; in != end; shift += 7)
+				{
+					const unsigned char byte = *in++;
+					const std::size_t bits = byte & 0x7F;
+					// Longer than any encoded size_t, or with bits past its width
+					if (shift >= std::numeric_limits<std::size_t>::digits || (bits << shift) >> shift != bits)
+					{
+						throw std::runtime_error("mixme: corrupted compressed data");
+					}
+					value |= bits << shift;
+					if (!(byte & 0x80))
+					{
+						return value;
+					}
+				}
+				throw std::runtime_error("mixme: truncated compressed data");
+			}
+
+			inline std::uint32_t hash(const unsigned char* p) noexcept
+			{
+				std::uint32_t v;
+				std::memcpy(&v, p, sizeof(v));
+				return (v * 2654435761u) >> (32 - hash_bits);
+			}
+
+			inline void put_literals(std::vector<unsigned char>& out, const unsigned char* first, std::size_t count)
+			{
+				while (count > 0)
+				{
+					const std::size_t chunk = (count < max_literals) ? count : max_literals;
+					out.push_back(static_cast<unsigned char>(chunk - 1));
+					out.insert(out.end(), first, first + chunk);
+					first += chunk;
+					count -= chunk;
+				}
+			}
+
+			inline void put_match(std::vector<unsigned char>& out, std::size_t length, std::size_t distance)
+			{
+				const std::size_t code = length - min_match;
+				if (code < 0x7F)
+				{
+					out.push_back(static_cast<unsigned char>(0x80 | code));
+				}
+				else
+				{
+					out.push_back(0xFF);
+					put_varint(out, code - 0x7F);
+				}
+				put_varint(out, distance);
+			}
+
+			/// Position of the last occurrence of each hash, kept between calls to spare an allocation per call
+			inline std::vector<std::size_t>& table()
+			{
+				thread_local std::vector<std::size_t> positions(std::size_t(1) << hash_bits);
+				return positions;
+			}
+
+			inline std::size_t match_length(const unsigned char* a, const unsigned char* b, const unsigned char* end)
+			noexcept
+			{
+				const unsigned char* start = b;
+				while (b != end && *a == *b)
+				{
+					a++;
+					b++;
+				}
+				return static_cast<std::size_t>(b - start);
+			}
+		}
+
+		/**
+		 * Appends the compressed form of [src, src + size) to out
+		 */
+		inline void compress(const unsigned char* src, std::size_t size, std::vector<unsigned char>& out)
+		{
+			lz::put_varint(out, size);
+			std::vector<std::size_t>& table = lz::table();
+			std::fill(table.begin(), table.end(), size);
+			const unsigned char* const end = src + size;
+			std::size_t literals = 0; // pending literals, ending at i
+			std::size_t i = 0;
+			while (i + lz::min_match <= size)
+			{
+				std::size_t length = 0;
+				std::size_t distance = 0;
+				// Run length pass: repetitions of the previous byte
+				if (i > 0 && src[i] == src[i - 1])
+				{
+					length = lz::match_length(src + i - 1, src + i, end);
+					distance = 1;
+				}
+				// Dictionary pass
+				const std::uint32_t h = lz::hash(src + i);
+				const std::size_t candidate = table[h];
+				table[h] = i;
+				if (length < lz::min_match && candidate < i)
+				{
+					const std::size_t candidate_length = lz::match_length(src + candidate, src + i, end);
+					if (candidate_length > length)
+					{
+						length = candidate_length;
+						distance = i - candidate;
+					}
+				}
+				if (length >= lz::min_match)
+				{
+					lz::put_literals(out, src + i - literals, literals);
+					literals = 0;
+					lz::put_match(out, length, distance);
+					i += length;
+				}
+				else
+				{
+					literals++;
+					i++;
+				}
+			}
+			lz::put_literals(out, src + i - literals, literals + (size - i));
+		}
+
+		/**
+		 * Decompresses data produced by compress into out
+		 */
+		inline void decompress(const unsigned char* src, std::size_t size, std::vector<unsigned char>& out)
+		{
+			const unsigned char* in = src;
+			const unsigned char* const end = src + size;
+			const std::size_t raw_size = lz::get_varint(in, end);
+			out.resize(raw_size);
+			std::size_t o = 0;
+			while (in != end)
+			{
+				const unsigned char control = *in++;
+				if (control < 0x80)
+				{
+					const std::size_t count = std::size_t(control) + 1;
+					if (count > static_cast<std::size_t>(end - in) || count > raw_size - o)
+					{
+						throw std::runtime_error("mixme: corrupted compressed data");
+					}
+					std::memcpy(out.data() + o, in, count);
+					in += count;
+					o += count;
+				}
+				else
+				{
+					std::size_t length = (control & 0x7F) + lz::min_match;
+					if ((control & 0x7F) == 0x7F)
+					{
+						length += lz::get_varint(in, end);
+					}
+					const std::size_t distance = lz::get_varint(in, end);
+					if (distance == 0 || distance > o || length > raw_size - o)
+					{
+						throw std::runtime_error("mixme: corrupted compressed data");
+					}
+					// Byte by byte, since the source may overlap the destination
+					unsigned char* dst = out.data() + o;
+					const unsigned char* from = dst - distance;
+					for (std::size_t k = 0; k < length; k++)
+					{
+						dst[k] = from[k];
+					}
+					o += length;
+				}
+			}
+			if (o != raw_size)
+			{
+				throw std::runtime_error("mixme: truncated compressed data");
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,81 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_DETAIL_CONFIG_HPP_
+#define MIXME_DETAIL_CONFIG_HPP_
+
+/**
+ * Feature detection for optional parts of the library
+ */
+
+#if defined(__has_include)
+	#if __has_include(<version>)
+		#include <version>
+	#endif
+#endif
+
+#if defined(__has_cpp_attribute)
+	#if __has_cpp_attribute(no_unique_address)
+		#define MIXME_NO_UNIQUE_ADDRESS [[no_unique_address]]
+	#endif
+#endif
+
+#ifndef MIXME_NO_UNIQUE_ADDRESS
+	#define MIXME_NO_UNIQUE_ADDRESS
+#endif
+
+#if defined(__has_include)
+	#if __cplusplus >= 201703L && __has_include(<memory_resource>)
+		#define MIXME_HAS_MEMORY_RESOURCE 1
+	#endif
+#endif
+
+#if defined(__has_include)
+	#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+		#define MIXME_HAS_MMAP 1
+	#endif
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && defined(__cpp_lib_three_way_comparison)
+	#define MIXME_HAS_THREE_WAY_COMPARISON 1
+#endif
+
+/**
+ * Cheaper trait detection and dispatch: concepts and if constexpr replace the C++14 overload sets where
+ * available. Define MIXME_LEGACY_DETECTION to keep the C++14 mechanisms, e.g. to compare compilation costs
+ */
+#ifndef MIXME_LEGACY_DETECTION
+	#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+		#define MIXME_HAS_CONCEPTS 1
+	#endif
+
+	#if defined(__cpp_if_constexpr)
+		#define MIXME_HAS_IF_CONSTEXPR 1
+	#endif
+#endif
+
+#if defined(__cpp_nontype_template_parameter_auto) && defined(__cpp_fold_expressions)
+	#define MIXME_HAS_AUTO_TEMPLATE_PARAMETER 1
+#endif
+
+/**
+ * C++20 constant evaluation of the histories: MIXME_CONSTEXPR20 marks the functions becoming constexpr
+ */
+#if defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_constexpr_dynamic_alloc) \
+		&& defined(__cpp_lib_is_constant_evaluated)
+	#define MIXME_HAS_CONSTEXPR_HISTORY 1
+	#define MIXME_CONSTEXPR20 constexpr
+#else
+	#define MIXME_CONSTEXPR20
+#endif
+
+#endif
@@ -0,0 +1,152 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef MIXME_DETAIL_HASH_HPP_
+#define MIXME_DETAIL_HASH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace mixme
+{
+	namespace detail
+	{
+		/**
+		 * Byte hashing in the style of wyhash: inputs are read 8 bytes at a time and folded with
+		 * 64 x 64 -> 128 bit multiplications. Short inputs take a couple of overlapping reads, without loops.
+		 * Results are only meant for in-memory tables: they differ between little and big endian targets.
+		 */
+		namespace wy
+		{
+			constexpr std::uint64_t secret[] = {
+					0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+			/** Multiplies a by b, leaving the low half of the product in a and the high half in b */
+			inline void multiply(std::uint64_t& a, std::uint64_t& b) noexcept
+			{
+#ifdef __SIZEOF_INT128__
+				const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+				a = static_cast<std::uint64_t>(product);
+				b = static_cast<std::uint64_t>(product >> 64);
+#else
+				const std::uint64_t a_high = a >> 32, a_low = static_cast<std::uint32_t>(a);
+				const std::uint64_t b_high = b >> 32, b_low = static_cast<std::uint32_t>(b);
+				const std::uint64_t high = a_high * b_high, middle_1 = a_high * b_low, middle_2 = a_low * b_high;
+				const std::uint64_t low = a_low * b_low;
+				const std::uint64_t cross = (low >> 32) + static_cast<std::uint32_t>(middle_1) + middle_2;
+				a = (cross << 32) | static_cast<std::uint32_t>(low);
+				b = high + (middle_1 >> 32) + (cross >> 32);
+#endif
+			}
+
+			/** Folds the 128 bit product of a and b into 64 bits */
+			inline std::uint64_t mix(std::uint64_t a, std::uint64_t b) noexcept
+			{
+				multiply(a, b);
+				return a ^ b;
+			}
+
+			inline std::uint64_t read8(const unsigned char* p) noexcept
+			{
+				std::uint64_t v;
+				std::memcpy(&v, p, sizeof(v));
+				return v;
+			}
+
+			inline std::uint64_t read4(const unsigned char* p) noexcept
+			{
+				std::uint32_t v;
+				std::memcpy(&v, p, sizeof(v));
+				return v;
+			}
+
+			/** Reads 1 to 3 bytes */
+			inline std::uint64_t read3(const unsigned char* p, std::size_t size) noexcept
+			{
+				return (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[size >> 1]) << 8)
+						| p[size - 1];
+			}
+		}
+
+		/**
+		 * @returns The hash of size bytes starting at data. Chaining the result as the seed of the next call
+		 * hashes a sequence of blocks
+		 */
+		inline std::uint64_t hash_bytes(const void* data, std::size_t size, std::uint64_t seed = 0) noexcept
+		{
+			const unsigned char* p = static_cast<const unsigned char*>(data);
+			seed ^= wy::mix(seed ^ wy::secret[0], wy::secret[1]);
+			std::uint64_t a, b;
+			if (size <= 16)
+			{
+				if (size >= 4)
+				{
+					const std::size_t middle = (size >> 3) << 2;
+					a = (wy::read4(p) << 32) | wy::read4(p + middle);
+					b = (wy::read4(p + size - 4) << 32) | wy::read4(p + size - 4 - middle);
+				}
+				else if (size > 0)
+				{
+					a = wy::read3(p, size);
+					b = 0;
+				}
+				else
+				{
+					a = b = 0;
+				}
+			}
+			else
+			{
+				std::size_t left = size;
+				if (left > 48)
+				{
+					std::uint64_t seed_1 = seed, seed_2 = seed;
+					do
+					{
+						seed = wy::mix(wy::read8(p) ^ wy::secret[1], wy::read8(p + 8) ^ seed);
+						seed_1 = wy::mix(wy::read8(p + 16) ^ wy::secret[2], wy::read8(p + 24) ^ seed_1);
+						seed_2 = wy::mix(wy::read8(p + 32) ^ wy::secret[3], wy::read8(p + 40) ^ seed_2);
+						p += 48;
+						left -= 48;
+					}
+					while (left > 48);
+					seed ^= seed_1 ^ seed_2;
+				}
+				while (left > 16)
+				{
+					seed = wy::mix(wy::read8(p) ^ wy::secret[1], wy::read8(p + 8) ^ seed);
+					p += 16;
+					left -= 16;
+				}
+				a = wy::read8(p + left - 16);
+				b = wy::read8(p + left - 8);
+			}
+			a ^= wy::secret[1];
+			b ^= seed;
+			wy::multiply(a, b);
+			return wy::mix(a ^ wy::secret[0] ^ size, b ^ wy::secret[1]);
+		}
+
+		/** @returns The hash of an integer, cheaper than hashing its bytes. Also combines two hashes */
+		inline std::uint64_t hash_integer(std::uint64_t value, std::uint64_t seed = 0) noexcept
+		{
+			std::uint64_t a = value ^ wy::secret[0];
+			std::uint64_t b = seed ^ wy::secret[1];
+			wy::multiply(a, b);
+			return wy::mix(a ^ wy::secret[0], b ^ wy::secret[1]);
+		}
+	}
+}
+
+#endif
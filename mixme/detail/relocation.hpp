@@ -0,0 +1,51 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_DETAIL_RELOCATION_HPP_
+#define MIXME_DETAIL_RELOCATION_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <mixme/gift/type_properties.hpp>
+
+namespace mixme
+{
+	namespace detail
+	{
+		/**
+		 * Whether T is trivially relocatable without being trivially copyable: its moves can be replaced
+		 * by raw byte copies, but the compiler won't do it on its own
+		 */
+		template <typename T>
+		struct relocates_bytes : std::integral_constant<bool,
+				mixme::gift::is_trivially_relocatable<T>::value && !std::is_trivially_copyable<T>::value> {};
+
+		/**
+		 * Exchanges the bytes of the n objects starting at lhs and rhs.
+		 * Only valid for trivially relocatable types: both sides keep a live object
+		 */
+		template <typename T>
+		void swap_bytes(T* lhs, T* rhs, std::size_t n) noexcept
+		{
+			unsigned char* first = reinterpret_cast<unsigned char*>(lhs);
+			std::swap_ranges(first, first + n * sizeof(T), reinterpret_cast<unsigned char*>(rhs));
+		}
+
+		template <typename T>
+		void swap_bytes(T& lhs, T& rhs) noexcept
+		{
+			detail::swap_bytes(&lhs, &rhs, 1);
+		}
+	}
+}
+
+#endif
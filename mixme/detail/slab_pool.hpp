@@ -0,0 +1,198 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_DETAIL_SLAB_POOL_HPP_
+#define MIXME_DETAIL_SLAB_POOL_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace mixme
+{
+	namespace detail
+	{
+		/// Rounds size up to the block size class serving it
+		constexpr std::size_t slab_size_class(std::size_t size, std::size_t align)
+		{
+			return (size + align - 1) / align * align;
+		}
+
+		/**
+		 * Process wide pool of fixed size blocks, carved out of large slabs.
+		 * Each thread keeps its own free list and exchanges blocks with the shared one in batches,
+		 * so that the common path takes no lock.
+		 * Slabs are never returned to the system: the pool only grows up to the peak number of live blocks.
+		 */
+		template <std::size_t Size, std::size_t Align>
+		class slab_pool
+		{
+		public:
+			static void* allocate();
+
+			static void deallocate(void* p) noexcept;
+		private:
+			struct free_block
+			{
+				free_block* next;
+			};
+
+			static constexpr std::size_t block_align = (Align > alignof(free_block)) ? Align : alignof(free_block);
+			static constexpr std::size_t block_size =
+					slab_size_class((Size > sizeof(free_block)) ? Size : sizeof(free_block), block_align);
+			static constexpr std::size_t slab_bytes = 64 * 1024;
+			static constexpr std::size_t blocks_per_slab = (slab_bytes / block_size > 0) ? slab_bytes / block_size : 1;
+			static constexpr std::size_t batch = 32;
+
+			struct shared_list
+			{
+				std::mutex mutex;
+				free_block* head = nullptr;
+			};
+
+			struct local_list
+			{
+				free_block* head;
+				std::size_t count;
+				bool retired; // the owning thread is exiting
+			};
+
+			/// Gives the thread's blocks back to the shared list when the thread exits
+			struct local_guard
+			{
+				~local_guard();
+			};
+
+			static shared_list& shared();
+
+			static local_list& local() noexcept;
+
+			static void refill(local_list& list);
+
+			static void give_back(local_list& list, std::size_t count) noexcept;
+		};
+
+		template <std::size_t Size, std::size_t Align>
+		typename slab_pool<Size, Align>::shared_list& slab_pool<Size, Align>::shared()
+		{
+			// Never destroyed, so that blocks can be released during static destruction
+			static shared_list* list = new shared_list();
+			return *list;
+		}
+
+		template <std::size_t Size, std::size_t Align>
+		typename slab_pool<Size, Align>::local_list& slab_pool<Size, Align>::local() noexcept
+		{
+			// Trivially destructible, thus still usable by destructors running at thread exit
+			thread_local local_list list = {nullptr, 0, false};
+			thread_local local_guard guard;
+			(void)guard;
+			return list;
+		}
+
+		template <std::size_t Size, std::size_t Align>
+		slab_pool<Size, Align>::local_guard::~local_guard()
+		{
+			local_list& list = local();
+			give_back(list, list.count);
+			list.retired = true;
+		}
+
+		template <std::size_t Size, std::size_t Align>
+		void* slab_pool<Size, Align>::allocate()
+		{
+			local_list& list = local();
+			if (!list.head)
+			{
+				refill(list);
+			}
+			free_block* block = list.head;
+			list.head = block->next;
+			list.count--;
+			return block;
+		}
+
+		template <std::size_t Size, std::size_t Align>
+		void slab_pool<Size, Align>::deallocate(void* p) noexcept
+		{
+			local_list& list = local();
+			free_block* block = static_cast<free_block*>(p);
+			block->next = list.head;
+			list.head = block;
+			list.count++;
+			if (list.retired)
+			{
+				give_back(list, list.count);
+			}
+			else if (list.count >= 2 * batch)
+			{
+				give_back(list, batch);
+			}
+		}
+
+		template <std::size_t Size, std::size_t Align>
+		void slab_pool<Size, Align>::refill(local_list& list)
+		{
+			shared_list& pool = shared();
+			{
+				std::lock_guard<std::mutex> lock(pool.mutex);
+				for (std::size_t i = 0; i < batch && pool.head; i++)
+				{
+					free_block* block = pool.head;
+					pool.head = block->next;
+					block->next = list.head;
+					list.head = block;
+					list.count++;
+				}
+			}
+			if (list.head)
+			{
+				return;
+			}
+			void* memory = ::operator new(blocks_per_slab * block_size + block_align - 1);
+			unsigned char* slab = static_cast<unsigned char*>(memory) +
+					(block_align - reinterpret_cast<std::uintptr_t>(memory) % block_align) % block_align;
+			for (std::size_t i = blocks_per_slab; i > 0; i--)
+			{
+				free_block* block = reinterpret_cast<free_block*>(slab + (i - 1) * block_size);
+				block->next = list.head;
+				list.head = block;
+			}
+			list.count += blocks_per_slab;
+		}
+
+		template <std::size_t Size, std::size_t Align>
+		void slab_pool<Size, Align>::give_back(local_list& list, std::size_t count) noexcept
+		{
+			if (count == 0)
+			{
+				return;
+			}
+			free_block* first = list.head;
+			free_block* last = first;
+			for (std::size_t i = 1; i < count; i++)
+			{
+				last = last->next;
+			}
+			list.head = last->next;
+			list.count -= count;
+
+			shared_list& pool = shared();
+			std::lock_guard<std::mutex> lock(pool.mutex);
+			last->next = pool.head;
+			pool.head = first;
+		}
+	}
+}
+
+#endif
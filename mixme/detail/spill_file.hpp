@@ -0,0 +1,303 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef MIXME_DETAIL_SPILL_FILE_HPP_
+#define MIXME_DETAIL_SPILL_FILE_HPP_
+
+#include <mixme/detail/config.hpp>
+
+#ifdef MIXME_HAS_MMAP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace mixme
+{
+	namespace detail
+	{
+		/**
+		 * Append only sequence of byte records kept in a memory mapped temporary file.
+		 * The file is unlinked as soon as it is created, so it disappears with the process, and it is only
+		 * created by the first push_back.
+		 *
+		 * Records are removed from the back, truncating the file, or from the front: the dead prefix is
+		 * compacted away once it is larger than the live records.
+		 */
+		class spill_file
+		{
+		public:
+			spill_file() noexcept = default;
+
+			spill_file(const spill_file& other);
+
+			spill_file(spill_file&& other) noexcept;
+
+			spill_file& operator=(const spill_file& other);
+
+			spill_file& operator=(spill_file&& other) noexcept;
+
+			~spill_file();
+
+			/// Appends a record holding a copy of size bytes from data
+			void push_back(const unsigned char* data, std::size_t size);
+
+			/// @returns The bytes of the most recent record, read in place from the mapping
+			const unsigned char* back_data() const noexcept { return map_ + records_.back().offset; }
+
+			std::size_t back_size() const noexcept { return records_.back().size; }
+
+			void pop_back() noexcept;
+
+			void pop_front() noexcept;
+
+			void clear() noexcept;
+
+			bool empty() const noexcept { return records_.empty(); }
+
+			/// @returns The number of records
+			std::size_t size() const noexcept { return records_.size(); }
+
+			/// @returns The bytes taken by the records in the file
+			std::size_t bytes() const noexcept { return end_ - begin_; }
+		private:
+			struct record
+			{
+				std::size_t offset;
+				std::size_t size;
+			};
+
+			static constexpr std::size_t granularity = 64 * 1024;
+			static constexpr std::size_t record_align = alignof(std::max_align_t);
+
+			static std::size_t round_up(std::size_t size, std::size_t align) noexcept
+			{
+				return (size + align - 1) / align * align;
+			}
+
+			void open();
+
+			void resize(std::size_t capacity);
+
+			void release() noexcept;
+
+			int fd_ = -1;
+			unsigned char* map_ = nullptr;
+			std::size_t capacity_ = 0;
+			std::size_t begin_ = 0; // offset of the oldest live record
+			std::size_t end_ = 0; // offset past the most recent record
+			std::deque<record> records_;
+		};
+
+		inline spill_file::spill_file(const spill_file& other)
+		{
+			// Empty records need no mapping, and a mapping can't be empty
+			if (other.bytes() > 0)
+			{
+				resize(round_up(other.bytes(), granularity));
+				std::memcpy(map_, other.map_ + other.begin_, other.bytes());
+			}
+			for (const record& r : other.records_)
+			{
+				records_.push_back(record{r.offset - other.begin_, r.size});
+			}
+			end_ = other.bytes();
+		}
+
+		inline spill_file::spill_file(spill_file&& other) noexcept
+		: fd_(other.fd_),
+		  map_(other.map_),
+		  capacity_(other.capacity_),
+		  begin_(other.begin_),
+		  end_(other.end_),
+		  records_(std::move(other.records_))
+		{
+			other.fd_ = -1;
+			other.map_ = nullptr;
+			other.capacity_ = 0;
+			other.clear();
+		}
+
+		inline spill_file& spill_file::operator=(const spill_file& other)
+		{
+			if (this != &other)
+			{
+				spill_file copy(other);
+				*this = std::move(copy);
+			}
+			return *this;
+		}
+
+		inline spill_file& spill_file::operator=(spill_file&& other) noexcept
+		{
+			if (this != &other)
+			{
+				release();
+				fd_ = other.fd_;
+				map_ = other.map_;
+				capacity_ = other.capacity_;
+				begin_ = other.begin_;
+				end_ = other.end_;
+				records_ = std::move(other.records_);
+				other.fd_ = -1;
+				other.map_ = nullptr;
+				other.capacity_ = 0;
+				other.clear();
+			}
+			return *this;
+		}
+
+		inline spill_file::~spill_file()
+		{
+			release();
+		}
+
+		inline void spill_file::push_back(const unsigned char* data, std::size_t size)
+		{
+			const std::size_t offset = round_up(end_, record_align);
+			if (size > 0)
+			{
+				if (offset + size > capacity_)
+				{
+					const std::size_t needed = round_up(offset + size, granularity);
+					resize((capacity_ * 2 > needed) ? capacity_ * 2 : needed);
+				}
+				std::memcpy(map_ + offset, data, size);
+			}
+			records_.push_back(record{offset, size});
+			end_ = offset + size;
+		}
+
+		inline void spill_file::pop_back() noexcept
+		{
+			end_ = records_.back().offset;
+			records_.pop_back();
+			if (records_.empty())
+			{
+				begin_ = end_ = 0;
+			}
+			if (capacity_ > granularity && end_ < capacity_ / 4)
+			{
+				// Halving leaves room for as many records as were just removed
+				try
+				{
+					resize(round_up(capacity_ / 2, granularity));
+				}
+				catch (...)
+				{
+					// Failing to shrink only keeps the mapping larger than needed
+				}
+			}
+		}
+
+		inline void spill_file::pop_front() noexcept
+		{
+			records_.pop_front();
+			if (records_.empty())
+			{
+				begin_ = end_ = 0;
+				return;
+			}
+			begin_ = records_.front().offset;
+			if (begin_ >= granularity && begin_ > end_ - begin_)
+			{
+				// Moving the live records is paid for by the records dropped since the last compaction
+				std::memmove(map_, map_ + begin_, end_ - begin_);
+				for (record& r : records_)
+				{
+					r.offset -= begin_;
+				}
+				end_ -= begin_;
+				begin_ = 0;
+			}
+		}
+
+		inline void spill_file::clear() noexcept
+		{
+			records_.clear();
+			begin_ = end_ = 0;
+		}
+
+		inline void spill_file::open()
+		{
+			const char* dir = std::getenv("TMPDIR");
+			std::string path = (dir && *dir) ? dir : "/tmp";
+			path += "/mixme-spill-XXXXXX";
+			fd_ = ::mkstemp(&path[0]);
+			if (fd_ < 0)
+			{
+				throw std::system_error(errno, std::generic_category(), "mixme: can't create the spill file");
+			}
+			// Nothing else needs the name: the space is reclaimed when the descriptor is closed
+			::unlink(path.c_str());
+			::fcntl(fd_, F_SETFD, FD_CLOEXEC);
+		}
+
+		inline void spill_file::resize(std::size_t capacity)
+		{
+			if (fd_ < 0)
+			{
+				open();
+			}
+			// The records stay readable through the old mapping until the new one is in place
+			if (capacity > capacity_ && ::ftruncate(fd_, static_cast<off_t>(capacity)) != 0)
+			{
+				throw std::system_error(errno, std::generic_category(), "mixme: can't grow the spill file");
+			}
+			void* map = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+			if (map == MAP_FAILED)
+			{
+				throw std::system_error(errno, std::generic_category(), "mixme: can't map the spill file");
+			}
+			if (map_)
+			{
+				::munmap(map_, capacity_);
+			}
+			if (capacity < capacity_)
+			{
+				// Failing to give the tail back only wastes disk space
+				static_cast<void>(::ftruncate(fd_, static_cast<off_t>(capacity)));
+			}
+			map_ = static_cast<unsigned char*>(map);
+			capacity_ = capacity;
+		}
+
+		inline void spill_file::release() noexcept
+		{
+			if (map_)
+			{
+				::munmap(map_, capacity_);
+			}
+			if (fd_ >= 0)
+			{
+				::close(fd_);
+			}
+			fd_ = -1;
+			map_ = nullptr;
+			capacity_ = 0;
+			clear();
+		}
+	}
+}
+
+#endif
+
+#endif
@@ -23,7 +23,7 @@ namespace mixme
     		 * Gifts the equal to operator to a derived class.
     		 *
     		 * T must be the derived class type.
-    		 * T must define at least one of these operators: !=, <, >, <=, >=
+    		 * T must define compare(), operator <=> or at least one of these operators: !=, <, >, <=, >=
     		 */
     		template <typename T>
     		struct eq
@@ -36,7 +36,7 @@ namespace mixme
     		 * Gifts the not equal to operator to a derived class.
     		 *
     		 * T must be the derived class type.
-    		 * T must define at least one of these operators: ==, <, >, <=, >=
+    		 * T must define compare(), operator <=> or at least one of these operators: ==, <, >, <=, >=
     		 */
     		template <typename T>
     		struct ne
@@ -49,7 +49,7 @@ namespace mixme
     		 * Gifts the less than operator to a derived class.
     		 *
     		 * T must be the derived class type.
-    		 * T must define at least one of these operators: >, <=, >=
+    		 * T must define compare(), operator <=> or at least one of these operators: >, <=, >=
     		 */
     		template <typename T>
     		struct lt
@@ -62,7 +62,7 @@ namespace mixme
     		 * Gifts the less than or equal to operator to a derived class.
     		 *
     		 * T must be the derived class type.
-    		 * T must define at least one of these operators: <, >, >=
+    		 * T must define compare(), operator <=> or at least one of these operators: <, >, >=
     		 */
     		template <typename T>
     		struct le
@@ -75,7 +75,7 @@ namespace mixme
     		 * Gifts the greater than operator to a derived class.
     		 *
     		 * T must be the derived class type.
-    		 * T must define at least one of these operators: <, <=, >=
+    		 * T must define compare(), operator <=> or at least one of these operators: <, <=, >=
     		 */
     		template <typename T>
     		struct gt
@@ -88,7 +88,7 @@ namespace mixme
     		 * Gifts the greater than or equal to operator to a derived class.
     		 *
     		 * T must be the derived class type.
-    		 * T must define at least one of these operators: <, >, <=
+    		 * T must define compare(), operator <=> or at least one of these operators: <, >, <=
     		 */
     		template <typename T>
     		struct ge
@@ -101,7 +101,7 @@ namespace mixme
     		 * Gifts all operators to a derived class.
     		 *
     		 * T must be the derived class type.
-    		 * T must define at least one of these operators: <, >, <=, >=
+    		 * T must define compare(), operator <=> or at least one of these operators: <, >, <=, >=
     		 */
     		template <typename T>
     		struct all : public eq<T>, public ne<T>, public lt<T>, public le<T>, public gt<T>, public ge<T>
@@ -109,6 +109,18 @@ namespace mixme
     			using eq<T>::impl;
     		};
 
+    		/**
+    		 * Gifts all operators to a derived class, each evaluating a single three-way comparison.
+    		 *
+    		 * T must be the derived class type.
+    		 * T must define a compare member function, returning a negative, zero or positive value
+    		 * like std::string::compare, or operator <=>. The member function is preferred if both exist.
+    		 * The other gifts use the three-way comparison too, when T lacks the operator they would
+    		 * otherwise derive the result from.
+    		 */
+    		template <typename T>
+    		struct three_way : public all<T> {};
+
     		template <typename T>
     		constexpr bool operator==(const eq<T>&, const eq<T>&);
 
@@ -0,0 +1,82 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef MIXME_GIFT_HASH_HPP_
+#define MIXME_GIFT_HASH_HPP_
+
+#include <mixme/detail/config.hpp>
+
+#ifdef MIXME_HAS_AUTO_TEMPLATE_PARAMETER
+
+#include <mixme/detail/hash.hpp>
+#include <mixme/gift/memberwise.hpp>
+#include <cstddef>
+#include <functional>
+
+namespace mixme
+{
+    namespace gift
+    {
+    	namespace detail
+		{
+    		template <typename T, auto... Members>
+    		std::size_t hash_members(const T& value);
+		}
+
+		/**
+		 * Gifts a hash_code member function to a derived class, hashing the listed data members.
+		 * Runs of contiguous members whose bytes compare like their values are hashed as a single block,
+		 * strings by their characters, classes gifted with hash by their hash_code, the others by std::hash.
+		 *
+		 * T must be the derived class type, and equality comparable.
+		 * Members lists the pointers to the data members, which must be members of a base of T.
+		 * When omitted, T must derive from comparison::memberwise and its member list is hashed.
+		 * When T derives from comparison::memberwise, the hashed members must be among the compared ones,
+		 * so that equal objects have equal hashes. Requires C++17.
+		 */
+		template <typename T, auto... Members>
+		struct hash
+		{
+			std::size_t hash_code() const
+			{
+				return detail::hash_members<T, Members...>(static_cast<const T&>(*this));
+			}
+		};
+
+		/**
+		 * Hash function object, usable as the Hash of the unordered containers. Classes gifted with hash
+		 * are hashed by their hash_code, the other types as a member of one of them would be
+		 */
+		template <typename T>
+		struct hasher
+		{
+			std::size_t operator()(const T& value) const;
+		};
+	}
+}
+
+/**
+ * Specializes std::hash for a class gifted with hash. Must be used in the global namespace
+ */
+#define MIXME_GIFT_STD_HASH(...) \
+	namespace std \
+	{ \
+		template <> \
+		struct hash<__VA_ARGS__> : ::mixme::gift::hasher<__VA_ARGS__> {}; \
+	}
+
+#include <mixme/gift/impl/hash.tpp>
+
+#endif
+
+#endif
@@ -25,6 +25,158 @@ namespace mixme
 		{
 			namespace detail
 			{
+				/** Whether T can be compared with a single evaluation of compare() or operator <=> */
+				template <typename T>
+				struct has_three_way : std::integral_constant<bool,
+						mixme::detail::check::comparison::compare_v<T> || mixme::detail::check::comparison::three_way_v<T>> {};
+
+#ifdef MIXME_HAS_IF_CONSTEXPR
+				template <typename T>
+				constexpr auto three_way_compare(const T& lhs, const T& rhs)
+				{
+					if constexpr (mixme::detail::check::comparison::compare_v<T>)
+					{
+						return lhs.compare(rhs);
+					}
+#ifdef MIXME_HAS_THREE_WAY_COMPARISON
+					else
+					{
+						return lhs <=> rhs;
+					}
+#endif
+				}
+
+				template <typename T>
+				constexpr bool can_derive_eq = mixme::detail::check::comparison::ne_v<T> || has_three_way<T>::value ||
+						mixme::detail::check::comparison::lt_v<T> || mixme::detail::check::comparison::gt_v<T> ||
+						mixme::detail::check::comparison::le_v<T> || mixme::detail::check::comparison::ge_v<T>;
+
+				template <typename T>
+				constexpr bool can_derive_lt = mixme::detail::check::comparison::gt_v<T> || has_three_way<T>::value ||
+						mixme::detail::check::comparison::le_v<T> || mixme::detail::check::comparison::ge_v<T>;
+
+				/** Equality through the first operator T declares among !=, compare() or <=>, <, >, <=, >= */
+				template <typename T>
+				constexpr bool equal(const T& lhs, const T& rhs)
+				{
+					static_assert(can_derive_eq<T>, "Can't provide operator ==. Class must have compare() "
+							"or at least one of these operators: !=, <=>, <, >, <=, >=.");
+					if constexpr (mixme::detail::check::comparison::ne_v<T>)
+					{
+						return !(lhs != rhs);
+					}
+					else if constexpr (has_three_way<T>::value)
+					{
+						return three_way_compare(lhs, rhs) == 0;
+					}
+					else if constexpr (mixme::detail::check::comparison::lt_v<T>)
+					{
+						return !(lhs < rhs) && !(rhs < lhs);
+					}
+					else if constexpr (mixme::detail::check::comparison::gt_v<T>)
+					{
+						return !(lhs > rhs) && !(rhs > lhs);
+					}
+					else if constexpr (mixme::detail::check::comparison::le_v<T>)
+					{
+						return lhs <= rhs && rhs <= lhs;
+					}
+					else
+					{
+						return lhs >= rhs && rhs >= lhs;
+					}
+				}
+
+				/** Less than through the operator T declares, or the first among >, compare() or <=>, <=, >= */
+				template <typename T>
+				constexpr bool less(const T& lhs, const T& rhs)
+				{
+					static_assert(mixme::detail::check::comparison::lt_v<T> || can_derive_lt<T>,
+							"Can't provide operator <. "
+							"Class must have compare() or at least one of these operators: >, <=>, <=, >=.");
+					if constexpr (mixme::detail::check::comparison::lt_v<T>)
+					{
+						return lhs < rhs;
+					}
+					else if constexpr (mixme::detail::check::comparison::gt_v<T>)
+					{
+						return rhs > lhs;
+					}
+					else if constexpr (has_three_way<T>::value)
+					{
+						return three_way_compare(lhs, rhs) < 0;
+					}
+					else if constexpr (mixme::detail::check::comparison::le_v<T>)
+					{
+						return lhs <= rhs && !(rhs <= lhs);
+					}
+					else
+					{
+						return !(lhs >= rhs);
+					}
+				}
+
+				template <typename T>
+				constexpr bool not_equal(const T& lhs, const T& rhs)
+				{
+					if constexpr (mixme::detail::check::comparison::eq_v<T>)
+					{
+						return !(lhs == rhs);
+					}
+					else
+					{
+						return !detail::equal(lhs, rhs);
+					}
+				}
+
+				template <typename T>
+				constexpr bool less_equal(const T& lhs, const T& rhs)
+				{
+					if constexpr (has_three_way<T>::value)
+					{
+						return three_way_compare(lhs, rhs) <= 0;
+					}
+					else
+					{
+						return detail::less(lhs, rhs) || !detail::less(rhs, lhs);
+					}
+				}
+
+				template <typename T>
+				constexpr bool greater(const T& lhs, const T& rhs)
+				{
+					return detail::less(rhs, lhs);
+				}
+
+				template <typename T>
+				constexpr bool greater_equal(const T& lhs, const T& rhs)
+				{
+					if constexpr (has_three_way<T>::value)
+					{
+						return three_way_compare(lhs, rhs) >= 0;
+					}
+					else
+					{
+						return detail::less(rhs, lhs) || !detail::less(lhs, rhs);
+					}
+				}
+#else
+				template <typename T, typename std::enable_if_t<mixme::detail::check::comparison::compare_v<T>>* = nullptr>
+				constexpr auto three_way_compare(const T& lhs, const T& rhs)
+				{
+					return lhs.compare(rhs);
+				}
+
+#ifdef MIXME_HAS_THREE_WAY_COMPARISON
+				template <typename T,
+						typename std::enable_if_t<!mixme::detail::check::comparison::compare_v<T> &&
+								mixme::detail::check::comparison::three_way_v<T>>* = nullptr>
+				constexpr auto three_way_compare(const T& lhs, const T& rhs)
+				{
+					return lhs <=> rhs;
+				}
+#endif
+
 				template <typename T, bool Check>
 				struct eq_impl_ge
 				{
@@ -37,8 +189,8 @@ namespace mixme
 				{
 					constexpr static bool valid = false;
 					static_assert(mixme::detail::signal_error<T>::value,
-							"Can't provide operator ==. "
-							"Class must have at least one of these operators: !=, <, >, <=, >=.");
+							"Can't provide operator ==. Class must have compare() "
+							"or at least one of these operators: !=, <=>, <, >, <=, >=.");
 				};
 
 				template <typename T, bool Check>
@@ -92,6 +244,23 @@ namespace mixme
 					}
 				};
 
+				template <typename T, bool Check>
+				struct eq_impl_cmp
+				{
+					constexpr static bool valid = true;
+					constexpr bool operator()(const T& lhs, const T& rhs) { return three_way_compare(lhs, rhs) == 0; }
+				};
+
+				template <typename T>
+				struct eq_impl_cmp<T, false>
+				{
+					constexpr static bool valid = eq_impl_lt<T, mixme::detail::check::comparison::lt<T>{}>::valid;
+					constexpr bool operator()(const T& lhs, const T& rhs)
+					{
+						return eq_impl_lt<T, mixme::detail::check::comparison::lt<T>{}>{}(lhs, rhs);
+					}
+				};
+
 				template <typename T, bool Check>
 				struct eq_impl_ne
 				{
@@ -102,10 +271,10 @@ namespace mixme
 				template <typename T>
 				struct eq_impl_ne<T, false>
 				{
-					constexpr static bool valid = eq_impl_lt<T, mixme::detail::check::comparison::lt<T>{}>::valid;
+					constexpr static bool valid = eq_impl_cmp<T, has_three_way<T>{}>::valid;
 					constexpr bool operator()(const T& lhs, const T& rhs)
 					{
-						return eq_impl_lt<T, mixme::detail::check::comparison::lt<T>{}>{}(lhs, rhs);
+						return eq_impl_cmp<T, has_three_way<T>{}>{}(lhs, rhs);
 					}
 				};
 
@@ -113,7 +282,7 @@ namespace mixme
 				struct lt_impl_ge
 				{
 					constexpr static bool valid = true;
-					constexpr bool operator()(const T& lhs, const T& rhs) { return rhs >= lhs; }
+					constexpr bool operator()(const T& lhs, const T& rhs) { return !(lhs >= rhs); }
 				};
 
 				template <typename T>
@@ -121,7 +290,8 @@ namespace mixme
 				{
 					constexpr static bool valid = false;
 					static_assert(mixme::detail::signal_error<T>::value,
-							"Can't provide operator <. Class must have at least one of these operators: >, <=, >=.");
+							"Can't provide operator <. "
+							"Class must have compare() or at least one of these operators: >, <=>, <=, >=.");
 				};
 
 				template <typename T, bool Check>
@@ -141,6 +311,23 @@ namespace mixme
 					}
 				};
 
+				template <typename T, bool Check>
+				struct lt_impl_cmp
+				{
+					constexpr static bool valid = true;
+					constexpr bool operator()(const T& lhs, const T& rhs) { return three_way_compare(lhs, rhs) < 0; }
+				};
+
+				template <typename T>
+				struct lt_impl_cmp<T, false>
+				{
+					constexpr static bool valid = lt_impl_le<T, mixme::detail::check::comparison::le<T>{}>::valid;
+					constexpr bool operator()(const T& lhs, const T& rhs)
+					{
+						return lt_impl_le<T, mixme::detail::check::comparison::le<T>{}>{}(lhs, rhs);
+					}
+				};
+
 				template <typename T, bool Check>
 				struct lt_impl_gt
 				{
@@ -151,10 +338,10 @@ namespace mixme
 				template <typename T>
 				struct lt_impl_gt<T, false>
 				{
-					constexpr static bool valid = lt_impl_le<T, mixme::detail::check::comparison::le<T>{}>::valid;
+					constexpr static bool valid = lt_impl_cmp<T, has_three_way<T>{}>::valid;
 					constexpr bool operator()(const T& lhs, const T& rhs)
 					{
-						return lt_impl_le<T, mixme::detail::check::comparison::le<T>{}>{}(lhs, rhs);
+						return lt_impl_cmp<T, has_three_way<T>{}>{}(lhs, rhs);
 					}
 				};
 
@@ -219,66 +406,133 @@ namespace mixme
 								static_cast<const ge<T>&>(rhs).impl());
 					}
 				}
+
+				template <typename T, bool Check>
+				struct le_impl_cmp
+				{
+					constexpr bool operator()(const T& lhs, const T& rhs) { return three_way_compare(lhs, rhs) <= 0; }
+				};
+
+				template <typename T>
+				struct le_impl_cmp<T, false>
+				{
+					constexpr bool operator()(const T& lhs, const T& rhs)
+					{
+						using namespace le_ext;
+						static_assert(lazy_valid_selector<T,
+										lt_impl_gt,
+										mixme::detail::check::comparison::gt,
+										mixme::detail::check::comparison::lt<T>{}>::value,
+								"Can't provide operator <=. Generation of operator < failed.");
+						return lhs < rhs || (!(lhs < rhs) && !(rhs < lhs));
+					}
+				};
+
+				template <typename T, bool Check>
+				struct ge_impl_cmp
+				{
+					constexpr bool operator()(const T& lhs, const T& rhs) { return three_way_compare(lhs, rhs) >= 0; }
+				};
+
+				template <typename T>
+				struct ge_impl_cmp<T, false>
+				{
+					constexpr bool operator()(const T& lhs, const T& rhs)
+					{
+						using namespace ge_ext;
+						static_assert(lazy_valid_selector<T,
+										lt_impl_gt,
+										mixme::detail::check::comparison::gt,
+										mixme::detail::check::comparison::lt<T>{}>::value,
+								"Can't provide operator >=. Generation of operator < failed.");
+						return rhs < lhs || (!(rhs < lhs) && !(lhs < rhs));
+					}
+				};
+
+				template <typename T>
+				constexpr bool equal(const T& lhs, const T& rhs)
+				{
+					return eq_impl_ne<T, mixme::detail::check::comparison::ne<T>{}>{}(lhs, rhs);
+				}
+
+				template <typename T>
+				constexpr bool not_equal(const T& lhs, const T& rhs)
+				{
+					using namespace ne_ext;
+					static_assert(lazy_valid_selector<T,
+									eq_impl_ne,
+									mixme::detail::check::comparison::ne,
+									mixme::detail::check::comparison::eq<T>{}>::value,
+							"Can't provide operator !=. Generation of operator == failed.");
+					return !(lhs == rhs);
+				}
+
+				template <typename T>
+				constexpr bool less(const T& lhs, const T& rhs)
+				{
+					return lt_impl_gt<T, mixme::detail::check::comparison::gt<T>{}>{}(lhs, rhs);
+				}
+
+				template <typename T>
+				constexpr bool less_equal(const T& lhs, const T& rhs)
+				{
+					return le_impl_cmp<T, has_three_way<T>{}>{}(lhs, rhs);
+				}
+
+				template <typename T>
+				constexpr bool greater(const T& lhs, const T& rhs)
+				{
+					using namespace gt_ext;
+					static_assert(lazy_valid_selector<T,
+									lt_impl_gt,
+									mixme::detail::check::comparison::gt,
+									mixme::detail::check::comparison::lt<T>{}>::value,
+							"Can't provide operator >. Generation of operator < failed.");
+					return rhs < lhs;
+				}
+
+				template <typename T>
+				constexpr bool greater_equal(const T& lhs, const T& rhs)
+				{
+					return ge_impl_cmp<T, has_three_way<T>{}>{}(lhs, rhs);
+				}
+#endif
 			}
 
     		template <typename T>
     		constexpr bool operator==(const eq<T>& lhs, const eq<T>& rhs)
 			{
-    			return detail::eq_impl_ne<T, mixme::detail::check::comparison::ne<T>{}>{}(lhs.impl(), rhs.impl());
+    			return detail::equal(lhs.impl(), rhs.impl());
 			}
 
     		template <typename T>
     		constexpr bool operator!=(const ne<T>& lhs, const ne<T>& rhs)
 			{
-    			using namespace detail::ne_ext;
-    			static_assert(detail::lazy_valid_selector<T,
-    							detail::eq_impl_ne,
-								mixme::detail::check::comparison::ne,
-								mixme::detail::check::comparison::eq<T>{}>::value,
-    					"Can't provide operator !=. Generation of operator == failed.");
-    			return !(lhs.impl() == rhs.impl());
+    			return detail::not_equal(lhs.impl(), rhs.impl());
 			}
 
     		template <typename T>
     		constexpr bool operator<(const lt<T>& lhs, const lt<T>& rhs)
 			{
-    			return detail::lt_impl_gt<T, mixme::detail::check::comparison::gt<T>{}>{}(lhs.impl(), rhs.impl());
+    			return detail::less(lhs.impl(), rhs.impl());
 			}
 
     		template <typename T>
     		constexpr bool operator<=(const le<T>& lhs, const le<T>& rhs)
 			{
-    			using namespace detail::le_ext;
-    			static_assert(detail::lazy_valid_selector<T,
-    							detail::lt_impl_gt,
-								mixme::detail::check::comparison::gt,
-								mixme::detail::check::comparison::lt<T>{}>::value,
-    					"Can't provide operator <=. Generation of operator < failed.");
-    			return lhs.impl() < rhs.impl() || (!(lhs.impl() < rhs.impl()) && !(rhs.impl() < lhs.impl()));
+    			return detail::less_equal(lhs.impl(), rhs.impl());
 			}
 
     		template <typename T>
     		constexpr bool operator>(const gt<T>& lhs, const gt<T>& rhs)
 			{
-    			using namespace detail::gt_ext;
-    			static_assert(detail::lazy_valid_selector<T,
-    							detail::lt_impl_gt,
-								mixme::detail::check::comparison::gt,
-								mixme::detail::check::comparison::lt<T>{}>::value,
-    					"Can't provide operator >. Generation of operator < failed.");
-    			return rhs.impl() < lhs.impl();
+    			return detail::greater(lhs.impl(), rhs.impl());
 			}
 
     		template <typename T>
     		constexpr bool operator>=(const ge<T>& lhs, const ge<T>& rhs)
 			{
-    			using namespace detail::ge_ext;
-    			static_assert(detail::lazy_valid_selector<T,
-    							detail::lt_impl_gt,
-								mixme::detail::check::comparison::gt,
-								mixme::detail::check::comparison::lt<T>{}>::value,
-    					"Can't provide operator >=. Generation of operator < failed.");
-    			return rhs.impl() < lhs.impl() || (!(rhs.impl() < lhs.impl()) && !(lhs.impl() < rhs.impl()));
+    			return detail::greater_equal(lhs.impl(), rhs.impl());
 			}
         }        
     }
@@ -0,0 +1,233 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef MIXME_GIFT_HASH_TPP_
+#define MIXME_GIFT_HASH_TPP_
+
+#include <mixme/detail/check/comparison.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace mixme
+{
+    namespace gift
+    {
+    	namespace detail
+		{
+    		template <auto... Members>
+    		struct member_list {};
+
+    		template <auto Member>
+    		using member_constant = std::integral_constant<decltype(Member), Member>;
+
+    		template <typename T, auto... Members>
+    		member_list<Members...> memberwise_members(const comparison::memberwise<T, Members...>*);
+
+    		template <typename T>
+    		void memberwise_members(const void*);
+
+    		/** The members compared by the memberwise gift of T, void if T hasn't it */
+    		template <typename T>
+    		using compared_members = decltype(detail::memberwise_members<T>(static_cast<const T*>(nullptr)));
+
+    		template <auto Member, typename List>
+    		struct listed;
+
+    		template <auto Member, auto... Members>
+    		struct listed<Member, member_list<Members...>> : std::integral_constant<bool,
+    				(std::is_same<member_constant<Member>, member_constant<Members>>::value || ...)> {};
+
+    		/** Whether the hashed members are among the compared ones */
+    		template <typename Compared, typename Hashed>
+    		struct consistent : std::true_type {};
+
+    		template <typename Compared, auto... Hashed>
+    		struct consistent<Compared, member_list<Hashed...>> : std::integral_constant<bool,
+    				(listed<Hashed, Compared>::value && ...)> {};
+
+    		template <auto... Hashed>
+    		struct consistent<void, member_list<Hashed...>> : std::true_type {};
+
+    		template <typename T>
+    		struct is_byte_string : std::false_type {};
+
+    		template <typename C, typename A>
+    		struct is_byte_string<std::basic_string<C, std::char_traits<C>, A>> : comparison::detail::bytes_equal<C> {};
+
+    		template <typename C>
+    		struct is_byte_string<std::basic_string_view<C, std::char_traits<C>>> : comparison::detail::bytes_equal<C> {};
+
+    		template <typename T>
+    		struct has_hash_code_impl
+			{
+    			template <typename U>
+    			static auto test(U*) -> decltype(static_cast<std::size_t>(std::declval<const U&>().hash_code()),
+    					std::true_type{});
+
+    			template <typename>
+    			static auto test(...) -> std::false_type;
+
+    			using type = decltype(test<T>(nullptr));
+			};
+
+    		/** Checks whether T has a hash_code member function */
+    		template <typename T>
+    		struct has_hash_code : has_hash_code_impl<T>::type {};
+
+    		template <typename T, typename std::enable_if_t<comparison::detail::bytes_equal<T>::value>* = nullptr>
+    		std::uint64_t hash_value(const T& value, std::uint64_t seed) noexcept;
+
+    		template <typename T, typename std::enable_if_t<is_byte_string<T>::value>* = nullptr>
+    		std::uint64_t hash_value(const T& value, std::uint64_t seed) noexcept;
+
+    		template <typename T, typename std::enable_if_t<has_hash_code<T>::value>* = nullptr>
+    		std::uint64_t hash_value(const T& value, std::uint64_t seed);
+
+    		template <typename T,
+					typename std::enable_if_t<!comparison::detail::bytes_equal<T>::value && !is_byte_string<T>::value &&
+							!has_hash_code<T>::value>* = nullptr>
+    		std::uint64_t hash_value(const T& value, std::uint64_t seed);
+
+    		template <typename T, std::size_t N>
+    		std::uint64_t hash_value(const T (&value)[N], std::uint64_t seed);
+
+    		/** Hashes a sequence of values, merging adjacent blocks of bytes into one */
+    		class hash_stream
+			{
+    		public:
+    			explicit hash_stream(std::uint64_t seed = 0) noexcept : seed_(seed) {}
+
+    			template <typename T, typename std::enable_if_t<comparison::detail::bytes_equal<T>::value>* = nullptr>
+    			void add(const T& value) noexcept
+    			{
+    				const unsigned char* bytes = reinterpret_cast<const unsigned char*>(std::addressof(value));
+    				if (bytes != block_ + size_)
+    				{
+    					flush();
+    					block_ = bytes;
+    				}
+    				size_ += sizeof(T);
+    			}
+
+    			template <typename T, typename std::enable_if_t<!comparison::detail::bytes_equal<T>::value>* = nullptr>
+    			void add(const T& value)
+    			{
+    				flush();
+    				seed_ = detail::hash_value(value, seed_);
+    			}
+
+    			std::uint64_t finish() noexcept
+    			{
+    				flush();
+    				return seed_;
+    			}
+    		private:
+    			void flush() noexcept
+    			{
+    				if (size_ != 0)
+    				{
+    					seed_ = mixme::detail::hash_bytes(block_, size_, seed_);
+    					size_ = 0;
+    				}
+    			}
+
+    			const unsigned char* block_ = nullptr;
+    			std::size_t size_ = 0;
+    			std::uint64_t seed_;
+			};
+
+    		template <typename T, typename std::enable_if_t<comparison::detail::bytes_equal<T>::value>*>
+    		std::uint64_t hash_value(const T& value, std::uint64_t seed) noexcept
+    		{
+    			return mixme::detail::hash_bytes(std::addressof(value), sizeof(T), seed);
+    		}
+
+    		template <typename T, typename std::enable_if_t<is_byte_string<T>::value>*>
+    		std::uint64_t hash_value(const T& value, std::uint64_t seed) noexcept
+    		{
+    			return mixme::detail::hash_bytes(value.data(), value.size() * sizeof(typename T::value_type), seed);
+    		}
+
+    		template <typename T, typename std::enable_if_t<has_hash_code<T>::value>*>
+    		std::uint64_t hash_value(const T& value, std::uint64_t seed)
+    		{
+    			return mixme::detail::hash_integer(value.hash_code(), seed);
+    		}
+
+    		template <typename T,
+					typename std::enable_if_t<!comparison::detail::bytes_equal<T>::value && !is_byte_string<T>::value &&
+							!has_hash_code<T>::value>*>
+    		std::uint64_t hash_value(const T& value, std::uint64_t seed)
+    		{
+    			return mixme::detail::hash_integer(std::hash<T>{}(value), seed);
+    		}
+
+    		template <typename T, std::size_t N>
+    		std::uint64_t hash_value(const T (&value)[N], std::uint64_t seed)
+    		{
+    			hash_stream stream(seed);
+    			for (const T& element : value)
+    			{
+    				stream.add(element);
+    			}
+    			return stream.finish();
+    		}
+
+    		template <typename T, auto... Members>
+    		std::size_t hash_list(const T& value, member_list<Members...>)
+    		{
+    			hash_stream stream;
+    			(stream.add(value.*Members), ...);
+    			return static_cast<std::size_t>(stream.finish());
+    		}
+
+    		template <typename T, auto... Members>
+    		std::size_t hash_members(const T& value)
+    		{
+    			using compared = compared_members<T>;
+    			using hashed = std::conditional_t<sizeof...(Members) == 0, compared, member_list<Members...>>;
+    			static_assert(mixme::detail::check::comparison_lax::eq<T>::value,
+    					"Can't provide hash_code. Class must be equality comparable.");
+    			static_assert(!std::is_void<hashed>::value,
+    					"Can't provide hash_code. Class must list the members or derive from comparison::memberwise.");
+    			static_assert(consistent<compared, hashed>::value,
+    					"Can't provide hash_code. Hashed members must be compared by comparison::memberwise.");
+    			return detail::hash_list(value, std::conditional_t<std::is_void<hashed>::value, member_list<>, hashed>{});
+    		}
+
+    		template <typename T, typename std::enable_if_t<has_hash_code<T>::value>* = nullptr>
+    		std::size_t hash_of(const T& value)
+    		{
+    			return value.hash_code();
+    		}
+
+    		template <typename T, typename std::enable_if_t<!has_hash_code<T>::value>* = nullptr>
+    		std::size_t hash_of(const T& value)
+    		{
+    			return static_cast<std::size_t>(detail::hash_value(value, 0));
+    		}
+		}
+
+    	template <typename T>
+    	std::size_t hasher<T>::operator()(const T& value) const
+    	{
+    		return detail::hash_of(value);
+    	}
+	}
+}
+
+#endif
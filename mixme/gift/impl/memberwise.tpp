@@ -0,0 +1,168 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef MIXME_GIFT_MEMBERWISE_TPP_
+#define MIXME_GIFT_MEMBERWISE_TPP_
+
+#include <cstring>
+#include <memory>
+
+namespace mixme
+{
+    namespace gift
+    {
+    	namespace comparison
+		{
+    		namespace detail
+			{
+    			template <typename T, auto Member>
+    			using member_type = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<const T&>().*Member)>>;
+
+    			/** Whether two values of T are equal exactly when their bytes are */
+    			template <typename T>
+    			struct bytes_equal : std::integral_constant<bool,
+    					std::is_scalar<T>::value && std::has_unique_object_representations<T>::value> {};
+
+    			template <typename T, std::size_t N>
+    			struct bytes_equal<T[N]> : bytes_equal<T> {};
+
+    			template <typename T, std::size_t N>
+    			struct bytes_equal<std::array<T, N>> : std::integral_constant<bool,
+    					bytes_equal<T>::value && sizeof(std::array<T, N>) == N * sizeof(T)> {};
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    			constexpr bool big_endian = true;
+#else
+    			constexpr bool big_endian = false;
+#endif
+
+    			/** Whether memcmp orders values of T like operator <: unsigned bytes, or unsigned integers on big endian */
+    			template <typename T>
+    			struct bytes_ordered : std::integral_constant<bool, std::is_same<T, std::byte>::value ||
+    					(std::is_unsigned<T>::value && std::has_unique_object_representations<T>::value &&
+    							(sizeof(T) == 1 || big_endian))> {};
+
+    			template <typename T, std::size_t N>
+    			struct bytes_ordered<T[N]> : bytes_ordered<T> {};
+
+    			template <typename T, std::size_t N>
+    			struct bytes_ordered<std::array<T, N>> : std::integral_constant<bool,
+    					bytes_ordered<T>::value && sizeof(std::array<T, N>) == N * sizeof(T)> {};
+
+    			/** Byte layout of the listed members of T */
+    			template <typename T, auto... Members>
+    			struct memberwise_layout
+				{
+    				static constexpr std::size_t size = (sizeof(member_type<T, Members>) + ...);
+
+    				static constexpr bool equal = (bytes_equal<member_type<T, Members>>::value && ...);
+
+    				static constexpr bool ordered = (bytes_ordered<member_type<T, Members>>::value && ...);
+
+    				/**
+    				 * @returns The address of the first member if the members follow each other in the listed order,
+    				 * without padding, nullptr otherwise. The offsets are constants, so this folds away once inlined
+    				 */
+    				static const unsigned char* contiguous(const T& value) noexcept
+    				{
+    					const unsigned char* const begin[] = {
+    							reinterpret_cast<const unsigned char*>(std::addressof(value.*Members))...};
+    					constexpr std::size_t sizes[] = {sizeof(member_type<T, Members>)...};
+    					for (std::size_t i = 1; i < sizeof...(Members); ++i)
+    					{
+    						if (begin[i] != begin[i - 1] + sizes[i - 1])
+    						{
+    							return nullptr;
+    						}
+    					}
+    					return begin[0];
+    				}
+				};
+
+    			template <typename T>
+    			bool equal_member(const T& lhs, const T& rhs)
+    			{
+    				return lhs == rhs;
+    			}
+
+    			template <typename T, std::size_t N>
+    			bool equal_member(const T (&lhs)[N], const T (&rhs)[N])
+    			{
+    				for (std::size_t i = 0; i < N; ++i)
+    				{
+    					if (!detail::equal_member(lhs[i], rhs[i]))
+    					{
+    						return false;
+    					}
+    				}
+    				return true;
+    			}
+
+    			template <typename T, typename std::enable_if_t<has_three_way<T>{}>* = nullptr>
+    			int compare_member(const T& lhs, const T& rhs)
+    			{
+    				const auto result = three_way_compare(lhs, rhs);
+    				return (result < 0) ? -1 : ((0 < result) ? 1 : 0);
+    			}
+
+    			template <typename T, typename std::enable_if_t<!has_three_way<T>{}>* = nullptr>
+    			int compare_member(const T& lhs, const T& rhs)
+    			{
+    				return (lhs < rhs) ? -1 : ((rhs < lhs) ? 1 : 0);
+    			}
+
+    			template <typename T, std::size_t N>
+    			int compare_member(const T (&lhs)[N], const T (&rhs)[N])
+    			{
+    				for (std::size_t i = 0; i < N; ++i)
+    				{
+    					const int result = detail::compare_member(lhs[i], rhs[i]);
+    					if (result != 0)
+    					{
+    						return result;
+    					}
+    				}
+    				return 0;
+    			}
+
+    			template <typename T, auto... Members>
+    			bool memberwise_equal(const T& lhs, const T& rhs)
+    			{
+    				using layout = memberwise_layout<T, Members...>;
+    				const unsigned char* first = layout::equal ? layout::contiguous(lhs) : nullptr;
+    				if (first)
+    				{
+    					return std::memcmp(first, layout::contiguous(rhs), layout::size) == 0;
+    				}
+    				return (detail::equal_member(lhs.*Members, rhs.*Members) && ...);
+    			}
+
+    			template <typename T, auto... Members>
+    			int memberwise_compare(const T& lhs, const T& rhs)
+    			{
+    				using layout = memberwise_layout<T, Members...>;
+    				const unsigned char* first = layout::ordered ? layout::contiguous(lhs) : nullptr;
+    				if (first)
+    				{
+    					return std::memcmp(first, layout::contiguous(rhs), layout::size);
+    				}
+    				int result = 0;
+    				static_cast<void>((((result = detail::compare_member(lhs.*Members, rhs.*Members)) == 0) && ...));
+    				return result;
+    			}
+			}
+		}
+	}
+}
+
+#endif
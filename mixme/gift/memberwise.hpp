@@ -0,0 +1,113 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef MIXME_GIFT_MEMBERWISE_HPP_
+#define MIXME_GIFT_MEMBERWISE_HPP_
+
+#include <mixme/detail/config.hpp>
+
+#ifdef MIXME_HAS_AUTO_TEMPLATE_PARAMETER
+
+#include <mixme/gift/comparison.hpp>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace mixme
+{
+    namespace gift
+    {
+    	namespace comparison
+		{
+    		namespace detail
+			{
+    			template <typename T, auto... Members>
+    			bool memberwise_equal(const T& lhs, const T& rhs);
+
+    			template <typename T, auto... Members>
+    			int memberwise_compare(const T& lhs, const T& rhs);
+			}
+
+    		/**
+    		 * Gifts all operators to a derived class, comparing the listed data members lexicographically.
+    		 * Along with the operators, it provides a compare member function, so that the other gifts and
+    		 * classes holding T as a member compare it with a single pass.
+    		 *
+    		 * When the members are contiguous and their bytes compare like their values, the comparison is
+    		 * a single memcmp: for equality, members with unique object representations, like integers;
+    		 * for ordering, unsigned bytes and arrays of them (any unsigned integer on big endian targets).
+    		 * Otherwise members are compared one at a time, stopping at the first difference.
+    		 *
+    		 * T must be the derived class type.
+    		 * Members lists the pointers to the data members, in order of significance. Since T is incomplete
+    		 * in its own base clause, they must be members of a base of T. Requires C++17.
+    		 *
+    		 * The operators are hidden friends taking T, so the detail::check::comparison detectors see them
+    		 * as declared by T.
+    		 */
+    		template <typename T, auto... Members>
+    		struct memberwise
+			{
+    			static_assert(sizeof...(Members) > 0, "memberwise requires at least one member");
+    			static_assert((std::is_member_object_pointer<decltype(Members)>::value && ...),
+    					"memberwise requires pointers to data members");
+
+    			/**
+    			 * @returns A negative value if this object orders before other, zero if they are equal,
+    			 * a positive value otherwise
+    			 */
+    			int compare(const T& other) const
+    			{
+    				return detail::memberwise_compare<T, Members...>(static_cast<const T&>(*this), other);
+    			}
+
+    			friend bool operator==(const T& lhs, const T& rhs)
+    			{
+    				return detail::memberwise_equal<T, Members...>(lhs, rhs);
+    			}
+
+    			friend bool operator!=(const T& lhs, const T& rhs)
+    			{
+    				return !detail::memberwise_equal<T, Members...>(lhs, rhs);
+    			}
+
+    			friend bool operator<(const T& lhs, const T& rhs)
+    			{
+    				return detail::memberwise_compare<T, Members...>(lhs, rhs) < 0;
+    			}
+
+    			friend bool operator<=(const T& lhs, const T& rhs)
+    			{
+    				return detail::memberwise_compare<T, Members...>(lhs, rhs) <= 0;
+    			}
+
+    			friend bool operator>(const T& lhs, const T& rhs)
+    			{
+    				return detail::memberwise_compare<T, Members...>(lhs, rhs) > 0;
+    			}
+
+    			friend bool operator>=(const T& lhs, const T& rhs)
+    			{
+    				return detail::memberwise_compare<T, Members...>(lhs, rhs) >= 0;
+    			}
+			};
+		}
+	}
+}
+
+#include <mixme/gift/impl/memberwise.tpp>
+
+#endif
+
+#endif
@@ -60,7 +60,28 @@ namespace mixme
             
         	move_only& operator=(const move_only&) = delete;
         	move_only& operator=(move_only&&) = default;
-        };        
+        };
+
+        /**
+         * Derive T from trivially_relocatable<T> to declare that moving an object and then destroying the source
+         * is the same as copying its bytes, as for most handles to owned resources.
+         * Wrappers then relocate it with memcpy, skipping its move constructor and destructor.
+         *
+         * Every base and member of T must be trivially relocatable as well: a class storing pointers into itself,
+         * registering its address somewhere, or holding such a member (libstdc++'s std::string, for one)
+         * must not derive from it. Classes deriving from T don't inherit the declaration, since their own
+         * members could break it.
+         */
+        template <typename T>
+        struct trivially_relocatable {};
+
+        /**
+         * Whether T can be relocated by copying its bytes: trivially copyable types and classes
+         * deriving from trivially_relocatable<T>. Specialize it for classes that can't derive from it
+         */
+        template <typename T>
+        struct is_trivially_relocatable : std::integral_constant<bool,
+        		std::is_trivially_copyable<T>::value || std::is_base_of<trivially_relocatable<T>, T>::value> {};
     }
 }
 
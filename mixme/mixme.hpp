@@ -15,5 +15,21 @@
  */
 
 #include <mixme/gift/comparison.hpp>
+#include <mixme/gift/memberwise.hpp>
+#include <mixme/gift/hash.hpp>
 #include <mixme/gift/type_properties.hpp>
 #include <mixme/wrap/history.hpp>
+#include <mixme/wrap/delta_storage.hpp>
+#include <mixme/wrap/cow.hpp>
+#include <mixme/wrap/boxed.hpp>
+#include <mixme/wrap/pooled_storage.hpp>
+#include <mixme/wrap/budget_storage.hpp>
+#include <mixme/wrap/compressed_storage.hpp>
+#include <mixme/wrap/spill_storage.hpp>
+#include <mixme/wrap/checkpoint.hpp>
+#include <mixme/wrap/concurrent.hpp>
+#include <mixme/wrap/tracked.hpp>
+#include <mixme/wrap/instrumentation.hpp>
+#include <mixme/wrap/history_tree.hpp>
+#include <mixme/wrap/journaled.hpp>
+#include <mixme/wrap/element_undoable.hpp>
@@ -15,6 +15,8 @@
 
 #include <utility>
 #include <type_traits>
+#include <mixme/detail/config.hpp>
+#include <mixme/detail/relocation.hpp>
 
 namespace mixme
 {
@@ -33,19 +35,35 @@ namespace mixme
             constexpr base(base&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
             : value_(std::move(other.value_)) {}
 
+#ifdef MIXME_HAS_CONCEPTS
+            template <typename U>
+            requires (!std::is_base_of_v<base, std::decay_t<U>>)
+            constexpr base(U&& value) : value_(std::forward<U>(value)) {}
+
+            template <typename... Args>
+            requires (sizeof...(Args) > 1)
+            constexpr base(Args&&... args) : value_(std::forward<Args>(args)...) {}
+#else
             template <typename U, typename std::enable_if_t<!std::is_base_of<base, std::decay_t<U>>::value>* = nullptr>
             constexpr base(U&& value) : value_(std::forward<U>(value)) {}
 
             template <typename... Args,
 				typename std::enable_if_t<(sizeof...(Args) > 1)>* = nullptr>
             constexpr base(Args&&... args) : value_(std::forward<Args>(args)...) {}
+#endif
             
-            base& operator=(const base&);
+            MIXME_CONSTEXPR20 base& operator=(const base&);
             
-            base& operator=(base&&) noexcept(std::is_nothrow_move_assignable<T>::value);
+            MIXME_CONSTEXPR20 base& operator=(base&&) noexcept(std::is_nothrow_move_assignable<T>::value);
             
+#ifdef MIXME_HAS_CONCEPTS
+            template <typename U>
+            requires (!std::is_base_of_v<base<T>, std::decay_t<U>>)
+            MIXME_CONSTEXPR20 base& operator=(U&&);
+#else
             template <typename U, typename std::enable_if_t<!std::is_base_of<base, std::decay_t<U>>::value>* = nullptr>
-            base& operator=(U&&);
+            MIXME_CONSTEXPR20 base& operator=(U&&);
+#endif
             
             constexpr T* operator->() { return &value_; }
             
@@ -120,6 +138,7 @@ namespace mixme
         template <typename T>
 		constexpr bool operator>=(const T& lhs, const base<T>& rhs) { return lhs >= rhs.value(); }
 
+        /** Swaps the values. Trivially relocatable values exchange their bytes, without any move */
         template <typename T>
         void swap(base<T>& lhs, base<T>& rhs);
     }
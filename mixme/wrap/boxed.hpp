@@ -0,0 +1,199 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_BOXED_HPP_
+#define MIXME_WRAP_BOXED_HPP_
+
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+#include <mixme/gift/type_properties.hpp>
+#include <mixme/wrap/footprint.hpp>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	namespace detail
+		{
+    		struct box_construct {};
+
+    		/** Holds the value of a box inside it */
+    		template <typename T, bool Inline>
+    		struct box_storage
+			{
+    			template <typename... Args>
+    			explicit box_storage(box_construct, Args&&... args) : value(std::forward<Args>(args)...) {}
+
+    			template <typename U>
+    			void assign(U&& other) { value = std::forward<U>(other); }
+
+    			void swap(box_storage& other)
+    			{
+    				using std::swap;
+    				swap(value, other.value);
+    			}
+
+    			T* get() noexcept { return &value; }
+
+    			const T* get() const noexcept { return &value; }
+
+    			T value;
+			};
+
+    		/** Holds the value of a box in its own allocation. Moving steals the allocation */
+    		template <typename T>
+    		struct box_storage<T, false>
+			{
+    			template <typename... Args>
+    			explicit box_storage(box_construct, Args&&... args) : value(new T(std::forward<Args>(args)...)) {}
+
+    			box_storage(const box_storage& other) : value((other.value) ? new T(*other.value) : nullptr) {}
+
+    			box_storage(box_storage&& other) noexcept : value(other.value) { other.value = nullptr; }
+
+    			~box_storage() { delete value; }
+
+    			box_storage& operator=(const box_storage& other);
+
+    			box_storage& operator=(box_storage&& other) noexcept
+				{
+    				swap(other);
+    				return *this;
+				}
+
+    			template <typename U>
+    			void assign(U&& other);
+
+    			void swap(box_storage& other) noexcept { std::swap(value, other.value); }
+
+    			T* get() noexcept { return value; }
+
+    			const T* get() const noexcept { return value; }
+
+    			T* value;
+			};
+		}
+
+    	/**
+    	 * Holds a value of T out of line, in a single allocation, unless it fits in Inline_size bytes.
+    	 * Boxes are trivially relocatable when out of line: histories of boxes exchange pointers
+    	 * on undo and redo, whatever the size of T, and assignments reuse the allocation.
+    	 *
+    	 * A box moved from holds no value if out of line: it can only be assigned or destroyed.
+    	 */
+        template <typename T, std::size_t Inline_size = 2 * sizeof(void*)>
+        class boxed
+        {
+        public:
+            using value_type = T;
+
+            /// Whether the value is stored inside the box
+            static constexpr bool is_inline = sizeof(T) <= Inline_size && std::is_nothrow_move_constructible<T>::value;
+
+            boxed() : storage_(detail::box_construct()) {}
+
+            template <typename U, typename std::enable_if_t<!std::is_base_of<boxed, std::decay_t<U>>::value>* = nullptr>
+            boxed(U&& value) : storage_(detail::box_construct(), std::forward<U>(value)) {}
+
+            template <typename... Args, typename std::enable_if_t<(sizeof...(Args) > 1)>* = nullptr>
+            boxed(Args&&... args) : storage_(detail::box_construct(), std::forward<Args>(args)...) {}
+
+            template <typename U, typename std::enable_if_t<!std::is_base_of<boxed, std::decay_t<U>>::value>* = nullptr>
+            boxed& operator=(U&& value);
+
+            T* operator->() noexcept { return storage_.get(); }
+
+            const T* operator->() const noexcept { return storage_.get(); }
+
+            T& operator*() & noexcept { return *storage_.get(); }
+
+            const T& operator*() const & noexcept { return *storage_.get(); }
+
+            T&& operator*() && noexcept { return std::move(*storage_.get()); }
+
+            const T&& operator*() const && noexcept { return std::move(*storage_.get()); }
+
+            T& value() noexcept { return *storage_.get(); }
+
+            const T& value() const noexcept { return *storage_.get(); }
+
+            /**
+             * @returns Whether the box holds a value, which is always the case unless moved from
+             */
+            bool has_value() const noexcept { return storage_.get() != nullptr; }
+
+            friend void swap(boxed& lhs, boxed& rhs) noexcept(!is_inline || std::is_nothrow_move_assignable<T>::value)
+            {
+            	lhs.storage_.swap(rhs.storage_);
+            }
+        private:
+            detail::box_storage<T, is_inline> storage_;
+        };
+
+        template <typename T, std::size_t N>
+        bool operator==(const boxed<T, N>& lhs, const boxed<T, N>& rhs) { return lhs.value() == rhs.value(); }
+
+        template <typename T, std::size_t N>
+        bool operator==(const boxed<T, N>& lhs, const T& rhs) { return lhs.value() == rhs; }
+
+        template <typename T, std::size_t N>
+        bool operator==(const T& lhs, const boxed<T, N>& rhs) { return lhs == rhs.value(); }
+
+        template <typename T, std::size_t N>
+        bool operator!=(const boxed<T, N>& lhs, const boxed<T, N>& rhs) { return lhs.value() != rhs.value(); }
+
+        template <typename T, std::size_t N>
+        bool operator!=(const boxed<T, N>& lhs, const T& rhs) { return lhs.value() != rhs; }
+
+        template <typename T, std::size_t N>
+        bool operator!=(const T& lhs, const boxed<T, N>& rhs) { return lhs != rhs.value(); }
+
+        template <typename T, std::size_t N>
+        bool operator<(const boxed<T, N>& lhs, const boxed<T, N>& rhs) { return lhs.value() < rhs.value(); }
+
+        template <typename T, std::size_t N>
+        bool operator<=(const boxed<T, N>& lhs, const boxed<T, N>& rhs) { return lhs.value() <= rhs.value(); }
+
+        template <typename T, std::size_t N>
+        bool operator>(const boxed<T, N>& lhs, const boxed<T, N>& rhs) { return lhs.value() > rhs.value(); }
+
+        template <typename T, std::size_t N>
+        bool operator>=(const boxed<T, N>& lhs, const boxed<T, N>& rhs) { return lhs.value() >= rhs.value(); }
+    }
+
+    namespace gift
+    {
+    	/** A box holding its value out of line is relocated as a pointer */
+    	template <typename T, std::size_t N>
+    	struct is_trivially_relocatable<wrap::boxed<T, N>> : std::integral_constant<bool,
+    			!wrap::boxed<T, N>::is_inline || is_trivially_relocatable<T>::value> {};
+    }
+
+    /** Counts the allocation of a box holding its value out of line */
+    template <typename T, std::size_t N>
+    struct footprint_traits<wrap::boxed<T, N>>
+	{
+    	static std::size_t size(const wrap::boxed<T, N>& box)
+		{
+    		if (!box.has_value())
+    		{
+    			return sizeof(box);
+    		}
+    		return sizeof(box) + footprint(*box) - ((wrap::boxed<T, N>::is_inline) ? sizeof(T) : 0);
+		}
+	};
+}
+
+#include <mixme/wrap/impl/boxed.tpp>
+
+#endif
@@ -0,0 +1,106 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_BUDGET_STORAGE_HPP_
+#define MIXME_WRAP_BUDGET_STORAGE_HPP_
+
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <mixme/wrap/footprint.hpp>
+
+namespace mixme
+{
+    namespace wrap
+    {
+		/**
+		 * Storage holding as many elements as fit in its budget, in bytes as measured by mixme::footprint.
+		 * Each history starts with Budget bytes, changed at runtime with the wrappers' set_bytes_budget.
+		 * Before storing a new element, the oldest elements are evicted until its footprint fits, so if copying it
+		 * throws they are lost. The most recent element is always kept, even if it alone exceeds the budget.
+		 */
+		template <typename T, std::size_t Budget = std::numeric_limits<std::size_t>::max()>
+		struct budget_storage
+		{
+		protected:
+			struct entry
+			{
+				template <typename U>
+				explicit entry(U&& value) : value(std::forward<U>(value)), bytes(footprint(this->value)) {}
+
+				T value;
+				std::size_t bytes;
+			};
+
+			using data_type = std::deque<entry>;
+
+			struct bookkeeping_type
+			{
+				std::size_t count = 0;
+				std::size_t bytes = 0;
+				std::size_t budget = Budget;
+			};
+
+			static bool has_data(bookkeeping_type bkp) { return bkp.count > 0; }
+
+			static std::size_t max_size(bookkeeping_type bkp) { return std::numeric_limits<std::size_t>::max(); }
+
+			static std::size_t size(bookkeeping_type bkp) { return bkp.count; }
+
+			static std::size_t bytes_used(bookkeeping_type bkp) { return bkp.bytes; }
+
+			static std::size_t bytes_budget(bookkeeping_type bkp) { return bkp.budget; }
+
+			static void set_bytes_budget(data_type& data, bookkeeping_type& bkp, std::size_t bytes);
+
+        	static void copy_construct(const data_type& src,
+        			const bookkeeping_type& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp);
+
+        	static void move_construct(data_type&& src,
+        			bookkeeping_type&& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp) noexcept;
+
+        	static void copy_assign(const data_type& src,
+        			const bookkeeping_type& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp);
+
+        	static void move_assign(data_type&& src,
+        			bookkeeping_type&& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp) noexcept;
+
+        	static void dispose(data_type&, bookkeeping_type) noexcept {}
+
+        	static void clear(data_type& data, bookkeeping_type& bkp) noexcept
+        	{
+        		data.clear();
+        		bkp.count = 0;
+        		bkp.bytes = 0;
+        	}
+
+			static void store(T&, data_type&, bookkeeping_type&);
+
+			static void restore(T&, data_type&, bookkeeping_type&) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+			/// Evicts the oldest elements until bytes more fit in the budget, or none is left
+			static void evict(data_type& data, bookkeeping_type& bkp, std::size_t bytes) noexcept;
+		};
+    }
+}
+
+#include <mixme/wrap/impl/budget_storage.tpp>
+
+#endif
@@ -0,0 +1,140 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_CHECKPOINT_HPP_
+#define MIXME_WRAP_CHECKPOINT_HPP_
+
+#include <cstddef>
+#include <vector>
+#include <mixme/wrap/history.hpp>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	namespace detail
+		{
+    		enum class checkpoint_action { save, undo, redo };
+
+    		/**
+    		 * Operations on a batch of registered wrappers of the same type, each processing the whole batch
+    		 */
+    		struct checkpoint_ops
+			{
+    			/** @returns Whether every wrapper can perform the action */
+    			bool (*ready)(checkpoint_action, void* const* objects, std::size_t count);
+
+    			/**
+    			 * Performs the action on every wrapper, reverting them all if one throws.
+    			 * @returns The journal needed to revert the batch, or nullptr if inverse actions suffice
+    			 */
+    			void* (*apply)(checkpoint_action, void* const* objects, std::size_t count, bool& kept);
+
+    			/** Reverts a successful apply, consuming its journal */
+    			void (*revert)(checkpoint_action, void* const* objects, std::size_t count, void* journal) noexcept;
+
+    			/** Disposes the journal of an apply that is not going to be reverted */
+    			void (*release)(void* journal) noexcept;
+			};
+
+    		template <typename W>
+    		struct checkpoint_batch;
+		}
+
+    	/**
+    	 * Group of undoable and redoable objects saved, undone and redone together as a single transaction.
+    	 *
+    	 * Every group operation gives the strong exception guarantee: if a wrapper throws, the ones already
+    	 * processed are reverted, using the inverse operation where possible (undo after save, redo after undo)
+    	 * and a backup copy of the wrapper where the operation drops a state from a full history.
+    	 * The inverse operations move values back into the history slots just released, so they never copy.
+    	 * They are only used when the storage policy provides move_store and declares restore noexcept;
+    	 * otherwise the wrapper is backed up before the operation, and reverting move assigns it back.
+    	 * Reverting then can't throw as long as the values and the histories are nothrow move assignable.
+    	 *
+    	 * Wrappers of the same type are processed in one batch, so a group operation makes one indirect call
+    	 * per registered type rather than per object.
+    	 *
+    	 * The group doesn't own the objects, which must outlive their registration. Not thread safe.
+    	 */
+    	class checkpoint_group
+		{
+    	public:
+    		/**
+    		 * Registers an object. An object must not be registered twice
+    		 */
+    		template <typename T, typename Storage_policy, typename Instrumentation>
+    		void add(undoable<T, Storage_policy, Instrumentation>& object);
+
+    		template <typename T, typename Storage_policy, typename Instrumentation>
+    		void add(redoable<T, Storage_policy, Instrumentation>& object);
+
+    		/**
+    		 * Unregisters an object
+    		 * @returns Whether the object was registered
+    		 */
+    		template <typename T, typename Storage_policy, typename Instrumentation>
+    		bool remove(undoable<T, Storage_policy, Instrumentation>& object);
+
+    		template <typename T, typename Storage_policy, typename Instrumentation>
+    		bool remove(redoable<T, Storage_policy, Instrumentation>& object);
+
+    		/**
+    		 * Unregisters all objects
+    		 */
+    		void clear() noexcept { batches_.clear(); }
+
+    		/**
+    		 * @returns The number of registered objects
+    		 */
+    		std::size_t size() const noexcept;
+
+    		/**
+    		 * Saves the state of every object
+    		 * @returns Whether every save was kept without overwriting or evicting an older one
+    		 */
+    		bool save_all();
+
+    		/**
+    		 * Restores the last saved state of every object, only if every object has a save
+    		 * @returns Whether the states were restored
+    		 */
+    		bool undo_all();
+
+    		/**
+    		 * Cancels the last undo of every object, only if every object is redoable and has an edit
+    		 * @returns Whether the undos were cancelled
+    		 */
+    		bool redo_all();
+    	private:
+    		struct batch
+			{
+    			const detail::checkpoint_ops* ops;
+    			std::vector<void*> objects;
+			};
+
+    		template <typename W>
+    		void insert(W& object);
+
+    		template <typename W>
+    		bool erase(W& object);
+
+    		bool run(detail::checkpoint_action action);
+
+    		std::vector<batch> batches_;
+		};
+    }
+}
+
+#include <mixme/wrap/impl/checkpoint.tpp>
+
+#endif
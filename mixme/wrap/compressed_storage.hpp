@@ -0,0 +1,85 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_COMPRESSED_STORAGE_HPP_
+#define MIXME_WRAP_COMPRESSED_STORAGE_HPP_
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include <mixme/detail/compression.hpp>
+#include <mixme/wrap/serialize.hpp>
+#include <mixme/wrap/tiered_storage.hpp>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	namespace detail
+		{
+    		/** Cold tier of compressed_storage: a sequence of compressed blocks */
+    		class compressed_blocks
+			{
+    		public:
+    			using block_type = std::vector<unsigned char>;
+
+    			static block_type prepare(const std::vector<unsigned char>& raw)
+    			{
+    				block_type compressed;
+    				mixme::detail::compress(raw.data(), raw.size(), compressed);
+    				compressed.shrink_to_fit();
+    				return compressed;
+    			}
+
+    			static std::size_t bytes(const block_type& block) noexcept { return block.size(); }
+
+    			void push_back(block_type&& block) { blocks_.push_back(std::move(block)); }
+
+    			void pop_front() noexcept { blocks_.pop_front(); }
+
+    			void pop_back() noexcept { blocks_.pop_back(); }
+
+    			std::size_t front_bytes() const noexcept { return blocks_.front().size(); }
+
+    			std::size_t back_bytes() const noexcept { return blocks_.back().size(); }
+
+    			const unsigned char* back(std::vector<unsigned char>& scratch, std::size_t& size) const
+    			{
+    				mixme::detail::decompress(blocks_.back().data(), blocks_.back().size(), scratch);
+    				size = scratch.size();
+    				return scratch.data();
+    			}
+
+    			bool empty() const noexcept { return blocks_.empty(); }
+
+    			void clear() noexcept { blocks_.clear(); }
+    		private:
+    			std::deque<block_type> blocks_; // oldest first
+			};
+		}
+
+		/**
+		 * Storage holding up to N elements, of which the most recent Hot are kept as they are and
+		 * the older ones are serialized and compressed. When full, the oldest element is evicted.
+		 *
+		 * Traits must satisfy the requirements of serialize_traits.
+		 */
+		template <typename T, std::size_t N, std::size_t Hot = 1, typename Traits = serialize_traits<T>>
+		struct compressed_storage : detail::tiered_storage<T, N, Hot, Traits, detail::compressed_blocks>
+		{
+			static_assert(N > 0, "compressed_storage must be able to hold at least one element");
+			static_assert(Hot <= N, "compressed_storage can't keep more uncompressed elements than its size");
+		};
+    }
+}
+
+#endif
@@ -0,0 +1,295 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_CONCURRENT_HPP_
+#define MIXME_WRAP_CONCURRENT_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	namespace detail
+		{
+    		// Immutable once published. Reference counts are only touched by the writer
+    		template <typename T>
+    		struct mvcc_value
+			{
+    			template <typename... Args>
+    			explicit mvcc_value(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+    			T value;
+    			std::size_t refs = 1;
+			};
+
+    		template <typename T>
+    		struct mvcc_link
+			{
+    			mvcc_value<T>* value;
+    			mvcc_link* next;
+    			std::size_t depth;
+    			std::size_t refs;
+			};
+
+    		template <typename T>
+    		struct mvcc_state
+			{
+    			mvcc_value<T>* value;
+    			mvcc_link<T>* undo;
+    			mvcc_link<T>* redo;
+			};
+
+    		struct alignas(64) mvcc_slot
+			{
+    			std::atomic<std::uint64_t> epoch{0}; // 0 when free, otherwise pinned by a reader
+			};
+		}
+
+    	/**
+    	 * Wraps a class giving it the possibility of saving and restoring its state, undoing and redoing
+    	 * modifications, while other threads read it.
+    	 *
+    	 * A single writer thread modifies the value and calls save, undo and redo, which never wait for readers.
+    	 * Any thread can take a snapshot: an immutable view of the value and of the histories as they were
+    	 * when it was taken, obtained without locks. Values are never modified in place: each modification
+    	 * publishes a new version, and saving only shares it with the undo history.
+    	 *
+    	 * Reclamation is epoch based: each snapshot pins one of Readers slots, and the writer frees old
+    	 * versions once no slot pins an epoch they were visible in. Taking a snapshot while all slots are
+    	 * pinned waits for one to be released.
+    	 *
+    	 * Not copyable nor movable. Snapshots must not outlive the object.
+    	 */
+        template <typename T, std::size_t Readers = 64>
+        class concurrent_redoable
+        {
+        	using value_node = detail::mvcc_value<T>;
+        	using link_node = detail::mvcc_link<T>;
+        	using state_type = detail::mvcc_state<T>;
+        public:
+            using value_type = T;
+
+            static_assert(Readers > 0, "concurrent_redoable needs at least one reader slot");
+
+            /**
+             * Forward iterable range over a history, most recent state first
+             */
+            class history
+			{
+            public:
+            	class iterator
+				{
+            	public:
+            		using iterator_category = std::forward_iterator_tag;
+            		using value_type = T;
+            		using difference_type = std::ptrdiff_t;
+            		using pointer = const T*;
+            		using reference = const T&;
+
+            		iterator() = default;
+
+            		reference operator*() const { return link_->value->value; }
+
+            		pointer operator->() const { return &link_->value->value; }
+
+            		iterator& operator++() { link_ = link_->next; return *this; }
+
+            		iterator operator++(int) { iterator previous = *this; link_ = link_->next; return previous; }
+
+            		friend bool operator==(iterator lhs, iterator rhs) { return lhs.link_ == rhs.link_; }
+
+            		friend bool operator!=(iterator lhs, iterator rhs) { return lhs.link_ != rhs.link_; }
+            	private:
+            		friend class history;
+
+            		explicit iterator(const link_node* link) : link_(link) {}
+
+            		const link_node* link_ = nullptr;
+				};
+
+            	iterator begin() const { return iterator(top_); }
+
+            	iterator end() const { return iterator(); }
+
+            	std::size_t size() const noexcept { return (top_) ? top_->depth : 0; }
+
+            	bool empty() const noexcept { return top_ == nullptr; }
+
+            	const T& front() const { return top_->value->value; }
+            private:
+            	friend class concurrent_redoable;
+
+            	explicit history(const link_node* top) : top_(top) {}
+
+            	const link_node* top_;
+			};
+
+            /**
+             * Consistent view of the object, valid until destroyed. Move only
+             */
+            class snapshot
+			{
+            public:
+            	snapshot(snapshot&& other) noexcept : slot_(other.slot_), state_(other.state_) { other.slot_ = nullptr; }
+
+            	snapshot& operator=(snapshot&& other) noexcept;
+
+            	~snapshot();
+
+            	const T& operator*() const { return value(); }
+
+            	const T* operator->() const { return &value(); }
+
+            	const T& value() const { return state_->value->value; }
+
+            	/**
+            	 * @returns The saved states, most recent first
+            	 */
+            	history undo_history() const { return history(state_->undo); }
+
+            	/**
+            	 * @returns The undone states, most recent first
+            	 */
+            	history redo_history() const { return history(state_->redo); }
+            private:
+            	friend class concurrent_redoable;
+
+            	snapshot(detail::mvcc_slot* slot, const state_type* state) : slot_(slot), state_(state) {}
+
+            	detail::mvcc_slot* slot_;
+            	const state_type* state_;
+			};
+
+            concurrent_redoable() : concurrent_redoable(std::piecewise_construct) {}
+
+            template <typename U, typename std::enable_if_t<!std::is_same<concurrent_redoable, std::decay_t<U>>::value>* = nullptr>
+            concurrent_redoable(U&& value) : concurrent_redoable(std::piecewise_construct, std::forward<U>(value)) {}
+
+            template <typename... Args, typename std::enable_if_t<(sizeof...(Args) > 1)>* = nullptr>
+            concurrent_redoable(Args&&... args) : concurrent_redoable(std::piecewise_construct, std::forward<Args>(args)...) {}
+
+            concurrent_redoable(const concurrent_redoable&) = delete;
+
+            concurrent_redoable& operator=(const concurrent_redoable&) = delete;
+
+            /**
+             * Requires all snapshots to have been destroyed
+             */
+            ~concurrent_redoable();
+
+            /**
+             * Takes a snapshot of the current state. Can be called from any thread
+             */
+            snapshot read() const;
+
+            /**
+             * The current value, only to be used by the writer
+             */
+            const T& value() const noexcept { return current()->value->value; }
+
+            const T& operator*() const noexcept { return value(); }
+
+            const T* operator->() const noexcept { return &value(); }
+
+            /**
+             * Publishes a new value
+             */
+            template <typename U>
+            void set(U&& value);
+
+            /**
+             * Publishes a copy of the value modified by f, called with a T&
+             */
+            template <typename F>
+            void modify(F&& f);
+
+            /**
+             * Saves the current state, without copying it
+             *
+             * @returns True, the history is unbounded
+             */
+            bool save();
+
+            bool has_save() const noexcept { return current()->undo != nullptr; }
+
+            std::size_t saves() const noexcept { return history(current()->undo).size(); }
+
+            /**
+             * Restores the last saved state, if present, keeping the current one as an edit. No copy is made.
+             *
+             * @returns True if a saved state has been restored
+             */
+            bool undo();
+
+            /**
+             * Restores the last undone state, if present. No copy is made.
+             *
+             * @returns True if an undone state has been restored
+             */
+            bool redo();
+
+            bool has_edit() const noexcept { return current()->redo != nullptr; }
+
+            std::size_t edits() const noexcept { return history(current()->redo).size(); }
+
+            /**
+             * Frees the versions no snapshot can see anymore. Called by every modification
+             */
+            void collect();
+
+            /**
+             * @returns The number of replaced versions waiting for readers to release them
+             */
+            std::size_t retired() const noexcept { return retired_.size(); }
+        private:
+            struct retired_state
+			{
+            	std::uint64_t epoch;
+            	state_type* state;
+			};
+
+            template <typename... Args>
+            explicit concurrent_redoable(std::piecewise_construct_t, Args&&... args);
+
+            state_type* current() const noexcept { return state_.load(std::memory_order_relaxed); }
+
+            static link_node* push(value_node* value, link_node* next);
+
+            static void acquire(value_node* node) noexcept { node->refs++; }
+
+            static void acquire(link_node* node) noexcept { if (node) node->refs++; }
+
+            static void release(value_node* node) noexcept;
+
+            static void release(link_node* node) noexcept;
+
+            static void release(state_type* state) noexcept;
+
+            void publish(value_node* value, link_node* undo, link_node* redo);
+
+            std::atomic<state_type*> state_;
+            std::atomic<std::uint64_t> epoch_{1};
+            mutable detail::mvcc_slot slots_[Readers];
+            std::vector<retired_state> retired_;
+        };
+    }
+}
+
+#include <mixme/wrap/impl/concurrent.tpp>
+
+#endif
@@ -0,0 +1,177 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_COW_HPP_
+#define MIXME_WRAP_COW_HPP_
+
+#include <utility>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	namespace detail
+		{
+    		template <typename T>
+    		struct cow_node
+			{
+    			template <typename... Args>
+    			explicit cow_node(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+    			std::atomic<std::size_t> refs{1};
+    			T value;
+			};
+		}
+
+    	/**
+    	 * Wraps a class giving it the possibility of saving and restoring its state, undoing all modifications.
+    	 * The value and its saved state share the same representation until the first mutable access,
+    	 * so saving is constant time and only writes pay for a copy.
+    	 *
+    	 * Mutable access (non-const operator->, operator* and value()) must be assumed to modify the value.
+    	 * Copies share representations through an atomic reference count, so distinct copies can be used
+    	 * from different threads. A single object is not thread safe, as for undoable.
+    	 */
+        template <typename T>
+        class cow_undoable
+        {
+        public:
+            using value_type = T;
+
+            cow_undoable() : value_(new node_type()) {}
+
+            cow_undoable(const cow_undoable& other) noexcept;
+
+            cow_undoable(cow_undoable&& other) noexcept;
+
+            template <typename U, typename std::enable_if_t<!std::is_same<cow_undoable, std::decay_t<U>>::value>* = nullptr>
+            cow_undoable(U&& value) : value_(new node_type(std::forward<U>(value))) {}
+
+            template <typename... Args, typename std::enable_if_t<(sizeof...(Args) > 1)>* = nullptr>
+            cow_undoable(Args&&... args) : value_(new node_type(std::forward<Args>(args)...)) {}
+
+            ~cow_undoable();
+
+            cow_undoable& operator=(const cow_undoable& other) noexcept;
+
+            cow_undoable& operator=(cow_undoable&& other) noexcept;
+
+            template <typename U, typename std::enable_if_t<!std::is_same<cow_undoable, std::decay_t<U>>::value>* = nullptr>
+            cow_undoable& operator=(U&& value);
+
+            T* operator->() { return &value(); }
+
+            const T* operator->() const { return &value(); }
+
+            T& operator*() & { return value(); }
+
+            const T& operator*() const & { return value(); }
+
+            T&& operator*() && { return std::move(value()); }
+
+            const T&& operator*() const && { return std::move(value()); }
+
+            /**
+             * Gives mutable access to the value, copying it first if it's shared with a saved state
+             */
+            T& value();
+
+            const T& value() const noexcept { return value_->value; }
+
+            /**
+             * Saves the current state, without copying it. It may overwrite the current saved state.
+             *
+             * @returns False if the operation overwrote a previous saved state
+             */
+            bool save() noexcept;
+
+            /**
+             * @returns Whether there's a valid saved state, that a call to undo will restore
+             */
+            bool has_save() const noexcept { return undo_ != nullptr; }
+
+            /**
+             * @returns The maximum number of storable save states
+             */
+            std::size_t max_saves() const noexcept { return 1; }
+
+            /**
+             * @returns The current number of stored save states
+             */
+            std::size_t saves() const noexcept { return (undo_) ? 1 : 0; }
+
+            /**
+             * Restores the saved state, if present. No copy is made.
+             *
+             * @returns True if a saved state has been restored
+             */
+            bool undo() noexcept;
+
+            /**
+             * @returns Whether the value shares its representation with a saved state
+             */
+            bool shared() const noexcept { return value_->refs.load(std::memory_order_acquire) > 1; }
+
+            friend void swap(cow_undoable& lhs, cow_undoable& rhs) noexcept
+            {
+            	std::swap(lhs.value_, rhs.value_);
+            	std::swap(lhs.undo_, rhs.undo_);
+            }
+        private:
+            using node_type = detail::cow_node<T>;
+
+            static node_type* acquire(node_type* node) noexcept;
+
+            static void release(node_type* node) noexcept;
+
+            node_type* value_;
+            node_type* undo_ = nullptr;
+        };
+
+        template <typename T>
+        bool operator==(const cow_undoable<T>& lhs, const cow_undoable<T>& rhs) { return lhs.value() == rhs.value(); }
+
+        template <typename T>
+        bool operator==(const cow_undoable<T>& lhs, const T& rhs) { return lhs.value() == rhs; }
+
+        template <typename T>
+        bool operator==(const T& lhs, const cow_undoable<T>& rhs) { return lhs == rhs.value(); }
+
+        template <typename T>
+        bool operator!=(const cow_undoable<T>& lhs, const cow_undoable<T>& rhs) { return lhs.value() != rhs.value(); }
+
+        template <typename T>
+        bool operator!=(const cow_undoable<T>& lhs, const T& rhs) { return lhs.value() != rhs; }
+
+        template <typename T>
+        bool operator!=(const T& lhs, const cow_undoable<T>& rhs) { return lhs != rhs.value(); }
+
+        template <typename T>
+        bool operator<(const cow_undoable<T>& lhs, const cow_undoable<T>& rhs) { return lhs.value() < rhs.value(); }
+
+        template <typename T>
+        bool operator<=(const cow_undoable<T>& lhs, const cow_undoable<T>& rhs) { return lhs.value() <= rhs.value(); }
+
+        template <typename T>
+        bool operator>(const cow_undoable<T>& lhs, const cow_undoable<T>& rhs) { return lhs.value() > rhs.value(); }
+
+        template <typename T>
+        bool operator>=(const cow_undoable<T>& lhs, const cow_undoable<T>& rhs) { return lhs.value() >= rhs.value(); }
+    }
+}
+
+#include <mixme/wrap/impl/cow.tpp>
+
+#endif
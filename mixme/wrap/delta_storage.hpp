@@ -0,0 +1,143 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_DELTA_STORAGE_HPP_
+#define MIXME_WRAP_DELTA_STORAGE_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <limits>
+#include <type_traits>
+
+namespace mixme
+{
+	namespace detail
+	{
+		/**
+		 * Sequence of byte ranges to overwrite in an object representation
+		 */
+		struct byte_delta
+		{
+			struct run
+			{
+				std::size_t offset;
+				std::size_t length;
+			};
+
+			std::vector<run> runs;
+			std::vector<unsigned char> bytes;
+		};
+
+		byte_delta diff_bytes(const unsigned char* from, const unsigned char* to, std::size_t size);
+
+		void patch_bytes(unsigned char* dst, const byte_delta& delta) noexcept;
+	}
+
+	/**
+	 * Customization point describing how to compute and apply differences between two values of T.
+	 *
+	 * Specializations must provide:
+	 * - delta_type
+	 * - static delta_type diff(const T& from, const T& to), returning a delta that turns from into to
+	 * - static void apply(T& value, const delta_type& delta)
+	 *
+	 * A byte-level implementation is provided for trivially copyable types.
+	 */
+	template <typename T, typename = void>
+	struct diff_traits;
+
+	template <typename T>
+	struct diff_traits<T, std::enable_if_t<std::is_trivially_copyable<T>::value>>
+	{
+		using delta_type = detail::byte_delta;
+
+		static delta_type diff(const T& from, const T& to)
+		{
+			return detail::diff_bytes(reinterpret_cast<const unsigned char*>(&from),
+					reinterpret_cast<const unsigned char*>(&to),
+					sizeof(T));
+		}
+
+		static void apply(T& value, const delta_type& delta) noexcept
+		{
+			detail::patch_bytes(reinterpret_cast<unsigned char*>(&value), delta);
+		}
+	};
+
+    namespace wrap
+    {
+		/**
+		 * Storage consisting in a full copy of the most recent element plus a chain of deltas.
+		 * Each delta rebuilds an element from the one stored after it, thus restoring applies one delta.
+		 *
+		 * T must be copyable. Traits must satisfy the requirements of diff_traits.
+		 */
+		template <typename T, typename Traits = diff_traits<T>>
+		struct delta_storage
+		{
+		protected:
+			using delta_type = typename Traits::delta_type;
+
+			struct data_type
+			{
+				std::unique_ptr<T> head;
+				std::vector<delta_type> deltas;
+			};
+
+			using bookkeeping_type = std::size_t;
+
+			static bool has_data(bookkeeping_type bkp) { return bkp > 0; }
+
+			static std::size_t max_size(bookkeeping_type bkp) { return std::numeric_limits<std::size_t>::max(); }
+
+			static std::size_t size(bookkeeping_type bkp) { return bkp; }
+
+        	static void copy_construct(const data_type& src,
+        			const bookkeeping_type& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp);
+
+        	static void move_construct(data_type&& src,
+        			bookkeeping_type&& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp) noexcept;
+
+        	static void copy_assign(const data_type& src,
+        			const bookkeeping_type& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp);
+
+        	static void move_assign(data_type&& src,
+        			bookkeeping_type&& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp) noexcept;
+
+        	static void dispose(data_type&, bookkeeping_type) noexcept {}
+
+        	static void clear(data_type& data, bookkeeping_type& bkp) noexcept
+        	{
+        		data.head.reset();
+        		data.deltas.clear();
+        		bkp = 0;
+        	}
+
+			static void store(T&, data_type&, bookkeeping_type&);
+
+			static void restore(T&, data_type&, bookkeeping_type&);
+		};
+    }
+}
+
+#include <mixme/wrap/impl/delta_storage.tpp>
+
+#endif
@@ -0,0 +1,208 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef MIXME_WRAP_ELEMENT_UNDOABLE_HPP_
+#define MIXME_WRAP_ELEMENT_UNDOABLE_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <mixme/wrap/journaled.hpp>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	namespace detail
+		{
+    		/**
+    		 * Interface shared by the element_undoable specializations: the history is kept by a journaled container,
+    		 * and the derived classes only add the mutations.
+    		 */
+    		template <typename C>
+    		class element_history
+			{
+    		public:
+    			using value_type = C;
+
+    			element_history() = default;
+
+    			template <typename U, typename std::enable_if_t<!std::is_base_of<element_history, std::decay_t<U>>::value>* = nullptr>
+    			element_history(U&& value) : journal_(std::forward<U>(value)) {}
+
+    			template <typename... Args, typename std::enable_if_t<(sizeof...(Args) > 1)>* = nullptr>
+    			element_history(Args&&... args) : journal_(std::forward<Args>(args)...) {}
+
+    			const C* operator->() const noexcept { return &value(); }
+
+    			const C& operator*() const & noexcept { return value(); }
+
+    			const C& value() const noexcept { return journal_.value(); }
+
+    			std::size_t size() const noexcept { return value().size(); }
+
+    			bool empty() const noexcept { return value().empty(); }
+
+    			/**
+    			 * Saves the current state, without copying it
+    			 *
+    			 * @returns Always true, as no saved state is ever overwritten
+    			 */
+    			bool save() { journal_.save(); return true; }
+
+    			bool has_save() const noexcept { return journal_.has_save(); }
+
+    			std::size_t max_saves() const noexcept { return std::numeric_limits<std::size_t>::max(); }
+
+    			std::size_t saves() const noexcept { return journal_.saves(); }
+
+    			/**
+    			 * Restores the last saved state, reverting only the elements changed since
+    			 *
+    			 * @returns True if a saved state has been restored
+    			 */
+    			bool undo() { return journal_.undo(); }
+
+    			bool has_edit() const noexcept { return journal_.has_edit(); }
+
+    			std::size_t edits() const noexcept { return journal_.edits(); }
+
+    			/**
+    			 * Restores the last edit state, applying again only the elements changed
+    			 *
+    			 * @returns True if an edit state has been restored
+    			 */
+    			bool redo() { return journal_.redo(); }
+    		protected:
+    			journaled<C> journal_;
+			};
+
+    		template <typename C>
+    		class associative_history;
+		}
+
+    	/**
+    	 * Container whose history is kept element by element: mutations go through its member functions,
+    	 * which record how to revert the single element changed, so saving, undoing and redoing cost
+    	 * as much as the elements changed rather than the size of the container.
+    	 *
+    	 * Specialized for std::vector, std::map and std::unordered_map. The elements must be copy constructible.
+    	 * Not thread safe.
+    	 */
+    	template <typename C>
+    	class element_undoable;
+
+        template <typename U, typename Allocator>
+        class element_undoable<std::vector<U, Allocator>> : public detail::element_history<std::vector<U, Allocator>>
+        {
+        public:
+        	using detail::element_history<std::vector<U, Allocator>>::element_history;
+
+        	const U& operator[](std::size_t index) const noexcept { return this->value()[index]; }
+
+        	/**
+        	 * Replaces the element at index
+        	 */
+        	template <typename V>
+        	void set(std::size_t index, V&& element);
+
+        	template <typename V>
+        	void push_back(V&& element);
+
+        	void pop_back();
+
+        	/**
+        	 * Inserts element before the one at index
+        	 */
+        	template <typename V>
+        	void insert(std::size_t index, V&& element);
+
+        	void erase(std::size_t index);
+        private:
+        	using container_type = std::vector<U, Allocator>;
+
+        	struct set_operation;
+        	struct push_back_operation;
+        	struct pop_back_operation;
+        	struct insert_operation;
+        	struct erase_operation;
+        };
+
+        template <typename Key, typename T, typename Compare, typename Allocator>
+        class element_undoable<std::map<Key, T, Compare, Allocator>>
+		: public detail::associative_history<std::map<Key, T, Compare, Allocator>>
+		{
+        public:
+        	using detail::associative_history<std::map<Key, T, Compare, Allocator>>::associative_history;
+		};
+
+        template <typename Key, typename T, typename Hash, typename Equal, typename Allocator>
+        class element_undoable<std::unordered_map<Key, T, Hash, Equal, Allocator>>
+		: public detail::associative_history<std::unordered_map<Key, T, Hash, Equal, Allocator>>
+		{
+        public:
+        	using detail::associative_history<std::unordered_map<Key, T, Hash, Equal, Allocator>>::associative_history;
+		};
+
+        namespace detail
+		{
+        	template <typename C>
+        	class associative_history : public element_history<C>
+			{
+        	public:
+        		using key_type = typename C::key_type;
+        		using mapped_type = typename C::mapped_type;
+
+        		using element_history<C>::element_history;
+
+        		/**
+        		 * @returns The element mapped to key, which must be present
+        		 */
+        		const mapped_type& at(const key_type& key) const { return this->value().at(key); }
+
+        		std::size_t count(const key_type& key) const { return this->value().count(key); }
+
+        		/**
+        		 * Maps key to element, inserting it or replacing the current one
+        		 */
+        		template <typename V>
+        		void set(const key_type& key, V&& element);
+
+        		/**
+        		 * Maps key to element, unless key is already present
+        		 *
+        		 * @returns True if element has been inserted
+        		 */
+        		template <typename V>
+        		bool insert(const key_type& key, V&& element);
+
+        		/**
+        		 * @returns True if key was present
+        		 */
+        		bool erase(const key_type& key);
+        	private:
+        		struct assign_operation;
+        		struct insert_operation;
+        		struct erase_operation;
+			};
+		}
+    }
+}
+
+#include <mixme/wrap/impl/element_undoable.tpp>
+
+#endif
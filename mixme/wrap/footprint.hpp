@@ -0,0 +1,204 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_FOOTPRINT_HPP_
+#define MIXME_WRAP_FOOTPRINT_HPP_
+
+#include <cstddef>
+#include <type_traits>
+#include <iterator>
+#include <utility>
+#include <string>
+#include <vector>
+#include <deque>
+#include <list>
+#include <forward_list>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace mixme
+{
+	/**
+	 * Customization point measuring the memory held by a value of T, in bytes.
+	 *
+	 * Specializations must provide:
+	 * - static std::size_t size(const T& value), including sizeof(T) and any memory owned indirectly
+	 *
+	 * The default implementation returns sizeof(T). Standard strings and containers are measured from
+	 * their capacity and an estimate of their per-node overhead.
+	 */
+	template <typename T, typename = void>
+	struct footprint_traits
+	{
+		static std::size_t size(const T&) noexcept { return sizeof(T); }
+	};
+
+	/**
+	 * @returns The number of bytes held by value, as measured by footprint_traits
+	 */
+	template <typename T>
+	std::size_t footprint(const T& value)
+	{
+		return footprint_traits<T>::size(value);
+	}
+
+	namespace detail
+	{
+		/// Approximate bookkeeping bytes of each node of a node based container
+		constexpr std::size_t list_node_overhead = 2 * sizeof(void*);
+		constexpr std::size_t tree_node_overhead = 4 * sizeof(void*);
+		constexpr std::size_t hash_node_overhead = 2 * sizeof(void*);
+
+		/// Memory owned indirectly by the elements in [first, last)
+		template <typename It>
+		std::size_t elements_indirect_footprint(It first, It last)
+		{
+			using value_type = typename std::iterator_traits<It>::value_type;
+			if (std::is_trivially_copyable<value_type>::value)
+			{
+				return 0;
+			}
+			std::size_t bytes = 0;
+			for (; first != last; ++first)
+			{
+				bytes += footprint(*first) - sizeof(value_type);
+			}
+			return bytes;
+		}
+
+		template <typename C, typename T>
+		std::size_t node_container_footprint(const C& c, std::size_t nodes, std::size_t overhead)
+		{
+			return sizeof(C) + nodes * (sizeof(T) + overhead) + elements_indirect_footprint(c.begin(), c.end());
+		}
+	}
+
+	template <typename T, typename U>
+	struct footprint_traits<std::pair<T, U>>
+	{
+		static std::size_t size(const std::pair<T, U>& p)
+		{
+			return sizeof(p) + (footprint(p.first) - sizeof(T)) + (footprint(p.second) - sizeof(U));
+		}
+	};
+
+	template <typename C, typename Traits, typename A>
+	struct footprint_traits<std::basic_string<C, Traits, A>>
+	{
+		static std::size_t size(const std::basic_string<C, Traits, A>& s) noexcept
+		{
+			const auto begin = reinterpret_cast<const unsigned char*>(&s);
+			const auto data = reinterpret_cast<const unsigned char*>(s.data());
+			const bool small = (data >= begin && data < begin + sizeof(s));
+			return sizeof(s) + ((small) ? 0 : (s.capacity() + 1) * sizeof(C));
+		}
+	};
+
+	template <typename T, typename A>
+	struct footprint_traits<std::vector<T, A>>
+	{
+		static std::size_t size(const std::vector<T, A>& v)
+		{
+			return sizeof(v) + v.capacity() * sizeof(T) + detail::elements_indirect_footprint(v.begin(), v.end());
+		}
+	};
+
+	template <typename T, typename A>
+	struct footprint_traits<std::deque<T, A>>
+	{
+		static std::size_t size(const std::deque<T, A>& d)
+		{
+			return sizeof(d) + d.size() * sizeof(T) + detail::elements_indirect_footprint(d.begin(), d.end());
+		}
+	};
+
+	template <typename T, typename A>
+	struct footprint_traits<std::list<T, A>>
+	{
+		static std::size_t size(const std::list<T, A>& l)
+		{
+			return detail::node_container_footprint<std::list<T, A>, T>(l, l.size(), detail::list_node_overhead);
+		}
+	};
+
+	template <typename T, typename A>
+	struct footprint_traits<std::forward_list<T, A>>
+	{
+		static std::size_t size(const std::forward_list<T, A>& l)
+		{
+			const auto nodes = static_cast<std::size_t>(std::distance(l.begin(), l.end()));
+			return detail::node_container_footprint<std::forward_list<T, A>, T>(l, nodes, sizeof(void*));
+		}
+	};
+
+	template <typename K, typename V, typename C, typename A>
+	struct footprint_traits<std::map<K, V, C, A>>
+	{
+		static std::size_t size(const std::map<K, V, C, A>& m)
+		{
+			return detail::node_container_footprint<std::map<K, V, C, A>, std::pair<const K, V>>(
+					m, m.size(), detail::tree_node_overhead);
+		}
+	};
+
+	template <typename K, typename V, typename C, typename A>
+	struct footprint_traits<std::multimap<K, V, C, A>>
+	{
+		static std::size_t size(const std::multimap<K, V, C, A>& m)
+		{
+			return detail::node_container_footprint<std::multimap<K, V, C, A>, std::pair<const K, V>>(
+					m, m.size(), detail::tree_node_overhead);
+		}
+	};
+
+	template <typename K, typename C, typename A>
+	struct footprint_traits<std::set<K, C, A>>
+	{
+		static std::size_t size(const std::set<K, C, A>& s)
+		{
+			return detail::node_container_footprint<std::set<K, C, A>, K>(s, s.size(), detail::tree_node_overhead);
+		}
+	};
+
+	template <typename K, typename C, typename A>
+	struct footprint_traits<std::multiset<K, C, A>>
+	{
+		static std::size_t size(const std::multiset<K, C, A>& s)
+		{
+			return detail::node_container_footprint<std::multiset<K, C, A>, K>(s, s.size(), detail::tree_node_overhead);
+		}
+	};
+
+	template <typename K, typename V, typename H, typename E, typename A>
+	struct footprint_traits<std::unordered_map<K, V, H, E, A>>
+	{
+		static std::size_t size(const std::unordered_map<K, V, H, E, A>& m)
+		{
+			return detail::node_container_footprint<std::unordered_map<K, V, H, E, A>, std::pair<const K, V>>(
+					m, m.size(), detail::hash_node_overhead) + m.bucket_count() * sizeof(void*);
+		}
+	};
+
+	template <typename K, typename H, typename E, typename A>
+	struct footprint_traits<std::unordered_set<K, H, E, A>>
+	{
+		static std::size_t size(const std::unordered_set<K, H, E, A>& s)
+		{
+			return detail::node_container_footprint<std::unordered_set<K, H, E, A>, K>(
+					s, s.size(), detail::hash_node_overhead) + s.bucket_count() * sizeof(void*);
+		}
+	};
+}
+
+#endif
@@ -16,8 +16,18 @@
 #include <utility>
 #include <cstddef>
 #include <array>
+#include <vector>
+#include <memory>
+#include <limits>
+#include <mixme/detail/config.hpp>
 #include <mixme/detail/types.hpp>
+#include <mixme/detail/relocation.hpp>
 #include <mixme/wrap/base.hpp>
+#include <mixme/wrap/instrumentation.hpp>
+
+#ifdef MIXME_HAS_MEMORY_RESOURCE
+#include <memory_resource>
+#endif
 
 namespace mixme
 {
@@ -26,11 +36,44 @@ namespace mixme
     	template <typename T>
     	struct single_element_storage;
 
+    	namespace detail
+		{
+    		template <typename W>
+    		struct checkpoint_batch;
+
+    		/**
+    		 * Uninitialized room for an element, constructed and destroyed explicitly.
+    		 * Unlike a byte buffer, it can be used in constant expressions
+    		 */
+    		template <typename T, bool = std::is_trivially_destructible<T>::value>
+    		union element_slot
+			{
+    			constexpr element_slot() noexcept : empty() {}
+
+    			unsigned char empty;
+    			T value;
+			};
+
+    		template <typename T>
+    		union element_slot<T, false>
+			{
+    			constexpr element_slot() noexcept : empty() {}
+
+    			MIXME_CONSTEXPR20 ~element_slot() {}
+
+    			unsigned char empty;
+    			T value;
+			};
+		}
+
     	/**
-    	 * Wraps a class giving it the possibility of saving and restoring its state, undoing all modifications
+    	 * Wraps a class giving it the possibility of saving and restoring its state, undoing all modifications.
+    	 * Instrumentation is notified around every store and restore of a state, see no_instrumentation.
     	 */
-        template <typename T, typename Storage_policy = single_element_storage<T>>
-        class undoable : public base<T>, protected Storage_policy
+        template <typename T,
+			typename Storage_policy = single_element_storage<T>,
+			typename Instrumentation = no_instrumentation>
+        class undoable : public base<T>, protected Storage_policy, private Instrumentation
         {
         public:
         	using base<T>::base;
@@ -39,49 +82,211 @@ namespace mixme
 
         	constexpr undoable() = default;
 
-            constexpr undoable(const undoable&) noexcept(noexcept(Storage_policy::copy_construct));
+            constexpr undoable(const undoable&) noexcept(nothrow_copy_construct);
 
-            constexpr undoable(undoable&&) noexcept(noexcept(Storage_policy::move_construct));
+            constexpr undoable(undoable&&) noexcept(nothrow_move_construct);
 
-            ~undoable();
+            MIXME_CONSTEXPR20 ~undoable();
 
-            undoable& operator=(const undoable&) noexcept(noexcept(Storage_policy::copy_assign));
+            MIXME_CONSTEXPR20 undoable& operator=(const undoable&) noexcept(nothrow_copy_assign);
 
-            undoable& operator=(undoable&&) noexcept(noexcept(Storage_policy::move_assign));
+            MIXME_CONSTEXPR20 undoable& operator=(undoable&&) noexcept(nothrow_move_assign);
 
-            template <typename U>
-            undoable& operator=(U&&);
+            /**
+             * Constructs the value from args and the history storage from alloc
+             */
+            template <typename Alloc, typename... Args>
+            undoable(std::allocator_arg_t, Alloc&& alloc, Args&&... args);
+
+            template <typename U, typename std::enable_if_t<!std::is_base_of<undoable, std::decay_t<U>>::value>* = nullptr>
+            MIXME_CONSTEXPR20 undoable& operator=(U&&);
 
             /** 
              * Saves the current state. It may overwrite one of the current saved states.
              *
              * @returns False if the operation overwrote a previous saved state
              */
-            bool save();
+            MIXME_CONSTEXPR20 bool save();
             
             /**
              * @returns Whether there's a valid saved state, that a call to undo will restore
              */
-            bool has_save() const { return Storage_policy::has_data(undo_bkp_); }
+            constexpr bool has_save() const { return Storage_policy::has_data(undo_bkp_); }
             
             /**
              * @returns The maximum number of storable save states
              */
-            std::size_t max_saves() const { return Storage_policy::max_size(undo_bkp_); }
+            constexpr std::size_t max_saves() const { return Storage_policy::max_size(undo_bkp_); }
 
             /**
              * @returns The current number of stored save states
              */
-            std::size_t saves() const { return Storage_policy::size(undo_bkp_); }
+            constexpr std::size_t saves() const { return Storage_policy::size(undo_bkp_); }
 
             /**
              * Restores the saved state, if present
              *
              * @returns True if a saved state has been restored
              */
-            bool undo();
+            MIXME_CONSTEXPR20 bool undo();
+
+            /**
+             * Preallocates room for at least n save states. Requires a growable storage policy
+             */
+            void reserve(std::size_t n) { Storage_policy::reserve(undo_data_, undo_bkp_, n); }
+
+            /**
+             * Releases the memory not used by the current save states. Requires a growable storage policy
+             */
+            void shrink_to_fit() { Storage_policy::shrink_to_fit(undo_data_, undo_bkp_); }
+
+            /**
+             * @returns The bytes held by the save states. Requires a byte-budgeted storage policy
+             */
+            std::size_t bytes_used() const { return Storage_policy::bytes_used(undo_bkp_); }
+
+            /**
+             * @returns The maximum bytes held by the save states. Requires a byte-budgeted storage policy
+             */
+            std::size_t bytes_budget() const { return Storage_policy::bytes_budget(undo_bkp_); }
+
+            /**
+             * Sets the maximum bytes held by the save states, evicting the oldest ones that no longer fit.
+             * Requires a byte-budgeted storage policy
+             */
+            void set_bytes_budget(std::size_t bytes) { Storage_policy::set_bytes_budget(undo_data_, undo_bkp_, bytes); }
+
+            /**
+             * @returns The statistics recorded by the instrumentation
+             */
+            history_stats stats() const { return instrumentation().stats(); }
+        protected:
+            /// Whether copying and moving the wrapper, value and history alike, can't throw
+            static constexpr bool nothrow_copy_construct = std::is_nothrow_copy_constructible<T>::value &&
+            		noexcept(Storage_policy::copy_construct(std::declval<const typename Storage_policy::data_type&>(),
+            				std::declval<const typename Storage_policy::bookkeeping_type&>(),
+							std::declval<typename Storage_policy::data_type&>(),
+							std::declval<typename Storage_policy::bookkeeping_type&>()));
+
+            static constexpr bool nothrow_move_construct = std::is_nothrow_move_constructible<T>::value &&
+            		noexcept(Storage_policy::move_construct(std::declval<typename Storage_policy::data_type&&>(),
+            				std::declval<typename Storage_policy::bookkeeping_type&&>(),
+							std::declval<typename Storage_policy::data_type&>(),
+							std::declval<typename Storage_policy::bookkeeping_type&>()));
+
+            static constexpr bool nothrow_copy_assign = std::is_nothrow_copy_assignable<T>::value &&
+            		noexcept(Storage_policy::copy_assign(std::declval<const typename Storage_policy::data_type&>(),
+            				std::declval<const typename Storage_policy::bookkeeping_type&>(),
+							std::declval<typename Storage_policy::data_type&>(),
+							std::declval<typename Storage_policy::bookkeeping_type&>()));
+
+            static constexpr bool nothrow_move_assign = std::is_nothrow_move_assignable<T>::value &&
+            		noexcept(Storage_policy::move_assign(std::declval<typename Storage_policy::data_type&&>(),
+            				std::declval<typename Storage_policy::bookkeeping_type&&>(),
+							std::declval<typename Storage_policy::data_type&>(),
+							std::declval<typename Storage_policy::bookkeeping_type&>()));
+
+            /// Whether restoring a state can't throw, as declared by the storage policy
+            static constexpr bool nothrow_restore = noexcept(Storage_policy::restore(std::declval<T&>(),
+            		std::declval<typename Storage_policy::data_type&>(),
+					std::declval<typename Storage_policy::bookkeeping_type&>()));
+
+            /**
+             * Stores the value as a save state, without notifying the instrumentation
+             *
+             * @returns False if the operation overwrote a previous saved state
+             */
+            MIXME_CONSTEXPR20 bool store_save();
+
+            /**
+             * Restores the last save state, without notifying the instrumentation
+             */
+            MIXME_CONSTEXPR20 void restore_save();
+
+            /**
+             * Stores the value in the states held by to and restores the last save state, without copying the value
+             * if the storage policy provides exchange
+             */
+            MIXME_CONSTEXPR20 void exchange_save(typename Storage_policy::data_type& to, typename Storage_policy::bookkeeping_type& to_bkp);
+
+            constexpr Instrumentation& instrumentation() noexcept { return *this; }
+
+            constexpr const Instrumentation& instrumentation() const noexcept { return *this; }
+
+            /**
+             * @returns The bytes held by a history, as reported by the storage policy or sizeof(T) per state
+             */
+            template <typename P = Storage_policy>
+            static auto estimated_bytes(const typename P::bookkeeping_type& bkp, int) -> decltype(P::bytes_used(bkp))
+            {
+            	return P::bytes_used(bkp);
+            }
+
+            template <typename P = Storage_policy>
+            static std::size_t estimated_bytes(const typename P::bookkeeping_type& bkp, long)
+            {
+            	return P::size(bkp) * sizeof(T);
+            }
+
+            std::size_t estimated_undo_bytes() const { return estimated_bytes(undo_bkp_, 0); }
         private:
-            typename Storage_policy::data_type undo_data_;
+            template <typename P = Storage_policy>
+            static MIXME_CONSTEXPR20 auto transfer(T& value,
+            		typename P::data_type& from,
+					typename P::bookkeeping_type& from_bkp,
+					typename P::data_type& to,
+					typename P::bookkeeping_type& to_bkp,
+					int) -> decltype(P::exchange(value, from, from_bkp, to, to_bkp))
+            {
+            	return P::exchange(value, from, from_bkp, to, to_bkp);
+            }
+
+            template <typename P = Storage_policy>
+            static MIXME_CONSTEXPR20 void transfer(T& value,
+            		typename P::data_type& from,
+					typename P::bookkeeping_type& from_bkp,
+					typename P::data_type& to,
+					typename P::bookkeeping_type& to_bkp,
+					long)
+            {
+            	P::store(value, to, to_bkp);
+            	P::restore(value, from, from_bkp);
+            }
+
+            /**
+             * Stores the value moving it if the storage policy provides move_store, copying it otherwise
+             */
+            template <typename P = Storage_policy>
+            static MIXME_CONSTEXPR20 auto give(T& value,
+            		typename P::data_type& data,
+					typename P::bookkeeping_type& bkp,
+					int) -> decltype(P::move_store(value, data, bkp))
+            {
+            	return P::move_store(value, data, bkp);
+            }
+
+            template <typename P = Storage_policy>
+            static MIXME_CONSTEXPR20 void give(T& value, typename P::data_type& data, typename P::bookkeeping_type& bkp, long)
+            {
+            	P::store(value, data, bkp);
+            }
+
+            /** @returns Whether the storage policy provides move_store */
+            template <typename P = Storage_policy>
+            static constexpr auto moves_stores(int) -> decltype(P::move_store(std::declval<T&>(),
+            		std::declval<typename P::data_type&>(),
+					std::declval<typename P::bookkeeping_type&>()), bool())
+            {
+            	return true;
+            }
+
+            template <typename P = Storage_policy>
+            static constexpr bool moves_stores(long) { return false; }
+
+            template <typename>
+            friend struct detail::checkpoint_batch;
+
+            MIXME_NO_UNIQUE_ADDRESS typename Storage_policy::data_type undo_data_;
             typename Storage_policy::bookkeeping_type undo_bkp_ = typename Storage_policy::bookkeeping_type();
         };
 
@@ -89,109 +294,193 @@ namespace mixme
     	 * Wraps a class giving it the possibility of saving and restoring its state, undoing all modifications.
     	 * In addition, modifications can be reapplied with the redo operation.
     	 */
-        template <typename T, typename Storage_policy = single_element_storage<T>>
-        class redoable : public undoable<T, Storage_policy>
+        template <typename T,
+			typename Storage_policy = single_element_storage<T>,
+			typename Instrumentation = no_instrumentation>
+        class redoable : public undoable<T, Storage_policy, Instrumentation>
         {
         public:
-        	using undoable<T, Storage_policy>::undoable;
+        	using undoable<T, Storage_policy, Instrumentation>::undoable;
 
-        	using value_type = typename undoable<T>::value_type;
+        	using value_type = typename undoable<T, Storage_policy, Instrumentation>::value_type;
 
         	constexpr redoable() = default;
 
-            constexpr redoable(const redoable&) noexcept(noexcept(Storage_policy::copy_construct));
+            constexpr redoable(const redoable&) noexcept(undoable<T, Storage_policy, Instrumentation>::nothrow_copy_construct);
 
-            constexpr redoable(redoable&&) noexcept(noexcept(Storage_policy::move_construct));
+            constexpr redoable(redoable&&) noexcept(undoable<T, Storage_policy, Instrumentation>::nothrow_move_construct);
 
-            ~redoable();
+            MIXME_CONSTEXPR20 ~redoable();
 
-            redoable& operator=(const redoable&) noexcept(noexcept(Storage_policy::copy_assign));
+            MIXME_CONSTEXPR20 redoable& operator=(const redoable&) noexcept(undoable<T, Storage_policy, Instrumentation>::nothrow_copy_assign);
 
-            redoable& operator=(redoable&&) noexcept(noexcept(Storage_policy::move_assign));
+            MIXME_CONSTEXPR20 redoable& operator=(redoable&&) noexcept(undoable<T, Storage_policy, Instrumentation>::nothrow_move_assign);
 
-            template <typename U>
-            redoable& operator=(U&&);
+            /**
+             * Constructs the value from args and both history storages from alloc
+             */
+            template <typename Alloc, typename... Args>
+            redoable(std::allocator_arg_t, Alloc&& alloc, Args&&... args);
+
+            template <typename U, typename std::enable_if_t<!std::is_base_of<redoable, std::decay_t<U>>::value>* = nullptr>
+            MIXME_CONSTEXPR20 redoable& operator=(U&&);
+
+            /**
+             * Saves the current state, discarding the edit states, which don't follow from it anymore.
+             * It may overwrite one of the current saved states.
+             *
+             * @returns False if the operation overwrote a previous saved state
+             */
+            MIXME_CONSTEXPR20 bool save();
 
             /**
              * Restores the saved state, if present
              *
              * @returns True if a saved state has been restored
              */
-            bool undo();
+            MIXME_CONSTEXPR20 bool undo();
 
             /**
              * Reapplies all modifications lost with the last undo()
              *
              * @returns True if a saved state has been restored
              */
-            bool redo();
+            MIXME_CONSTEXPR20 bool redo();
 
             /**
              * @returns Whether there's a stored edit state, that a call to redo will restore
              */
-            bool has_edit() const { return Storage_policy::has_data(redo_bkp_); }
+            constexpr bool has_edit() const { return Storage_policy::has_data(redo_bkp_); }
 
             /**
              * @returns The maximum number of storable edit states
              */
-            std::size_t max_edits() const { return Storage_policy::max_size(redo_bkp_); }
+            constexpr std::size_t max_edits() const { return Storage_policy::max_size(redo_bkp_); }
 
             /**
              * @returns The current number of stored edit states
              */
-            std::size_t edits() const { return Storage_policy::size(redo_bkp_); }
+            constexpr std::size_t edits() const { return Storage_policy::size(redo_bkp_); }
+
+            /**
+             * Preallocates room for at least n save states and n edit states. Requires a growable storage policy
+             */
+            void reserve(std::size_t n);
+
+            /**
+             * Releases the memory not used by the current save and edit states. Requires a growable storage policy
+             */
+            void shrink_to_fit();
+
+            /**
+             * @returns The bytes held by the save and edit states. Requires a byte-budgeted storage policy
+             */
+            std::size_t bytes_used() const;
+
+            /**
+             * @returns The maximum bytes held by the save and edit states. Requires a byte-budgeted storage policy
+             */
+            std::size_t bytes_budget() const;
+
+            /**
+             * Sets the maximum bytes held by the save states and by the edit states, each, evicting the oldest
+             * ones that no longer fit. Requires a byte-budgeted storage policy
+             */
+            void set_bytes_budget(std::size_t bytes);
         private:
-            typename Storage_policy::data_type redo_data_;
-            typename Storage_policy::bookkeeping_type redo_bkp_ = false;
+            template <typename>
+            friend struct detail::checkpoint_batch;
+
+            std::size_t estimated_history_bytes() const;
+
+            MIXME_CONSTEXPR20 void clear_edits();
+
+            template <typename P = Storage_policy>
+            static MIXME_CONSTEXPR20 auto clear_history(typename P::data_type& data,
+            		typename P::bookkeeping_type& bkp,
+					int) -> decltype(P::clear(data, bkp))
+            {
+            	return P::clear(data, bkp);
+            }
+
+            /// Policies without clear take an empty history when moved into
+            template <typename P = Storage_policy>
+            static MIXME_CONSTEXPR20 void clear_history(typename P::data_type& data, typename P::bookkeeping_type& bkp, long)
+            {
+            	typename P::data_type empty_data;
+            	typename P::bookkeeping_type empty_bkp = typename P::bookkeeping_type();
+            	P::move_assign(std::move(empty_data), std::move(empty_bkp), data, bkp);
+            }
+
+            MIXME_NO_UNIQUE_ADDRESS typename Storage_policy::data_type redo_data_;
+            typename Storage_policy::bookkeeping_type redo_bkp_ = typename Storage_policy::bookkeeping_type();
         };
 
     	/**
-    	 * Storage consisting in a single element buffer
+    	 * Storage consisting in a single element buffer.
+    	 * Trivially copyable elements are moved around as raw bytes, except in constant expressions.
+    	 * So are trivially relocatable ones when moved, without running their destructor
     	 */
         template <typename T>
     	struct single_element_storage
 		{
 		protected:
-        	using data_type = unsigned char [sizeof(T)];
+        	using data_type = detail::element_slot<T>;
         	using bookkeeping_type = bool;
 
-        	static bool has_data(bookkeeping_type bkp) { return bkp; }
+        	static constexpr bool has_data(bookkeeping_type bkp) { return bkp; }
 
-        	static std::size_t max_size(bookkeeping_type bkp) { return 1; }
+        	static constexpr std::size_t max_size(bookkeeping_type bkp) { return 1; }
 
-        	static std::size_t size(bookkeeping_type bkp) { return (bkp) ? 1 : 0; }
+        	static constexpr std::size_t size(bookkeeping_type bkp) { return (bkp) ? 1 : 0; }
 
-        	static void copy_construct(const data_type& src,
+        	static MIXME_CONSTEXPR20 void copy_construct(const data_type& src,
         			const bookkeeping_type& src_bkp,
         			data_type& dst,
 					bookkeeping_type& dst_bkp) noexcept(std::is_nothrow_copy_constructible<T>::value);
 
-        	static void move_construct(data_type&& src,
+        	static MIXME_CONSTEXPR20 void move_construct(data_type&& src,
         			bookkeeping_type&& src_bkp,
         			data_type& dst,
 					bookkeeping_type& dst_bkp) noexcept(std::is_nothrow_move_constructible<T>::value);
 
-        	static void copy_assign(const data_type& src,
+        	static MIXME_CONSTEXPR20 void copy_assign(const data_type& src,
         			const bookkeeping_type& src_bkp,
         			data_type& dst,
 					bookkeeping_type& dst_bkp)
         	noexcept(std::is_nothrow_copy_constructible<T>::value && std::is_nothrow_copy_assignable<T>::value);
 
-        	static void move_assign(data_type&& src,
+        	static MIXME_CONSTEXPR20 void move_assign(data_type&& src,
         			bookkeeping_type&& src_bkp,
         			data_type& dst,
 					bookkeeping_type& dst_bkp)
         	noexcept(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value);
 
-        	static void dispose(data_type&, bookkeeping_type) noexcept;
+        	static MIXME_CONSTEXPR20 void dispose(data_type&, bookkeeping_type) noexcept;
 
-        	static void store(T&, data_type&, bookkeeping_type&);
+        	static MIXME_CONSTEXPR20 void store(T&, data_type&, bookkeeping_type&);
 
-        	static void restore(T&, data_type&, bookkeeping_type&);
+        	static MIXME_CONSTEXPR20 void restore(T&, data_type&, bookkeeping_type&) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+        	/// Stores the value in to and restores the element of from, moving it instead of copying it
+        	static MIXME_CONSTEXPR20 void exchange(T&, data_type& from, bookkeeping_type& from_bkp, data_type& to, bookkeeping_type& to_bkp);
+
+        	/// Drops every stored element
+        	static MIXME_CONSTEXPR20 void clear(data_type& data, bookkeeping_type& bkp) noexcept
+        	{
+        		dispose(data, bkp);
+        		bkp = false;
+        	}
+
+        	/// Stores the value moving it instead of copying it, for callers about to overwrite it
+        	static MIXME_CONSTEXPR20 void move_store(T&, data_type&, bookkeeping_type&)
+        	noexcept(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value);
 		};
 
 		/**
-		 * Storage consisting in an underlying array
+		 * Storage consisting in an underlying array.
+		 * Copies of trivially copyable elements only touch the stored elements, as raw bytes.
+		 * Moves of trivially relocatable elements exchange their bytes instead of calling T's move assignment
 		 */
 		template <typename T, std::size_t N>
 		struct array_storage
@@ -200,42 +489,186 @@ namespace mixme
 			using data_type = std::array<T, N>;
 			using bookkeeping_type = std::size_t;
 
-			static bool has_data(bookkeeping_type bkp) { return bkp > 0; }
+			static constexpr bool has_data(bookkeeping_type bkp) { return bkp > 0; }
 
-			static std::size_t max_size(bookkeeping_type bkp) { return N; }
+			static constexpr std::size_t max_size(bookkeeping_type bkp) { return N; }
 
-			static std::size_t size(bookkeeping_type bkp) { return bkp; }
+			static constexpr std::size_t size(bookkeeping_type bkp) { return bkp; }
 
-        	static void copy_construct(const data_type& src,
+        	static MIXME_CONSTEXPR20 void copy_construct(const data_type& src,
         			const bookkeeping_type& src_bkp,
         			data_type& dst,
 					bookkeeping_type& dst_bkp)
         	noexcept(std::is_nothrow_copy_assignable<T>::value);
 
-        	static void move_construct(data_type&& src,
+        	static MIXME_CONSTEXPR20 void move_construct(data_type&& src,
         			bookkeeping_type&& src_bkp,
         			data_type& dst,
 					bookkeeping_type& dst_bkp)
         	noexcept(std::is_nothrow_move_assignable<T>::value);
 
-        	static void copy_assign(const data_type& src,
+        	static MIXME_CONSTEXPR20 void copy_assign(const data_type& src,
         			const bookkeeping_type& src_bkp,
         			data_type& dst,
 					bookkeeping_type& dst_bkp)
         	noexcept(std::is_nothrow_copy_assignable<T>::value);
 
-        	static void move_assign(data_type&& src,
+        	static MIXME_CONSTEXPR20 void move_assign(data_type&& src,
         			bookkeeping_type&& src_bkp,
         			data_type& dst,
 					bookkeeping_type& dst_bkp)
         	noexcept(std::is_nothrow_move_assignable<T>::value);
 
+        	static MIXME_CONSTEXPR20 void dispose(data_type&, bookkeeping_type) noexcept {}
+
+			static MIXME_CONSTEXPR20 void store(T&, data_type&, bookkeeping_type&);
+
+			static MIXME_CONSTEXPR20 void restore(T&, data_type&, bookkeeping_type&) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+			static MIXME_CONSTEXPR20 void exchange(T&, data_type& from, bookkeeping_type& from_bkp, data_type& to, bookkeeping_type& to_bkp);
+
+			static MIXME_CONSTEXPR20 void move_store(T&, data_type&, bookkeeping_type&) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+			/// Releases the resources of the stored elements only, the others are already moved from
+			static MIXME_CONSTEXPR20 void clear(data_type&, bookkeeping_type&);
+		};
+
+		/**
+		 * Storage consisting in an underlying circular buffer.
+		 * When full, storing a new element evicts the oldest one in constant time.
+		 * Copies of trivially copyable elements only touch the stored elements, as raw bytes.
+		 * Moves of trivially relocatable elements exchange their bytes instead of calling T's move assignment
+		 */
+		template <typename T, std::size_t N>
+		struct ring_storage
+		{
+			static_assert(N > 0, "ring_storage must be able to hold at least one element");
+		protected:
+			using data_type = std::array<T, N>;
+
+			struct bookkeeping_type
+			{
+				std::size_t first = 0; // index of the oldest element
+				std::size_t count = 0;
+			};
+
+			static constexpr bool has_data(bookkeeping_type bkp) { return bkp.count > 0; }
+
+			static constexpr std::size_t max_size(bookkeeping_type bkp) { return N; }
+
+			static constexpr std::size_t size(bookkeeping_type bkp) { return bkp.count; }
+
+        	static MIXME_CONSTEXPR20 void copy_construct(const data_type& src,
+        			const bookkeeping_type& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp)
+        	noexcept(std::is_nothrow_copy_assignable<T>::value);
+
+        	static MIXME_CONSTEXPR20 void move_construct(data_type&& src,
+        			bookkeeping_type&& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp)
+        	noexcept(std::is_nothrow_move_assignable<T>::value);
+
+        	static MIXME_CONSTEXPR20 void copy_assign(const data_type& src,
+        			const bookkeeping_type& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp)
+        	noexcept(std::is_nothrow_copy_assignable<T>::value);
+
+        	static MIXME_CONSTEXPR20 void move_assign(data_type&& src,
+        			bookkeeping_type&& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp)
+        	noexcept(std::is_nothrow_move_assignable<T>::value);
+
+        	static MIXME_CONSTEXPR20 void dispose(data_type&, bookkeeping_type) noexcept {}
+
+			static MIXME_CONSTEXPR20 void store(T&, data_type&, bookkeeping_type&);
+
+			static MIXME_CONSTEXPR20 void restore(T&, data_type&, bookkeeping_type&) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+			static MIXME_CONSTEXPR20 void exchange(T&, data_type& from, bookkeeping_type& from_bkp, data_type& to, bookkeeping_type& to_bkp);
+
+			static MIXME_CONSTEXPR20 void move_store(T&, data_type&, bookkeeping_type&) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+			static MIXME_CONSTEXPR20 void clear(data_type&, bookkeeping_type&);
+		private:
+			static constexpr std::size_t slot(std::size_t i) noexcept { return (i >= N) ? i - N : i; }
+		};
+
+		/**
+		 * Storage consisting in an underlying vector, growing on demand.
+		 * Memory is obtained from Alloc, which is propagated as a standard allocator-aware container would do
+		 */
+		template <typename T, typename Alloc = std::allocator<T>>
+		struct vector_storage
+		{
+		protected:
+			using data_type = std::vector<T, Alloc>;
+			using bookkeeping_type = std::size_t;
+
+			static bool has_data(bookkeeping_type bkp) { return bkp > 0; }
+
+			static std::size_t max_size(bookkeeping_type bkp) { return std::numeric_limits<std::size_t>::max(); }
+
+			static std::size_t size(bookkeeping_type bkp) { return bkp; }
+
+        	static void copy_construct(const data_type& src,
+        			const bookkeeping_type& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp);
+
+        	static void move_construct(data_type&& src,
+        			bookkeeping_type&& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp) noexcept;
+
+        	static void copy_assign(const data_type& src,
+        			const bookkeeping_type& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp);
+
+        	static void move_assign(data_type&& src,
+        			bookkeeping_type&& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp)
+        	noexcept(std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+        			std::allocator_traits<Alloc>::is_always_equal::value);
+
         	static void dispose(data_type&, bookkeeping_type) noexcept {}
 
 			static void store(T&, data_type&, bookkeeping_type&);
 
-			static void restore(T&, data_type&, bookkeeping_type&);
+			static void restore(T&, data_type&, bookkeeping_type&) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+			static void exchange(T&, data_type& from, bookkeeping_type& from_bkp, data_type& to, bookkeeping_type& to_bkp);
+
+			/// Only allocates if the capacity released by a previous restore is gone
+			static void move_store(T&, data_type&, bookkeeping_type&);
+
+			/// Keeps the capacity for the states stored next
+			static void clear(data_type& data, bookkeeping_type& bkp) noexcept
+			{
+				data.clear();
+				bkp = 0;
+			}
+
+			static void reserve(data_type& data, bookkeeping_type, std::size_t n) { data.reserve(n); }
+
+			static void shrink_to_fit(data_type& data, bookkeeping_type) { data.shrink_to_fit(); }
 		};
+
+#ifdef MIXME_HAS_MEMORY_RESOURCE
+		namespace pmr
+		{
+			/**
+			 * vector_storage drawing memory from a std::pmr::memory_resource
+			 */
+			template <typename T>
+			using vector_storage = wrap::vector_storage<T, std::pmr::polymorphic_allocator<T>>;
+		}
+#endif
     }
 }
 
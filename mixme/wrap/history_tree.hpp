@@ -0,0 +1,215 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_HISTORY_TREE_HPP_
+#define MIXME_WRAP_HISTORY_TREE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	/**
+    	 * Pruning policy of history_tree keeping every state
+    	 */
+    	struct unbounded_tree
+		{
+    		static constexpr bool over(std::size_t nodes) noexcept { return false; }
+		};
+
+    	/**
+    	 * Pruning policy of history_tree keeping at most N states, dropping the least recently visited
+    	 * branches first, then the oldest states of the current one
+    	 */
+    	template <std::size_t N>
+    	struct max_nodes
+		{
+    		static_assert(N > 0, "max_nodes must keep at least one node");
+
+    		static constexpr bool over(std::size_t nodes) noexcept { return nodes > N; }
+		};
+
+    	/**
+    	 * Wraps a class keeping every saved state in a tree, so that undoing and then saving starts a new
+    	 * branch instead of discarding the states that were undone.
+    	 *
+    	 * States are immutable and shared between the tree and the current value until the value is
+    	 * modified through mutable access, which copies it. Moving around the tree copies no value.
+    	 * Mutable access (non-const operator->, operator* and value()) must be assumed to modify the value.
+    	 *
+    	 * Pruning_policy provides a static over(std::size_t nodes), true when the tree must drop nodes.
+    	 */
+        template <typename T, typename Pruning_policy = unbounded_tree>
+        class history_tree
+        {
+        public:
+            using value_type = T;
+
+            /** Identifies a state, unique within a tree */
+            using node_id = std::uint64_t;
+
+            static constexpr node_id no_node = std::numeric_limits<node_id>::max();
+
+            history_tree() : history_tree(std::piecewise_construct) {}
+
+            history_tree(const history_tree& other);
+
+            history_tree(history_tree&&) = default;
+
+            template <typename U, typename std::enable_if_t<!std::is_same<history_tree, std::decay_t<U>>::value>* = nullptr>
+            history_tree(U&& value) : history_tree(std::piecewise_construct, std::forward<U>(value)) {}
+
+            template <typename... Args, typename std::enable_if_t<(sizeof...(Args) > 1)>* = nullptr>
+            history_tree(Args&&... args) : history_tree(std::piecewise_construct, std::forward<Args>(args)...) {}
+
+            history_tree& operator=(const history_tree& other);
+
+            history_tree& operator=(history_tree&&) = default;
+
+            template <typename U, typename std::enable_if_t<!std::is_same<history_tree, std::decay_t<U>>::value>* = nullptr>
+            history_tree& operator=(U&& value);
+
+            T* operator->() { return &value(); }
+
+            const T* operator->() const noexcept { return &value(); }
+
+            T& operator*() & { return value(); }
+
+            const T& operator*() const & noexcept { return value(); }
+
+            /**
+             * Gives mutable access to the value, copying it first if it's shared with a state of the tree
+             */
+            T& value();
+
+            const T& value() const noexcept { return *value_; }
+
+            /**
+             * @returns Whether the value may have been modified since it was saved or restored
+             */
+            bool dirty() const noexcept { return dirty_; }
+
+            /**
+             * Saves the value as a child of the current state, unless it's not dirty. Without copies.
+             *
+             * @returns The id of the current state
+             */
+            node_id save();
+
+            /**
+             * Moves to the parent of the current state, saving the value first if dirty
+             *
+             * @returns False if there's no parent
+             */
+            bool undo();
+
+            /**
+             * Moves to the most recently visited child of the current state, saving the value first if dirty
+             *
+             * @returns False if there's no child
+             */
+            bool redo();
+
+            /**
+             * Moves to the branch-th child of the current state, in creation order, saving the value first if dirty
+             *
+             * @returns False if there's no such child
+             */
+            bool redo(std::size_t branch);
+
+            /**
+             * Moves to a state, saving the value first if dirty
+             *
+             * @returns False if there's no such state, as it was pruned
+             */
+            bool go_to(node_id id);
+
+            /**
+             * @returns The id of the current state, the value was saved in or restored from
+             */
+            node_id current() const noexcept { return current_; }
+
+            /**
+             * @returns The id of the first state of the tree
+             */
+            node_id root() const noexcept { return root_; }
+
+            /**
+             * @returns The parent of a state, or no_node
+             */
+            node_id parent(node_id id) const;
+
+            /**
+             * @returns The children of a state, in creation order
+             */
+            const std::vector<node_id>& children(node_id id) const;
+
+            /**
+             * @returns Whether the tree holds a state
+             */
+            bool contains(node_id id) const { return nodes_.count(id) != 0; }
+
+            /**
+             * @returns A state of the tree
+             */
+            const T& state(node_id id) const { return *nodes_.at(id).value; }
+
+            /**
+             * @returns The number of states in the tree
+             */
+            std::size_t size() const noexcept { return nodes_.size(); }
+        private:
+            /** The nodes without children, by when they were last current: the least recently visited come first */
+            using leaf_map = std::map<std::uint64_t, node_id>;
+
+            struct node
+			{
+            	std::shared_ptr<const T> value;
+            	node_id parent;
+            	std::vector<node_id> children;
+            	node_id last_child; // the child visited last, where redo goes
+            	std::uint64_t visited; // when the node was last current
+            	typename leaf_map::iterator leaf; // valid while children is empty
+			};
+
+            template <typename... Args>
+            explicit history_tree(std::piecewise_construct_t, Args&&... args);
+
+            void move_to(node_id id);
+
+            void prune();
+
+            std::unordered_map<node_id, node> nodes_;
+            leaf_map leaves_;
+            std::shared_ptr<T> value_; // shared with the current node unless dirty
+            node_id current_ = 0;
+            node_id root_ = 0;
+            node_id next_id_ = 1;
+            std::uint64_t clock_ = 0;
+            bool dirty_ = false;
+        };
+    }
+}
+
+#include <mixme/wrap/impl/history_tree.tpp>
+
+#endif
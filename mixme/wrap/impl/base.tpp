@@ -18,32 +18,68 @@ namespace mixme
     namespace wrap
     {
     	template <typename T>
-        base<T>& base<T>::operator=(const base& other)
+        MIXME_CONSTEXPR20 base<T>& base<T>::operator=(const base& other)
         { 
         	value_ = other.value_;
         	return *this;
         }
         
         template <typename T>
-        base<T>& base<T>::operator=(base&& other) noexcept(std::is_nothrow_move_assignable<T>::value)
+        MIXME_CONSTEXPR20 base<T>& base<T>::operator=(base&& other) noexcept(std::is_nothrow_move_assignable<T>::value)
         { 
         	value_ = std::move(other.value_);
         	return *this;
         }
         
         template <typename T>
+#ifdef MIXME_HAS_CONCEPTS
+        template <typename U>
+        requires (!std::is_base_of_v<base<T>, std::decay_t<U>>)
+#else
         template <typename U, typename std::enable_if_t<!std::is_base_of<base<T>, std::decay_t<U>>::value>*>
-        base<T>& base<T>::operator=(U&& other) 
+#endif
+        MIXME_CONSTEXPR20 base<T>& base<T>::operator=(U&& other) 
         { 
         	value_ = std::forward<U>(other);
         	return *this;
         }    
         
+        namespace detail
+        {
+#ifdef MIXME_HAS_IF_CONSTEXPR
+        	template <typename T>
+        	void swap_values(T& lhs, T& rhs) noexcept(mixme::detail::relocates_bytes<T>::value)
+        	{
+        		if constexpr (mixme::detail::relocates_bytes<T>::value)
+        		{
+        			mixme::detail::swap_bytes(lhs, rhs);
+        		}
+        		else
+        		{
+        			using std::swap;
+        			swap(lhs, rhs);
+        		}
+        	}
+#else
+        	template <typename T, typename std::enable_if_t<mixme::detail::relocates_bytes<T>::value>* = nullptr>
+        	void swap_values(T& lhs, T& rhs) noexcept
+        	{
+        		mixme::detail::swap_bytes(lhs, rhs);
+        	}
+
+        	template <typename T, typename std::enable_if_t<!mixme::detail::relocates_bytes<T>::value>* = nullptr>
+        	void swap_values(T& lhs, T& rhs)
+        	{
+        		using std::swap;
+        		swap(lhs, rhs);
+        	}
+#endif
+        }
+
         template <typename T>
         void swap(base<T>& lhs, base<T>& rhs)
         {
-        	using std::swap;
-        	swap(lhs.value(), rhs.value());
+        	detail::swap_values(lhs.value(), rhs.value());
         }        
     }
 }
@@ -0,0 +1,66 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_BOXED_TPP_
+#define MIXME_WRAP_BOXED_TPP_
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	namespace detail
+		{
+    		template <typename T>
+    		box_storage<T, false>& box_storage<T, false>::operator=(const box_storage& other)
+			{
+    			if (!other.value)
+    			{
+    				delete value;
+    				value = nullptr;
+    			}
+    			else
+    			{
+    				assign(*other.value);
+    			}
+    			return *this;
+			}
+
+    		template <typename T>
+    		template <typename U>
+    		void box_storage<T, false>::assign(U&& other)
+			{
+    			if (value)
+    			{
+    				// Reuse the allocation
+    				*value = std::forward<U>(other);
+    			}
+    			else
+    			{
+    				value = new T(std::forward<U>(other));
+    			}
+			}
+		}
+
+        template <typename T, std::size_t Inline_size>
+        constexpr bool boxed<T, Inline_size>::is_inline;
+
+        template <typename T, std::size_t Inline_size>
+        template <typename U, typename std::enable_if_t<!std::is_base_of<boxed<T, Inline_size>, std::decay_t<U>>::value>*>
+        boxed<T, Inline_size>& boxed<T, Inline_size>::operator=(U&& value)
+        {
+        	storage_.assign(std::forward<U>(value));
+        	return *this;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,106 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_BUDGET_STORAGE_TPP_
+#define MIXME_WRAP_BUDGET_STORAGE_TPP_
+
+#include <utility>
+#include <mixme/wrap/history.hpp>
+
+namespace mixme
+{
+    namespace wrap
+    {
+        template <typename T, std::size_t Budget>
+    	void budget_storage<T, Budget>::copy_construct(const data_type& src,
+    			const bookkeeping_type& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp)
+        {
+        	dst = src;
+        	dst_bkp = src_bkp;
+        }
+
+        template <typename T, std::size_t Budget>
+    	void budget_storage<T, Budget>::move_construct(data_type&& src,
+    			bookkeeping_type&& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp) noexcept
+    	{
+        	dst = std::move(src);
+        	dst_bkp = src_bkp;
+        	clear(src, src_bkp);
+    	}
+
+        template <typename T, std::size_t Budget>
+    	void budget_storage<T, Budget>::copy_assign(const data_type& src,
+    			const bookkeeping_type& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp)
+        {
+        	copy_construct(src, src_bkp, dst, dst_bkp);
+        }
+
+        template <typename T, std::size_t Budget>
+    	void budget_storage<T, Budget>::move_assign(data_type&& src,
+    			bookkeeping_type&& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp) noexcept
+    	{
+        	move_construct(std::move(src), std::move(src_bkp), dst, dst_bkp);
+    	}
+
+        template <typename T, std::size_t Budget>
+        void budget_storage<T, Budget>::set_bytes_budget(data_type& data, bookkeeping_type& bkp, std::size_t bytes)
+        {
+        	bkp.budget = bytes;
+        	while (bkp.bytes > bkp.budget && bkp.count > 1)
+        	{
+        		bkp.bytes -= data.front().bytes;
+        		bkp.count--;
+        		data.pop_front();
+        	}
+        }
+
+        template <typename T, std::size_t Budget>
+        void budget_storage<T, Budget>::store(T& value, data_type& data, bookkeeping_type& bkp)
+        {
+        	evict(data, bkp, footprint(value));
+        	data.emplace_back(detail::copy_or_move_ref(value));
+        	bkp.count++;
+        	bkp.bytes += data.back().bytes;
+        }
+
+        template <typename T, std::size_t Budget>
+        void budget_storage<T, Budget>::restore(T& value, data_type& data, bookkeeping_type& bkp)
+        noexcept(std::is_nothrow_move_assignable<T>::value)
+        {
+        	value = std::move(data.back().value);
+        	bkp.bytes -= data.back().bytes;
+        	bkp.count--;
+        	data.pop_back();
+        }
+
+        template <typename T, std::size_t Budget>
+        void budget_storage<T, Budget>::evict(data_type& data, bookkeeping_type& bkp, std::size_t bytes) noexcept
+        {
+        	while (bkp.count > 0 && bkp.bytes + bytes > bkp.budget)
+        	{
+        		bkp.bytes -= data.front().bytes;
+        		bkp.count--;
+        		data.pop_front();
+        	}
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,369 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_CHECKPOINT_TPP_
+#define MIXME_WRAP_CHECKPOINT_TPP_
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	namespace detail
+		{
+    		template <typename W>
+    		struct checkpoint_traits;
+
+    		template <typename T, typename Storage_policy, typename Instrumentation>
+    		struct checkpoint_traits<undoable<T, Storage_policy, Instrumentation>>
+			{
+    			using value_type = T;
+    			using storage_policy = Storage_policy;
+    			using instrumentation = Instrumentation;
+			};
+
+    		template <typename T, typename Storage_policy, typename Instrumentation>
+    		struct checkpoint_traits<redoable<T, Storage_policy, Instrumentation>>
+			{
+    			using value_type = T;
+    			using storage_policy = Storage_policy;
+    			using instrumentation = Instrumentation;
+			};
+
+    		template <typename W>
+    		struct checkpoint_batch
+			{
+    			using value_type = typename checkpoint_traits<W>::value_type;
+    			using storage_policy = typename checkpoint_traits<W>::storage_policy;
+    			using instrumentation = typename checkpoint_traits<W>::instrumentation;
+    			using undoable_type = undoable<value_type, storage_policy, instrumentation>;
+    			using redoable_type = redoable<value_type, storage_policy, instrumentation>;
+
+    			static_assert(std::is_copy_constructible<value_type>::value,
+    					"checkpoint_group requires copyable values to back up full histories");
+
+    			struct journal
+				{
+    				std::vector<std::pair<std::size_t, W>> wrappers; // backups, by increasing index
+    				std::vector<value_type> values; // values dropped by the action, by increasing index
+				};
+
+    			static const checkpoint_ops ops;
+
+    			static W& at(void* const* objects, std::size_t i) { return *static_cast<W*>(objects[i]); }
+
+    			static bool has_edit(const undoable_type&) { return false; }
+
+    			static bool has_edit(const redoable_type& object) { return object.has_edit(); }
+
+    			static bool edits_full(const undoable_type&) { return false; }
+
+    			static bool edits_full(const redoable_type& object) { return object.edits() == object.max_edits(); }
+
+    			static void redo(undoable_type&) {}
+
+    			static void redo(redoable_type& object) { object.redo(); }
+
+    			// Whether the inverse actions move values back into the history slots just released, never copying them
+    			static constexpr bool moves_back = undoable_type::moves_stores(0);
+
+    			// Whether the inverse actions restoring a state can't throw
+    			static constexpr bool restores_back = undoable_type::nothrow_restore;
+
+    			// Reverts an undo, moving the value back to the saves and, for a redoable, the edit back to the value
+    			static void unundo(undoable_type& object) noexcept
+    			{
+    				undoable_type::give(object.value(), object.undo_data_, object.undo_bkp_, 0);
+    			}
+
+    			static void unundo(redoable_type& object) noexcept
+    			{
+    				undoable_type& base = object;
+    				undoable_type::give(object.value(), base.undo_data_, base.undo_bkp_, 0);
+    				redoable_type::restore(object.value(), object.redo_data_, object.redo_bkp_);
+    			}
+
+    			static void unredo(undoable_type&) noexcept {}
+
+    			static void unredo(redoable_type& object) noexcept
+    			{
+    				undoable_type::give(object.value(), object.redo_data_, object.redo_bkp_, 0);
+    			}
+
+    			// An undoable loses its value when undoing, a redoable when redoing
+    			static bool drops_value(checkpoint_action action)
+    			{
+    				return action == checkpoint_action::redo
+    						|| (action == checkpoint_action::undo && !std::is_same<W, redoable_type>::value);
+    			}
+
+    			// Whether only a backup can revert the action: it drops a state from a full history,
+    			// or reverting it could throw, copying the value or restoring a state
+    			static bool drops_state(checkpoint_action action, const W& object)
+    			{
+    				switch (action)
+    				{
+    				// Saving also drops the edits of a redoable
+    				case checkpoint_action::save: return !restores_back || object.saves() == object.max_saves() || has_edit(object);
+    				case checkpoint_action::undo: return !moves_back || !restores_back || edits_full(object);
+    				default: return !moves_back;
+    				}
+    			}
+
+    			static bool ready(checkpoint_action action, void* const* objects, std::size_t count)
+    			{
+    				for (std::size_t i = 0; i < count; ++i)
+    				{
+    					const W& object = at(objects, i);
+    					if ((action == checkpoint_action::undo && !object.has_save())
+    							|| (action == checkpoint_action::redo && !has_edit(object)))
+    					{
+    						return false;
+    					}
+    				}
+    				return true;
+    			}
+
+    			static void* apply(checkpoint_action action, void* const* objects, std::size_t count, bool& kept)
+    			{
+    				std::unique_ptr<journal> log;
+    				if (drops_value(action))
+    				{
+    					log.reset(new journal());
+    					log->values.reserve(count);
+    				}
+    				std::size_t i = 0;
+    				try
+    				{
+    					for (; i < count; ++i)
+    					{
+    						W& object = at(objects, i);
+    						if (drops_state(action, object))
+    						{
+    							if (!log)
+    							{
+    								log.reset(new journal());
+    							}
+    							log->wrappers.emplace_back(i, object);
+    						}
+    						if (drops_value(action))
+    						{
+    							// Reserved, can't throw
+    							log->values.push_back(std::move(object.value()));
+    						}
+    						switch (action)
+    						{
+    						case checkpoint_action::save: kept = object.save() && kept; break;
+    						case checkpoint_action::undo: object.undo(); break;
+    						case checkpoint_action::redo: redo(object); break;
+    						}
+    					}
+    				}
+    				catch (...)
+    				{
+    					// The failed wrapper gets back what was taken from it, then the previous ones are reverted
+    					if (log && !log->wrappers.empty() && log->wrappers.back().first == i)
+    					{
+    						at(objects, i) = std::move(log->wrappers.back().second);
+    						log->wrappers.pop_back();
+    					}
+    					if (log && log->values.size() > i)
+    					{
+    						at(objects, i).value() = std::move(log->values.back());
+    						log->values.pop_back();
+    					}
+    					revert(action, objects, i, log.release());
+    					throw;
+    				}
+    				return log.release();
+    			}
+
+    			static void revert(checkpoint_action action, void* const* objects, std::size_t count, void* data) noexcept
+    			{
+    				std::unique_ptr<journal> log(static_cast<journal*>(data));
+    				for (std::size_t i = count; i-- > 0;)
+    				{
+    					W& object = at(objects, i);
+    					if (log && !log->wrappers.empty() && log->wrappers.back().first == i)
+    					{
+    						object = std::move(log->wrappers.back().second);
+    						log->wrappers.pop_back();
+    						if (drops_value(action))
+    						{
+    							log->values.pop_back();
+    						}
+    						continue;
+    					}
+    					switch (action)
+    					{
+    					case checkpoint_action::save:
+    					{
+    						undoable_type& base = object;
+    						undoable_type::restore(object.value(), base.undo_data_, base.undo_bkp_);
+    						break;
+    					}
+    					case checkpoint_action::undo:
+    						unundo(object);
+    						break;
+    					case checkpoint_action::redo:
+    						unredo(object);
+    						break;
+    					}
+    					if (drops_value(action))
+    					{
+    						object.value() = std::move(log->values.back());
+    						log->values.pop_back();
+    					}
+    				}
+    			}
+
+    			static void release(void* data) noexcept
+    			{
+    				delete static_cast<journal*>(data);
+    			}
+			};
+
+    		template <typename W>
+    		const checkpoint_ops checkpoint_batch<W>::ops = {
+    				&checkpoint_batch<W>::ready,
+					&checkpoint_batch<W>::apply,
+					&checkpoint_batch<W>::revert,
+					&checkpoint_batch<W>::release
+    		};
+		}
+
+    	template <typename W>
+    	void checkpoint_group::insert(W& object)
+    	{
+    		const detail::checkpoint_ops* ops = &detail::checkpoint_batch<W>::ops;
+    		auto found = std::find_if(batches_.begin(), batches_.end(), [ops](const batch& b) { return b.ops == ops; });
+    		if (found == batches_.end())
+    		{
+    			batches_.push_back(batch{ops, {&object}});
+    		}
+    		else
+    		{
+    			found->objects.push_back(&object);
+    		}
+    	}
+
+    	template <typename W>
+    	bool checkpoint_group::erase(W& object)
+    	{
+    		const detail::checkpoint_ops* ops = &detail::checkpoint_batch<W>::ops;
+    		auto found = std::find_if(batches_.begin(), batches_.end(), [ops](const batch& b) { return b.ops == ops; });
+    		if (found == batches_.end())
+    		{
+    			return false;
+    		}
+    		auto position = std::find(found->objects.begin(), found->objects.end(), &object);
+    		if (position == found->objects.end())
+    		{
+    			return false;
+    		}
+    		found->objects.erase(position);
+    		if (found->objects.empty())
+    		{
+    			batches_.erase(found);
+    		}
+    		return true;
+    	}
+
+    	template <typename T, typename Storage_policy, typename Instrumentation>
+    	void checkpoint_group::add(undoable<T, Storage_policy, Instrumentation>& object)
+    	{
+    		insert(object);
+    	}
+
+    	template <typename T, typename Storage_policy, typename Instrumentation>
+    	void checkpoint_group::add(redoable<T, Storage_policy, Instrumentation>& object)
+    	{
+    		insert(object);
+    	}
+
+    	template <typename T, typename Storage_policy, typename Instrumentation>
+    	bool checkpoint_group::remove(undoable<T, Storage_policy, Instrumentation>& object)
+    	{
+    		return erase(object);
+    	}
+
+    	template <typename T, typename Storage_policy, typename Instrumentation>
+    	bool checkpoint_group::remove(redoable<T, Storage_policy, Instrumentation>& object)
+    	{
+    		return erase(object);
+    	}
+
+    	inline std::size_t checkpoint_group::size() const noexcept
+    	{
+    		std::size_t count = 0;
+    		for (const batch& b : batches_)
+    		{
+    			count += b.objects.size();
+    		}
+    		return count;
+    	}
+
+    	inline bool checkpoint_group::save_all()
+    	{
+    		return run(detail::checkpoint_action::save);
+    	}
+
+    	inline bool checkpoint_group::undo_all()
+    	{
+    		return run(detail::checkpoint_action::undo);
+    	}
+
+    	inline bool checkpoint_group::redo_all()
+    	{
+    		return run(detail::checkpoint_action::redo);
+    	}
+
+    	inline bool checkpoint_group::run(detail::checkpoint_action action)
+    	{
+    		for (const batch& b : batches_)
+    		{
+    			if (!b.ops->ready(action, b.objects.data(), b.objects.size()))
+    			{
+    				return false;
+    			}
+    		}
+    		std::vector<void*> journals;
+    		journals.reserve(batches_.size());
+    		bool kept = true;
+    		try
+    		{
+    			for (const batch& b : batches_)
+    			{
+    				journals.push_back(b.ops->apply(action, b.objects.data(), b.objects.size(), kept));
+    			}
+    		}
+    		catch (...)
+    		{
+    			for (std::size_t k = journals.size(); k-- > 0;)
+    			{
+    				batches_[k].ops->revert(action, batches_[k].objects.data(), batches_[k].objects.size(), journals[k]);
+    			}
+    			throw;
+    		}
+    		for (std::size_t k = 0; k < journals.size(); ++k)
+    		{
+    			batches_[k].ops->release(journals[k]);
+    		}
+    		return kept;
+    	}
+    }
+}
+
+#endif
@@ -0,0 +1,249 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_CONCURRENT_TPP_
+#define MIXME_WRAP_CONCURRENT_TPP_
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace mixme
+{
+    namespace wrap
+    {
+        template <typename T, std::size_t Readers>
+        concurrent_redoable<T, Readers>::snapshot::~snapshot()
+        {
+        	if (slot_)
+        	{
+        		slot_->epoch.store(0, std::memory_order_release);
+        	}
+        }
+
+        template <typename T, std::size_t Readers>
+        typename concurrent_redoable<T, Readers>::snapshot&
+		concurrent_redoable<T, Readers>::snapshot::operator=(snapshot&& other) noexcept
+        {
+        	if (this != &other)
+        	{
+        		if (slot_)
+        		{
+        			slot_->epoch.store(0, std::memory_order_release);
+        		}
+        		slot_ = other.slot_;
+        		state_ = other.state_;
+        		other.slot_ = nullptr;
+        	}
+        	return *this;
+        }
+
+        template <typename T, std::size_t Readers>
+        template <typename... Args>
+        concurrent_redoable<T, Readers>::concurrent_redoable(std::piecewise_construct_t, Args&&... args)
+        {
+        	std::unique_ptr<value_node> value(new value_node(std::forward<Args>(args)...));
+        	state_.store(new state_type{value.get(), nullptr, nullptr});
+        	value.release();
+        }
+
+        template <typename T, std::size_t Readers>
+        concurrent_redoable<T, Readers>::~concurrent_redoable()
+        {
+        	release(current());
+        	for (const retired_state& old : retired_)
+        	{
+        		release(old.state);
+        	}
+        }
+
+        template <typename T, std::size_t Readers>
+        typename concurrent_redoable<T, Readers>::snapshot concurrent_redoable<T, Readers>::read() const
+        {
+        	// Threads start probing from different slots, to spread the contention
+        	const std::size_t start = std::hash<std::thread::id>()(std::this_thread::get_id());
+        	for (;;)
+        	{
+        		for (std::size_t n = 0; n < Readers; ++n)
+        		{
+        			detail::mvcc_slot& slot = slots_[(start + n) % Readers];
+        			std::uint64_t expected = 0;
+        			// Pinning the slot before loading the state keeps the writer from freeing what's loaded
+        			if (slot.epoch.load(std::memory_order_relaxed) == 0
+        					&& slot.epoch.compare_exchange_strong(expected, epoch_.load()))
+        			{
+        				return snapshot(&slot, state_.load());
+        			}
+        		}
+        		std::this_thread::yield();
+        	}
+        }
+
+        template <typename T, std::size_t Readers>
+        template <typename U>
+        void concurrent_redoable<T, Readers>::set(U&& value)
+        {
+        	value_node* node = new value_node(std::forward<U>(value));
+        	state_type* state = current();
+        	acquire(state->undo);
+        	acquire(state->redo);
+        	publish(node, state->undo, state->redo);
+        }
+
+        template <typename T, std::size_t Readers>
+        template <typename F>
+        void concurrent_redoable<T, Readers>::modify(F&& f)
+        {
+        	std::unique_ptr<value_node> node(new value_node(value()));
+        	std::forward<F>(f)(node->value);
+        	state_type* state = current();
+        	acquire(state->undo);
+        	acquire(state->redo);
+        	publish(node.release(), state->undo, state->redo);
+        }
+
+        template <typename T, std::size_t Readers>
+        bool concurrent_redoable<T, Readers>::save()
+        {
+        	state_type* state = current();
+        	link_node* undo = push(state->value, state->undo);
+        	acquire(state->value);
+        	acquire(state->redo);
+        	publish(state->value, undo, state->redo);
+        	return true;
+        }
+
+        template <typename T, std::size_t Readers>
+        bool concurrent_redoable<T, Readers>::undo()
+        {
+        	state_type* state = current();
+        	if (!state->undo)
+        	{
+        		return false;
+        	}
+        	link_node* redo = push(state->value, state->redo);
+        	acquire(state->undo->value);
+        	acquire(state->undo->next);
+        	publish(state->undo->value, state->undo->next, redo);
+        	return true;
+        }
+
+        template <typename T, std::size_t Readers>
+        bool concurrent_redoable<T, Readers>::redo()
+        {
+        	state_type* state = current();
+        	if (!state->redo)
+        	{
+        		return false;
+        	}
+        	acquire(state->redo->value);
+        	acquire(state->undo);
+        	acquire(state->redo->next);
+        	publish(state->redo->value, state->undo, state->redo->next);
+        	return true;
+        }
+
+        template <typename T, std::size_t Readers>
+        void concurrent_redoable<T, Readers>::collect()
+        {
+        	if (retired_.empty())
+        	{
+        		return;
+        	}
+        	std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+        	for (const detail::mvcc_slot& slot : slots_)
+        	{
+        		const std::uint64_t epoch = slot.epoch.load();
+        		if (epoch != 0 && epoch < oldest)
+        		{
+        			oldest = epoch;
+        		}
+        	}
+        	// A version retired at epoch e may only be seen by readers pinned before e
+        	std::size_t freed = 0;
+        	while (freed < retired_.size() && retired_[freed].epoch <= oldest)
+        	{
+        		release(retired_[freed++].state);
+        	}
+        	retired_.erase(retired_.begin(), retired_.begin() + freed);
+        }
+
+        template <typename T, std::size_t Readers>
+        typename concurrent_redoable<T, Readers>::link_node* concurrent_redoable<T, Readers>::push(value_node* value,
+        		link_node* next)
+        {
+        	link_node* link = new link_node{value, next, (next) ? next->depth + 1 : 1, 1};
+        	acquire(value);
+        	acquire(next);
+        	return link;
+        }
+
+        template <typename T, std::size_t Readers>
+        void concurrent_redoable<T, Readers>::release(value_node* node) noexcept
+        {
+        	if (--node->refs == 0)
+        	{
+        		delete node;
+        	}
+        }
+
+        template <typename T, std::size_t Readers>
+        void concurrent_redoable<T, Readers>::release(link_node* node) noexcept
+        {
+        	// Iterative, histories can be long
+        	while (node && --node->refs == 0)
+        	{
+        		link_node* next = node->next;
+        		release(node->value);
+        		delete node;
+        		node = next;
+        	}
+        }
+
+        template <typename T, std::size_t Readers>
+        void concurrent_redoable<T, Readers>::release(state_type* state) noexcept
+        {
+        	release(state->value);
+        	release(state->undo);
+        	release(state->redo);
+        	delete state;
+        }
+
+        template <typename T, std::size_t Readers>
+        void concurrent_redoable<T, Readers>::publish(value_node* value, link_node* undo, link_node* redo)
+        {
+        	state_type* state;
+        	try
+        	{
+        		if (retired_.size() == retired_.capacity())
+        		{
+        			retired_.reserve(2 * retired_.size() + 1);
+        		}
+        		state = new state_type{value, undo, redo};
+        	}
+        	catch (...)
+        	{
+        		release(value);
+        		release(undo);
+        		release(redo);
+        		throw;
+        	}
+        	state_type* old = state_.exchange(state);
+        	const std::uint64_t epoch = epoch_.fetch_add(1) + 1;
+        	retired_.push_back(retired_state{epoch, old});
+        	collect();
+        }
+    }
+}
+
+#endif
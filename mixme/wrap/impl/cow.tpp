@@ -0,0 +1,141 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_COW_TPP_
+#define MIXME_WRAP_COW_TPP_
+
+namespace mixme
+{
+    namespace wrap
+    {
+        template <typename T>
+        cow_undoable<T>::cow_undoable(const cow_undoable& other) noexcept
+		: value_(acquire(other.value_)), undo_(acquire(other.undo_))
+        {}
+
+        template <typename T>
+        cow_undoable<T>::cow_undoable(cow_undoable&& other) noexcept
+		: value_(acquire(other.value_)), undo_(other.undo_)
+        {
+        	// The value stays shared, so that the moved-from object remains usable
+        	other.undo_ = nullptr;
+        }
+
+        template <typename T>
+        cow_undoable<T>::~cow_undoable()
+        {
+        	release(value_);
+        	release(undo_);
+        }
+
+        template <typename T>
+        cow_undoable<T>& cow_undoable<T>::operator=(const cow_undoable& other) noexcept
+        {
+        	node_type* value = acquire(other.value_);
+        	node_type* undo = acquire(other.undo_);
+        	release(value_);
+        	release(undo_);
+        	value_ = value;
+        	undo_ = undo;
+        	return *this;
+        }
+
+        template <typename T>
+        cow_undoable<T>& cow_undoable<T>::operator=(cow_undoable&& other) noexcept
+        {
+        	if (this != &other)
+        	{
+        		node_type* value = acquire(other.value_);
+        		release(value_);
+        		release(undo_);
+        		value_ = value;
+        		undo_ = other.undo_;
+        		other.undo_ = nullptr;
+        	}
+        	return *this;
+        }
+
+        template <typename T>
+        template <typename U, typename std::enable_if_t<!std::is_same<cow_undoable<T>, std::decay_t<U>>::value>*>
+        cow_undoable<T>& cow_undoable<T>::operator=(U&& value)
+        {
+        	if (shared())
+        	{
+        		// The old value is about to be overwritten, no need to copy it
+        		node_type* node = new node_type(std::forward<U>(value));
+        		release(value_);
+        		value_ = node;
+        	}
+        	else
+        	{
+        		value_->value = std::forward<U>(value);
+        	}
+        	return *this;
+        }
+
+        template <typename T>
+        T& cow_undoable<T>::value()
+        {
+        	if (shared())
+        	{
+        		node_type* node = new node_type(static_cast<const T&>(value_->value));
+        		release(value_);
+        		value_ = node;
+        	}
+        	return value_->value;
+        }
+
+        template <typename T>
+        bool cow_undoable<T>::save() noexcept
+        {
+        	const bool will_overwrite = has_save();
+        	release(undo_);
+        	undo_ = acquire(value_);
+        	return !will_overwrite;
+        }
+
+        template <typename T>
+        bool cow_undoable<T>::undo() noexcept
+        {
+        	if (!has_save())
+        	{
+        		return false;
+        	}
+        	release(value_);
+        	value_ = undo_;
+        	undo_ = nullptr;
+        	return true;
+        }
+
+        template <typename T>
+        typename cow_undoable<T>::node_type* cow_undoable<T>::acquire(node_type* node) noexcept
+        {
+        	if (node)
+        	{
+        		node->refs.fetch_add(1, std::memory_order_relaxed);
+        	}
+        	return node;
+        }
+
+        template <typename T>
+        void cow_undoable<T>::release(node_type* node) noexcept
+        {
+        	// Acquires the writes of the other owners before deleting
+        	if (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        	{
+        		delete node;
+        	}
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,173 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_DELTA_STORAGE_TPP_
+#define MIXME_WRAP_DELTA_STORAGE_TPP_
+
+#include <utility>
+#include <cstring>
+
+namespace mixme
+{
+	namespace detail
+	{
+		inline byte_delta diff_bytes(const unsigned char* from, const unsigned char* to, std::size_t size)
+		{
+			// Unchanged gaps shorter than a run header are cheaper to copy than to skip
+			constexpr std::size_t min_gap = sizeof(byte_delta::run);
+
+			byte_delta delta;
+			std::size_t i = 0;
+			while (i < size)
+			{
+				if (from[i] == to[i])
+				{
+					i++;
+					continue;
+				}
+				const std::size_t begin = i;
+				std::size_t end = i + 1;
+				std::size_t same = 0;
+				for (std::size_t j = end; j < size && same < min_gap; j++)
+				{
+					if (from[j] == to[j])
+					{
+						same++;
+					}
+					else
+					{
+						same = 0;
+						end = j + 1;
+					}
+				}
+				delta.runs.push_back({begin, end - begin});
+				delta.bytes.insert(delta.bytes.end(), to + begin, to + end);
+				i = end;
+			}
+			return delta;
+		}
+
+		inline void patch_bytes(unsigned char* dst, const byte_delta& delta) noexcept
+		{
+			const unsigned char* src = delta.bytes.data();
+			for (const auto& run : delta.runs)
+			{
+				std::memcpy(dst + run.offset, src, run.length);
+				src += run.length;
+			}
+		}
+	}
+
+    namespace wrap
+    {
+        template <typename T, typename Traits>
+    	void delta_storage<T, Traits>::copy_construct(const data_type& src,
+    			const bookkeeping_type& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp)
+        {
+        	if (src_bkp)
+        	{
+        		dst.head = std::make_unique<T>(*src.head);
+        		dst.deltas = src.deltas;
+        	}
+        	dst_bkp = src_bkp;
+        }
+
+        template <typename T, typename Traits>
+    	void delta_storage<T, Traits>::move_construct(data_type&& src,
+    			bookkeeping_type&& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp) noexcept
+    	{
+        	dst = std::move(src);
+        	dst_bkp = src_bkp;
+        	src_bkp = 0;
+    	}
+
+        template <typename T, typename Traits>
+    	void delta_storage<T, Traits>::copy_assign(const data_type& src,
+    			const bookkeeping_type& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp)
+        {
+        	if (src_bkp)
+        	{
+        		if (dst.head)
+        		{
+        			*dst.head = *src.head;
+        		}
+        		else
+        		{
+        			dst.head = std::make_unique<T>(*src.head);
+        		}
+        	}
+        	dst.deltas = src.deltas;
+        	dst_bkp = src_bkp;
+        }
+
+        template <typename T, typename Traits>
+    	void delta_storage<T, Traits>::move_assign(data_type&& src,
+    			bookkeeping_type&& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp) noexcept
+    	{
+        	move_construct(std::move(src), std::move(src_bkp), dst, dst_bkp);
+    	}
+
+        template <typename T, typename Traits>
+        void delta_storage<T, Traits>::store(T& value, data_type& data, bookkeeping_type& bkp)
+        {
+        	if (!data.head)
+        	{
+        		data.head = std::make_unique<T>(value);
+        	}
+        	else if (bkp)
+        	{
+        		// Everything that can throw happens before the history changes
+        		if (data.deltas.size() == data.deltas.capacity())
+        		{
+        			data.deltas.reserve(2 * data.deltas.size() + 1);
+        		}
+        		delta_type delta = Traits::diff(value, *data.head);
+        		*data.head = value;
+        		data.deltas.push_back(std::move(delta));
+        	}
+        	else
+        	{
+        		*data.head = value;
+        	}
+        	bkp++;
+        }
+
+        template <typename T, typename Traits>
+        void delta_storage<T, Traits>::restore(T& value, data_type& data, bookkeeping_type& bkp)
+        {
+        	if (data.deltas.empty())
+        	{
+        		value = std::move(*data.head);
+        	}
+        	else
+        	{
+        		// Rebuilds the previous element aside, so that a throwing copy or apply changes nothing
+        		T previous(*data.head);
+        		Traits::apply(previous, data.deltas.back());
+        		value = std::move(*data.head);
+        		*data.head = std::move(previous);
+        		data.deltas.pop_back();
+        	}
+        	bkp--;
+        }
+    }
+}
+
+#endif
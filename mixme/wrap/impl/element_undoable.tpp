@@ -0,0 +1,213 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef MIXME_WRAP_ELEMENT_UNDOABLE_TPP_
+#define MIXME_WRAP_ELEMENT_UNDOABLE_TPP_
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	// Each operation returns its inverse, moving the elements between the container and the journal
+
+    	template <typename U, typename Allocator>
+    	struct element_undoable<std::vector<U, Allocator>>::set_operation
+		{
+    		std::size_t index;
+    		U element;
+
+    		set_operation operator()(container_type& container)
+    		{
+    			using std::swap;
+    			swap(container[index], element);
+    			return std::move(*this);
+    		}
+		};
+
+    	template <typename U, typename Allocator>
+    	struct element_undoable<std::vector<U, Allocator>>::pop_back_operation
+		{
+    		push_back_operation operator()(container_type& container);
+		};
+
+    	template <typename U, typename Allocator>
+    	struct element_undoable<std::vector<U, Allocator>>::push_back_operation
+		{
+    		U element;
+
+    		pop_back_operation operator()(container_type& container)
+    		{
+    			container.push_back(std::move(element));
+    			return pop_back_operation();
+    		}
+		};
+
+    	template <typename U, typename Allocator>
+    	typename element_undoable<std::vector<U, Allocator>>::push_back_operation
+		element_undoable<std::vector<U, Allocator>>::pop_back_operation::operator()(container_type& container)
+    	{
+    		push_back_operation inverse{std::move(container.back())};
+    		container.pop_back();
+    		return inverse;
+    	}
+
+    	template <typename U, typename Allocator>
+    	struct element_undoable<std::vector<U, Allocator>>::erase_operation
+		{
+    		std::size_t index;
+
+    		insert_operation operator()(container_type& container);
+		};
+
+    	template <typename U, typename Allocator>
+    	struct element_undoable<std::vector<U, Allocator>>::insert_operation
+		{
+    		std::size_t index;
+    		U element;
+
+    		erase_operation operator()(container_type& container)
+    		{
+    			container.insert(container.begin() + index, std::move(element));
+    			return erase_operation{index};
+    		}
+		};
+
+    	template <typename U, typename Allocator>
+    	typename element_undoable<std::vector<U, Allocator>>::insert_operation
+		element_undoable<std::vector<U, Allocator>>::erase_operation::operator()(container_type& container)
+    	{
+    		insert_operation inverse{index, std::move(container[index])};
+    		container.erase(container.begin() + index);
+    		return inverse;
+    	}
+
+    	template <typename U, typename Allocator>
+    	template <typename V>
+    	void element_undoable<std::vector<U, Allocator>>::set(std::size_t index, V&& element)
+    	{
+    		this->journal_.execute(set_operation{index, U(std::forward<V>(element))});
+    	}
+
+    	template <typename U, typename Allocator>
+    	template <typename V>
+    	void element_undoable<std::vector<U, Allocator>>::push_back(V&& element)
+    	{
+    		this->journal_.execute(push_back_operation{U(std::forward<V>(element))});
+    	}
+
+    	template <typename U, typename Allocator>
+    	void element_undoable<std::vector<U, Allocator>>::pop_back()
+    	{
+    		this->journal_.execute(pop_back_operation());
+    	}
+
+    	template <typename U, typename Allocator>
+    	template <typename V>
+    	void element_undoable<std::vector<U, Allocator>>::insert(std::size_t index, V&& element)
+    	{
+    		this->journal_.execute(insert_operation{index, U(std::forward<V>(element))});
+    	}
+
+    	template <typename U, typename Allocator>
+    	void element_undoable<std::vector<U, Allocator>>::erase(std::size_t index)
+    	{
+    		this->journal_.execute(erase_operation{index});
+    	}
+
+    	namespace detail
+		{
+    		template <typename C>
+    		struct associative_history<C>::assign_operation
+			{
+    			key_type key;
+    			mapped_type element;
+
+    			assign_operation operator()(C& container)
+    			{
+    				using std::swap;
+    				swap(container.find(key)->second, element);
+    				return std::move(*this);
+    			}
+			};
+
+    		template <typename C>
+    		struct associative_history<C>::erase_operation
+			{
+    			key_type key;
+
+    			insert_operation operator()(C& container);
+			};
+
+    		template <typename C>
+    		struct associative_history<C>::insert_operation
+			{
+    			key_type key;
+    			mapped_type element;
+
+    			erase_operation operator()(C& container)
+    			{
+    				container.emplace(key, std::move(element));
+    				return erase_operation{std::move(key)};
+    			}
+			};
+
+    		template <typename C>
+    		typename associative_history<C>::insert_operation associative_history<C>::erase_operation::operator()(C& container)
+    		{
+    			const auto position = container.find(key);
+    			insert_operation inverse{std::move(key), std::move(position->second)};
+    			container.erase(position);
+    			return inverse;
+    		}
+
+    		template <typename C>
+    		template <typename V>
+    		void associative_history<C>::set(const key_type& key, V&& element)
+    		{
+    			if (count(key) > 0)
+    			{
+    				this->journal_.execute(assign_operation{key, mapped_type(std::forward<V>(element))});
+    			}
+    			else
+    			{
+    				this->journal_.execute(insert_operation{key, mapped_type(std::forward<V>(element))});
+    			}
+    		}
+
+    		template <typename C>
+    		template <typename V>
+    		bool associative_history<C>::insert(const key_type& key, V&& element)
+    		{
+    			if (count(key) > 0)
+    			{
+    				return false;
+    			}
+    			this->journal_.execute(insert_operation{key, mapped_type(std::forward<V>(element))});
+    			return true;
+    		}
+
+    		template <typename C>
+    		bool associative_history<C>::erase(const key_type& key)
+    		{
+    			if (count(key) == 0)
+    			{
+    				return false;
+    			}
+    			this->journal_.execute(erase_operation{key});
+    			return true;
+    		}
+		}
+    }
+}
+
+#endif
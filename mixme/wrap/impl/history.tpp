@@ -23,40 +23,101 @@ namespace mixme
     {
         namespace detail
         {
+            /** std::construct_at where it's usable in constant expressions, placement new otherwise */
+            template <typename T, typename... Args>
+            MIXME_CONSTEXPR20 T* construct_at(T* p, Args&&... args)
+            {
+#ifdef MIXME_HAS_CONSTEXPR_HISTORY
+            	return std::construct_at(p, std::forward<Args>(args)...);
+#else
+            	return ::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+#endif
+            }
+
+            template <typename T>
+            MIXME_CONSTEXPR20 T* construct_trivial(T* p, const T& from, std::true_type)
+            {
+            	return detail::construct_at(p, from);
+            }
+
+            template <typename T>
+            MIXME_CONSTEXPR20 T* construct_trivial(T* p, const T& from, std::false_type)
+            {
+            	return detail::construct_at(p, std::move(const_cast<T&>(from)));
+            }
+
+            /**
+             * Copies a trivially copyable element where memcpy can't be used. Move-only elements
+             * are moved, since a trivial move copies the bytes anyway
+             */
+            template <typename T>
+            MIXME_CONSTEXPR20 T* construct_trivial(T* p, const T& from)
+            {
+            	return detail::construct_trivial(p, from, std::is_copy_constructible<T>{});
+            }
+
+            /** Whether the call happens in a constant expression, where raw memory can't be accessed */
+            constexpr bool is_constant_evaluated() noexcept
+            {
+#ifdef MIXME_HAS_CONSTEXPR_HISTORY
+            	return std::is_constant_evaluated();
+#else
+            	return false;
+#endif
+            }
+
+            template <typename T,
+					typename U,
+					typename std::enable_if_t<std::is_trivially_copyable<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void copy_or_move_impl(T& from, U& to, bool)
+            {
+            	if (is_constant_evaluated())
+            	{
+            		detail::construct_trivial(&to.value, from);
+            	}
+            	else
+            	{
+            		std::memcpy(static_cast<void*>(&to), &from, sizeof(T));
+            	}
+            }
+
             template <typename T,
 					typename U,
-					typename std::enable_if_t<std::is_copy_assignable<T>::value>* = nullptr>
-            void copy_or_move_impl(T& from, U& to, bool constructed)
+					typename std::enable_if_t<!std::is_trivially_copyable<T>::value &&
+							std::is_copy_assignable<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void copy_or_move_impl(T& from, U& to, bool constructed)
             {
             	if (constructed)
             	{
-            		*reinterpret_cast<T*>(to) = from;
+            		to.value = from;
             	}
             	else
             	{
-            		new (to) T(from);
+            		detail::construct_at(&to.value, from);
             	}
             }
 
             template <typename T,
 					typename U,
-					typename std::enable_if_t<!std::is_copy_assignable<T>::value &&
+					typename std::enable_if_t<!std::is_trivially_copyable<T>::value &&
+							!std::is_copy_assignable<T>::value &&
 							std::is_move_assignable<T>::value>* = nullptr>
-            void copy_or_move_impl(T& from, U& to, bool constructed)
+            MIXME_CONSTEXPR20 void copy_or_move_impl(T& from, U& to, bool constructed)
             {
             	if (constructed)
             	{
-            		*reinterpret_cast<T*>(to) = std::move(from);
+            		to.value = std::move(from);
             	}
             	else
             	{
-            		new (to) T(std::move(from));
+            		detail::construct_at(&to.value, std::move(from));
             	}
             }
 
             template <typename T,
 					typename U,
-					typename std::enable_if_t<!std::is_copy_assignable<T>::value &&
+					typename std::enable_if_t<!std::is_trivially_copyable<T>::value &&
+							!std::is_copy_assignable<T>::value &&
 							!std::is_move_assignable<T>::value>* = nullptr>
             void copy_or_move_impl(T&, U&, bool)
             {
@@ -64,15 +125,15 @@ namespace mixme
             		"T must be copy-assignable or move-assignable");
             }
 
-            /** Performs copy assignment or, if missing, move assignment */
+            /** Performs copy assignment or, if missing, move assignment, into the element of a slot */
             template <typename T, typename U>
-            void copy_or_move(T& from, U& to, bool constructed)
+            MIXME_CONSTEXPR20 void copy_or_move(T& from, U& to, bool constructed)
             {
             	copy_or_move_impl(from, to, constructed);
             }
 
             template <typename T, typename std::enable_if_t<std::is_copy_assignable<T>::value>* = nullptr>
-            void copy_or_move_impl(T& from, T& to)
+            constexpr void copy_or_move_impl(T& from, T& to)
             {
             	to = from;
             }
@@ -80,7 +141,7 @@ namespace mixme
             template <typename T,
 					typename std::enable_if_t<!std::is_copy_assignable<T>::value &&
 							std::is_move_assignable<T>::value>* = nullptr>
-            void copy_or_move_impl(T& from, T& to)
+            constexpr void copy_or_move_impl(T& from, T& to)
             {
             	to = std::move(from);
             }
@@ -96,24 +157,320 @@ namespace mixme
 
             /** Performs copy assignment or, if missing, move assignment */
             template <typename T>
-            void copy_or_move(T& from, T& to)
+            constexpr void copy_or_move(T& from, T& to)
             {
             	copy_or_move_impl(from, to);
             }
+
+            /**
+             * Copy constructs, or copy assigns if constructed, the element of a slot.
+             * Trivially copyable elements are copied as raw bytes, except in constant expressions
+             */
+            template <typename T, typename U, typename std::enable_if_t<std::is_trivially_copyable<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void copy_raw(const U& from, U& to, bool) noexcept
+            {
+            	if (is_constant_evaluated())
+            	{
+            		detail::construct_trivial(&to.value, from.value);
+            	}
+            	else
+            	{
+            		std::memcpy(static_cast<void*>(&to), &from, sizeof(T));
+            	}
+            }
+
+            template <typename T, typename U, typename std::enable_if_t<!std::is_trivially_copyable<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void copy_raw(const U& from, U& to, bool constructed)
+            {
+            	if (constructed)
+            	{
+            		to.value = from.value;
+            	}
+            	else
+            	{
+            		detail::construct_at(&to.value, from.value);
+            	}
+            }
+
+            /** Move constructs, or move assigns if constructed, the element of a slot */
+            template <typename T, typename U, typename std::enable_if_t<std::is_trivially_copyable<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void move_raw(U& from, U& to, bool) noexcept
+            {
+            	copy_raw<T>(from, to, true);
+            }
+
+            template <typename T, typename U, typename std::enable_if_t<!std::is_trivially_copyable<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void move_raw(U& from, U& to, bool constructed)
+            {
+            	if (constructed)
+            	{
+            		to.value = std::move(from.value);
+            	}
+            	else
+            	{
+            		detail::construct_at(&to.value, std::move(from.value));
+            	}
+            }
+
+            /** Destroys the element of a slot */
+            template <typename T, typename U, typename std::enable_if_t<std::is_trivially_copyable<T>::value>* = nullptr>
+            constexpr void destroy_raw(U&) noexcept {}
+
+            template <typename T, typename U, typename std::enable_if_t<!std::is_trivially_copyable<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void destroy_raw(U& data) noexcept
+            {
+            	data.value.~T();
+            }
+
+            /**
+             * Moves the element of a slot into another one, ending its lifetime.
+             * Trivially relocatable elements are copied as raw bytes, without running their destructor
+             */
+            template <typename T, typename U, typename std::enable_if_t<mixme::detail::relocates_bytes<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void relocate_raw(U& from, U& to, bool constructed) noexcept
+            {
+            	if (constructed)
+            	{
+            		destroy_raw<T>(to);
+            	}
+            	if (is_constant_evaluated())
+            	{
+            		detail::construct_at(&to.value, std::move(from.value));
+            		destroy_raw<T>(from);
+            	}
+            	else
+            	{
+            		std::memcpy(static_cast<void*>(&to.value), &from.value, sizeof(T));
+            	}
+            }
+
+            template <typename T, typename U, typename std::enable_if_t<!mixme::detail::relocates_bytes<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void relocate_raw(U& from, U& to, bool constructed)
+            {
+            	move_raw<T>(from, to, constructed);
+            	destroy_raw<T>(from);
+            }
+
+            /** Moves the element of a slot into value, ending its lifetime */
+            template <typename T, typename U, typename std::enable_if_t<std::is_trivially_copyable<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void restore_raw(T& value, U& from) noexcept
+            {
+            	if (is_constant_evaluated())
+            	{
+            		detail::construct_trivial(&value, from.value);
+            	}
+            	else
+            	{
+            		std::memcpy(static_cast<void*>(&value), &from, sizeof(T));
+            	}
+            }
+
+            template <typename T, typename U, typename std::enable_if_t<mixme::detail::relocates_bytes<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void restore_raw(T& value, U& from) noexcept
+            {
+            	if (is_constant_evaluated())
+            	{
+            		value = std::move(from.value);
+            		from.value.~T();
+            	}
+            	else
+            	{
+            		value.~T();
+            		std::memcpy(static_cast<void*>(&value), &from.value, sizeof(T));
+            	}
+            }
+
+            template <typename T,
+					typename U,
+					typename std::enable_if_t<!std::is_trivially_copyable<T>::value &&
+							!mixme::detail::relocates_bytes<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void restore_raw(T& value, U& from)
+            {
+            	value = std::move(from.value);
+            	from.value.~T();
+            }
+
+            /**
+             * Moves value into the slot to, constructed or not, then restores the element of from into value.
+             * Trivially relocatable elements go around as raw bytes, without running any destructor
+             */
+            template <typename T, typename U, typename std::enable_if_t<mixme::detail::relocates_bytes<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void exchange_raw(T& value, U& from, U& to, bool constructed)
+            {
+            	if (constructed)
+            	{
+            		destroy_raw<T>(to);
+            	}
+            	if (is_constant_evaluated())
+            	{
+            		detail::construct_at(&to.value, std::move(value));
+            		restore_raw(value, from);
+            	}
+            	else
+            	{
+            		std::memcpy(static_cast<void*>(&to.value), &value, sizeof(T));
+            		std::memcpy(static_cast<void*>(&value), &from.value, sizeof(T));
+            	}
+            }
+
+            template <typename T, typename U, typename std::enable_if_t<!mixme::detail::relocates_bytes<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void exchange_raw(T& value, U& from, U& to, bool constructed)
+            {
+            	if (constructed)
+            	{
+            		to.value = std::move(value);
+            	}
+            	else
+            	{
+            		detail::construct_at(&to.value, std::move(value));
+            	}
+            	restore_raw(value, from);
+            }
+
+            /**
+             * Copies the count elements starting at first, wrapping around the end of the array.
+             * Trivially copyable elements are copied as raw bytes, otherwise the whole array is assigned
+             */
+            template <typename T,
+					std::size_t N,
+					typename std::enable_if_t<std::is_trivially_copyable<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void copy_elements(const std::array<T, N>& from,
+            		std::array<T, N>& to,
+					std::size_t first,
+					std::size_t count) noexcept
+            {
+            	if (is_constant_evaluated())
+            	{
+            		for (std::size_t i = 0; i < count; ++i)
+            		{
+            			const std::size_t n = (first + i) % N;
+            			detail::construct_trivial(&to[n], from[n]);
+            		}
+            		return;
+            	}
+            	const std::size_t head = (count < N - first) ? count : N - first;
+            	std::memcpy(static_cast<void*>(to.data() + first), from.data() + first, head * sizeof(T));
+            	std::memcpy(static_cast<void*>(to.data()), from.data(), (count - head) * sizeof(T));
+            }
+
+            template <typename T,
+					std::size_t N,
+					typename std::enable_if_t<!std::is_trivially_copyable<T>::value>* = nullptr>
+            constexpr void copy_elements(const std::array<T, N>& from, std::array<T, N>& to, std::size_t, std::size_t)
+            {
+            	to = from;
+            }
+
+            template <typename T,
+					std::size_t N,
+					typename std::enable_if_t<std::is_trivially_copyable<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void move_elements(std::array<T, N>& from,
+            		std::array<T, N>& to,
+					std::size_t first,
+					std::size_t count) noexcept
+            {
+            	copy_elements(from, to, first, count);
+            }
+
+            /** Trivially relocatable elements are exchanged as raw bytes, leaving the previous ones of to in from */
+            template <typename T,
+					std::size_t N,
+					typename std::enable_if_t<mixme::detail::relocates_bytes<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void move_elements(std::array<T, N>& from,
+            		std::array<T, N>& to,
+					std::size_t first,
+					std::size_t count)
+            {
+            	if (is_constant_evaluated())
+            	{
+            		to = std::move(from);
+            		return;
+            	}
+            	const std::size_t head = (count < N - first) ? count : N - first;
+            	mixme::detail::swap_bytes(from.data() + first, to.data() + first, head);
+            	mixme::detail::swap_bytes(from.data(), to.data(), count - head);
+            }
+
+            template <typename T,
+					std::size_t N,
+					typename std::enable_if_t<!std::is_trivially_copyable<T>::value &&
+							!mixme::detail::relocates_bytes<T>::value>* = nullptr>
+            constexpr void move_elements(std::array<T, N>& from, std::array<T, N>& to, std::size_t, std::size_t)
+            {
+            	to = std::move(from);
+            }
+
+            /**
+             * Moves the stored element from into value. Trivially relocatable elements exchange
+             * their bytes, leaving the previous value in from
+             */
+            template <typename T, typename std::enable_if_t<mixme::detail::relocates_bytes<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void restore_element(T& value, T& from)
+            {
+            	if (is_constant_evaluated())
+            	{
+            		value = std::move(from);
+            	}
+            	else
+            	{
+            		mixme::detail::swap_bytes(value, from);
+            	}
+            }
+
+            template <typename T, typename std::enable_if_t<!mixme::detail::relocates_bytes<T>::value>* = nullptr>
+            constexpr void restore_element(T& value, T& from)
+            {
+            	value = std::move(from);
+            }
+
+            /** Moves value into to, then from into value */
+            template <typename T>
+            MIXME_CONSTEXPR20 void exchange_elements(T& value, T& from, T& to)
+            {
+            	restore_element(to, value);
+            	restore_element(value, from);
+            }
+
+            /**
+             * Releases the resources held by the count elements starting at first, wrapping around the end of
+             * the array, by assigning them a value-initialized element. Trivially copyable elements hold none
+             */
+            template <typename T,
+						std::size_t N,
+						typename std::enable_if_t<std::is_trivially_copyable<T>::value>* = nullptr>
+            constexpr void release_elements(std::array<T, N>&, std::size_t, std::size_t) noexcept {}
+
+            template <typename T,
+						std::size_t N,
+						typename std::enable_if_t<!std::is_trivially_copyable<T>::value>* = nullptr>
+            MIXME_CONSTEXPR20 void release_elements(std::array<T, N>& data, std::size_t first, std::size_t count)
+            {
+            	for (std::size_t i = 0; i < count; ++i)
+            	{
+            		data[(first + i) % N] = T();
+            	}
+            }
+
+            /** Casts to a const lvalue reference if T is copy-constructible, to an rvalue reference otherwise */
+            template <typename T>
+            std::conditional_t<std::is_copy_constructible<T>::value, const T&, T&&> copy_or_move_ref(T& from)
+            {
+            	return static_cast<std::conditional_t<std::is_copy_constructible<T>::value, const T&, T&&>>(from);
+            }
         }
 
-        template <typename T, typename Storage_policy>
-        constexpr undoable<T, Storage_policy>::undoable(const undoable& other)
-		noexcept(noexcept(Storage_policy::copy_construct))
-		: base<T>(other)
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        constexpr undoable<T, Storage_policy, Instrumentation>::undoable(const undoable& other)
+		noexcept(nothrow_copy_construct)
+		: base<T>(other), Instrumentation() // copies record their own activity
         {
         	Storage_policy::copy_construct(other.undo_data_, other.undo_bkp_, undo_data_, undo_bkp_);
         }
 
-        template <typename T, typename Storage_policy>
-        constexpr undoable<T, Storage_policy>::undoable(undoable&& other)
-		noexcept(noexcept(Storage_policy::move_construct))
-		: base<T>(std::move(other))
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        constexpr undoable<T, Storage_policy, Instrumentation>::undoable(undoable&& other)
+		noexcept(nothrow_move_construct)
+		: base<T>(std::move(other)), Instrumentation()
 		{
         	Storage_policy::move_construct(std::move(other.undo_data_),
         			std::move(other.undo_bkp_),
@@ -121,24 +478,30 @@ namespace mixme
 					undo_bkp_);
 		}
 
-        template <typename T, typename Storage_policy>
-        undoable<T, Storage_policy>::~undoable()
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        template <typename Alloc, typename... Args>
+        undoable<T, Storage_policy, Instrumentation>::undoable(std::allocator_arg_t, Alloc&& alloc, Args&&... args)
+		: base<T>(std::forward<Args>(args)...), undo_data_(alloc)
+		{}
+
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 undoable<T, Storage_policy, Instrumentation>::~undoable()
 		{
         	Storage_policy::dispose(undo_data_, undo_bkp_);
 		}
 
-        template <typename T, typename Storage_policy>
-        undoable<T, Storage_policy>& undoable<T, Storage_policy>::operator=(const undoable& other)
-        noexcept(noexcept(Storage_policy::copy_assign))
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 undoable<T, Storage_policy, Instrumentation>& undoable<T, Storage_policy, Instrumentation>::operator=(const undoable& other)
+        noexcept(nothrow_copy_assign)
 		{
         	base<T>::operator=(other);
         	Storage_policy::copy_assign(other.undo_data_, other.undo_bkp_, undo_data_, undo_bkp_);
         	return *this;
 		}
 
-        template <typename T, typename Storage_policy>
-        undoable<T, Storage_policy>& undoable<T, Storage_policy>::operator=(undoable&& other)
-        noexcept(noexcept(Storage_policy::move_assign))
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 undoable<T, Storage_policy, Instrumentation>& undoable<T, Storage_policy, Instrumentation>::operator=(undoable&& other)
+        noexcept(nothrow_move_assign)
 		{
         	base<T>::operator=(std::move(other));
         	Storage_policy::move_assign(std::move(other.undo_data_),
@@ -148,45 +511,70 @@ namespace mixme
         	return *this;
 		}
 
-        template <typename T, typename Storage_policy>
-        template <typename U>
-		undoable<T, Storage_policy>& undoable<T, Storage_policy>::operator=(U&& other)
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        template <typename U, typename std::enable_if_t<!std::is_base_of<undoable<T, Storage_policy, Instrumentation>, std::decay_t<U>>::value>*>
+		MIXME_CONSTEXPR20 undoable<T, Storage_policy, Instrumentation>& undoable<T, Storage_policy, Instrumentation>::operator=(U&& other)
         {
         	base<T>::operator=(std::forward<U>(other));
         	return *this;
         }
 
-        template <typename T, typename Storage_policy>
-        bool undoable<T, Storage_policy>::save()
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 bool undoable<T, Storage_policy, Instrumentation>::save()
         {
-        	const bool will_overwrite = ((max_saves() - saves()) == 0);
-        	Storage_policy::store(this->value(), undo_data_, undo_bkp_);
-            return !will_overwrite;
+        	const auto token = instrumentation().enter(history_event::save);
+        	const bool kept = store_save();
+        	instrumentation().leave(history_event::save, token, kept, [this] { return estimated_undo_bytes(); });
+            return kept;
         }
 
-        template <typename T, typename Storage_policy>
-        bool undoable<T, Storage_policy>::undo()
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 bool undoable<T, Storage_policy, Instrumentation>::undo()
         {
         	if (!has_save())
         	{
         		return false;
         	}
-        	Storage_policy::restore(this->value(), undo_data_, undo_bkp_);
+        	const auto token = instrumentation().enter(history_event::undo);
+        	restore_save();
+        	instrumentation().leave(history_event::undo, token, true, [this] { return estimated_undo_bytes(); });
             return true;
         }
 
-        template <typename T, typename Storage_policy>
-        constexpr redoable<T, Storage_policy>::redoable(const redoable& other)
-		noexcept(noexcept(Storage_policy::copy_construct))
-		: undoable<T, Storage_policy>(other)
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 bool undoable<T, Storage_policy, Instrumentation>::store_save()
+        {
+        	// Storing overwrote or evicted a save state if the count didn't grow
+        	const std::size_t previous_saves = saves();
+        	Storage_policy::store(this->value(), undo_data_, undo_bkp_);
+            return saves() > previous_saves;
+        }
+
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 void undoable<T, Storage_policy, Instrumentation>::restore_save()
+        {
+        	Storage_policy::restore(this->value(), undo_data_, undo_bkp_);
+        }
+
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 void undoable<T, Storage_policy, Instrumentation>::exchange_save(typename Storage_policy::data_type& to,
+        		typename Storage_policy::bookkeeping_type& to_bkp)
+        {
+        	transfer(this->value(), undo_data_, undo_bkp_, to, to_bkp, 0);
+        }
+
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        constexpr redoable<T, Storage_policy, Instrumentation>::redoable(const redoable& other)
+		noexcept(undoable<T, Storage_policy, Instrumentation>::nothrow_copy_construct)
+		: undoable<T, Storage_policy, Instrumentation>(other)
 		{
         	Storage_policy::copy_construct(other.redo_data_, other.redo_bkp_, redo_data_, redo_bkp_);
 		}
 
-        template <typename T, typename Storage_policy>
-        constexpr redoable<T, Storage_policy>::redoable(redoable&& other)
-		noexcept(noexcept(Storage_policy::move_construct))
-		: undoable<T, Storage_policy>(std::move(other))
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        constexpr redoable<T, Storage_policy, Instrumentation>::redoable(redoable&& other)
+		noexcept(undoable<T, Storage_policy, Instrumentation>::nothrow_move_construct)
+		: undoable<T, Storage_policy, Instrumentation>(std::move(other))
 		{
         	Storage_policy::move_construct(std::move(other.redo_data_),
         			std::move(other.redo_bkp_),
@@ -194,26 +582,32 @@ namespace mixme
 					redo_bkp_);
 		}
 
-        template <typename T, typename Storage_policy>
-        redoable<T, Storage_policy>::~redoable()
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        template <typename Alloc, typename... Args>
+        redoable<T, Storage_policy, Instrumentation>::redoable(std::allocator_arg_t, Alloc&& alloc, Args&&... args)
+		: undoable<T, Storage_policy, Instrumentation>(std::allocator_arg, alloc, std::forward<Args>(args)...), redo_data_(alloc)
+		{}
+
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 redoable<T, Storage_policy, Instrumentation>::~redoable()
         {
         	Storage_policy::dispose(redo_data_, redo_bkp_);
         }
 
-        template <typename T, typename Storage_policy>
-        redoable<T, Storage_policy>& redoable<T, Storage_policy>::operator=(const redoable& other)
-        noexcept(noexcept(Storage_policy::copy_assign))
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 redoable<T, Storage_policy, Instrumentation>& redoable<T, Storage_policy, Instrumentation>::operator=(const redoable& other)
+        noexcept(undoable<T, Storage_policy, Instrumentation>::nothrow_copy_assign)
 		{
-        	undoable<T, Storage_policy>::operator=(other);
+        	undoable<T, Storage_policy, Instrumentation>::operator=(other);
         	Storage_policy::copy_assign(other.redo_data_, other.redo_bkp_, redo_data_, redo_bkp_);
         	return *this;
 		}
 
-        template <typename T, typename Storage_policy>
-        redoable<T, Storage_policy>& redoable<T, Storage_policy>::operator=(redoable&& other)
-        noexcept(noexcept(Storage_policy::move_assign))
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 redoable<T, Storage_policy, Instrumentation>& redoable<T, Storage_policy, Instrumentation>::operator=(redoable&& other)
+        noexcept(undoable<T, Storage_policy, Instrumentation>::nothrow_move_assign)
 		{
-        	undoable<T, Storage_policy>::operator=(std::move(other));
+        	undoable<T, Storage_policy, Instrumentation>::operator=(std::move(other));
         	Storage_policy::move_assign(std::move(other.redo_data_),
         			std::move(other.redo_bkp_),
         			redo_data_,
@@ -221,65 +615,134 @@ namespace mixme
         	return *this;
 		}
 
-        template <typename T, typename Storage_policy>
-        template <typename U>
-		redoable<T, Storage_policy>& redoable<T, Storage_policy>::operator=(U&& other)
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        template <typename U, typename std::enable_if_t<!std::is_base_of<redoable<T, Storage_policy, Instrumentation>, std::decay_t<U>>::value>*>
+		MIXME_CONSTEXPR20 redoable<T, Storage_policy, Instrumentation>& redoable<T, Storage_policy, Instrumentation>::operator=(U&& other)
         {
-        	undoable<T, Storage_policy>::operator=(std::forward<U>(other));
+        	undoable<T, Storage_policy, Instrumentation>::operator=(std::forward<U>(other));
         	return *this;
         }
 
-        template <typename T, typename Storage_policy>
-        bool redoable<T, Storage_policy>::undo()
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 bool redoable<T, Storage_policy, Instrumentation>::save()
+        {
+        	const auto token = this->instrumentation().enter(history_event::save);
+        	const bool kept = this->store_save();
+        	clear_edits();
+        	this->instrumentation().leave(history_event::save, token, kept, [this] { return estimated_history_bytes(); });
+            return kept;
+        }
+
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 void redoable<T, Storage_policy, Instrumentation>::clear_edits()
+        {
+        	if (has_edit())
+        	{
+        		clear_history(redo_data_, redo_bkp_, 0);
+        	}
+        }
+
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 bool redoable<T, Storage_policy, Instrumentation>::undo()
 		{
         	if (!this->has_save())
         	{
         		return false;
         	}
-        	Storage_policy::store(this->value(), redo_data_, redo_bkp_);
-        	undoable<T, Storage_policy>::undo();
+        	const auto token = this->instrumentation().enter(history_event::undo);
+        	const std::size_t previous_edits = edits();
+        	// The value is about to be overwritten, so it's moved to the edits rather than copied
+        	this->exchange_save(redo_data_, redo_bkp_);
+        	const bool kept = edits() > previous_edits;
+        	this->instrumentation().leave(history_event::undo, token, kept, [this] { return estimated_history_bytes(); });
         	return true;
 		}
 
-        template <typename T, typename Storage_policy>
-        bool redoable<T, Storage_policy>::redo()
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        MIXME_CONSTEXPR20 bool redoable<T, Storage_policy, Instrumentation>::redo()
 		{
         	if (!this->has_edit())
         	{
         		return false;
         	}
+        	const auto token = this->instrumentation().enter(history_event::redo);
         	Storage_policy::restore(this->value(), redo_data_, redo_bkp_);
+        	this->instrumentation().leave(history_event::redo, token, true, [this] { return estimated_history_bytes(); });
         	return true;
 		}
 
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        std::size_t redoable<T, Storage_policy, Instrumentation>::estimated_history_bytes() const
+		{
+        	return this->estimated_undo_bytes() + this->estimated_bytes(redo_bkp_, 0);
+		}
+
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        void redoable<T, Storage_policy, Instrumentation>::reserve(std::size_t n)
+		{
+        	undoable<T, Storage_policy, Instrumentation>::reserve(n);
+        	Storage_policy::reserve(redo_data_, redo_bkp_, n);
+		}
+
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        void redoable<T, Storage_policy, Instrumentation>::shrink_to_fit()
+		{
+        	undoable<T, Storage_policy, Instrumentation>::shrink_to_fit();
+        	Storage_policy::shrink_to_fit(redo_data_, redo_bkp_);
+		}
+
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        std::size_t redoable<T, Storage_policy, Instrumentation>::bytes_used() const
+		{
+        	return undoable<T, Storage_policy, Instrumentation>::bytes_used() + Storage_policy::bytes_used(redo_bkp_);
+		}
+
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        std::size_t redoable<T, Storage_policy, Instrumentation>::bytes_budget() const
+		{
+        	// Unlimited budgets stay unlimited
+        	const std::size_t saves_budget = undoable<T, Storage_policy, Instrumentation>::bytes_budget();
+        	const std::size_t edits_budget = Storage_policy::bytes_budget(redo_bkp_);
+        	return (saves_budget > std::numeric_limits<std::size_t>::max() - edits_budget)
+        			? std::numeric_limits<std::size_t>::max() : saves_budget + edits_budget;
+		}
+
+        template <typename T, typename Storage_policy, typename Instrumentation>
+        void redoable<T, Storage_policy, Instrumentation>::set_bytes_budget(std::size_t bytes)
+		{
+        	undoable<T, Storage_policy, Instrumentation>::set_bytes_budget(bytes);
+        	Storage_policy::set_bytes_budget(redo_data_, redo_bkp_, bytes);
+		}
+
         template <typename T>
-    	void single_element_storage<T>::copy_construct(const data_type& src,
+    	MIXME_CONSTEXPR20 void single_element_storage<T>::copy_construct(const data_type& src,
     			const bookkeeping_type& src_bkp,
     			data_type& dst,
 				bookkeeping_type& dst_bkp) noexcept(std::is_nothrow_copy_constructible<T>::value)
         {
         	if (src_bkp)
         	{
-        		new (dst) T(*reinterpret_cast<const T*>(src));
+        		detail::copy_raw<T>(src, dst, false);
         	}
         	dst_bkp = src_bkp;
         }
 
         template <typename T>
-    	void single_element_storage<T>::move_construct(data_type&& src,
+    	MIXME_CONSTEXPR20 void single_element_storage<T>::move_construct(data_type&& src,
     			bookkeeping_type&& src_bkp,
     			data_type& dst,
 				bookkeeping_type& dst_bkp) noexcept(std::is_nothrow_move_constructible<T>::value)
     	{
         	if (src_bkp)
         	{
-        		new (dst) T(std::move(*reinterpret_cast<T*>(src)));
+        		detail::relocate_raw<T>(src, dst, false);
         	}
-        	dst_bkp = std::move(src_bkp);
+        	dst_bkp = src_bkp;
+        	src_bkp = false;
     	}
 
         template <typename T>
-    	void single_element_storage<T>::copy_assign(const data_type& src,
+    	MIXME_CONSTEXPR20 void single_element_storage<T>::copy_assign(const data_type& src,
     			const bookkeeping_type& src_bkp,
     			data_type& dst,
 				bookkeeping_type& dst_bkp)
@@ -287,27 +750,20 @@ namespace mixme
         {
         	if (src_bkp)
         	{
-        		if (dst_bkp)
-        		{
-        			*reinterpret_cast<T*>(dst) = *reinterpret_cast<T*>(src);
-        		}
-        		else
-        		{
-        			new (dst) T(*reinterpret_cast<const T*>(src));
-        		}
+        		detail::copy_raw<T>(src, dst, dst_bkp);
         	}
         	else
         	{
         		if (dst_bkp)
         		{
-        			reinterpret_cast<T*>(dst)->~T();
+        			detail::destroy_raw<T>(dst);
         		}
         	}
         	dst_bkp = src_bkp;
         }
 
         template <typename T>
-    	void single_element_storage<T>::move_assign(data_type&& src,
+    	MIXME_CONSTEXPR20 void single_element_storage<T>::move_assign(data_type&& src,
     			bookkeeping_type&& src_bkp,
     			data_type& dst,
 				bookkeeping_type& dst_bkp)
@@ -315,73 +771,94 @@ namespace mixme
     	{
         	if (src_bkp)
         	{
-        		if (dst_bkp)
-        		{
-        			*reinterpret_cast<T*>(dst) = std::move(*reinterpret_cast<T*>(src));
-        		}
-        		else
-        		{
-        			new (dst) T(std::move(*reinterpret_cast<const T*>(src)));
-        		}
+        		detail::relocate_raw<T>(src, dst, dst_bkp);
         	}
         	else
         	{
         		if (dst_bkp)
         		{
-        			reinterpret_cast<T*>(dst)->~T();
+        			detail::destroy_raw<T>(dst);
         		}
         	}
-        	dst_bkp = std::move(src_bkp);
+        	dst_bkp = src_bkp;
+        	src_bkp = false;
     	}
 
         template <typename T>
-        void single_element_storage<T>::dispose(data_type& data, bookkeeping_type bkp) noexcept
+        MIXME_CONSTEXPR20 void single_element_storage<T>::dispose(data_type& data, bookkeeping_type bkp) noexcept
         {
         	if (bkp)
         	{
-        		reinterpret_cast<T*>(data)->~T();
+        		detail::destroy_raw<T>(data);
         	}
         }
 
         template <typename T>
-        void single_element_storage<T>::store(T& value, data_type& data, bookkeeping_type& bkp)
+        MIXME_CONSTEXPR20 void single_element_storage<T>::store(T& value, data_type& data, bookkeeping_type& bkp)
         {
 			detail::copy_or_move(value, data, bkp);
 			bkp = true;
         }
 
         template <typename T>
-        void single_element_storage<T>::restore(T& value, data_type& data, bookkeeping_type& bkp)
+        MIXME_CONSTEXPR20 void single_element_storage<T>::restore(T& value, data_type& data, bookkeeping_type& bkp)
+        noexcept(std::is_nothrow_move_assignable<T>::value)
         {
-        	value = std::move(*reinterpret_cast<T*>(data));
-        	reinterpret_cast<T*>(data)->~T();
+        	detail::restore_raw(value, data);
         	bkp = false;
         }
 
+        template <typename T>
+        MIXME_CONSTEXPR20 void single_element_storage<T>::exchange(T& value,
+        		data_type& from,
+				bookkeeping_type& from_bkp,
+				data_type& to,
+				bookkeeping_type& to_bkp)
+        {
+        	detail::exchange_raw(value, from, to, to_bkp);
+        	to_bkp = true;
+        	from_bkp = false;
+        }
+
+        template <typename T>
+        MIXME_CONSTEXPR20 void single_element_storage<T>::move_store(T& value, data_type& data, bookkeeping_type& bkp)
+        noexcept(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value)
+        {
+        	if (bkp)
+        	{
+        		data.value = std::move(value);
+        	}
+        	else
+        	{
+        		detail::construct_at(&data.value, std::move(value));
+        	}
+        	bkp = true;
+        }
+
         template <typename T, std::size_t N>
-    	void array_storage<T, N>::copy_construct(const data_type& src,
+    	MIXME_CONSTEXPR20 void array_storage<T, N>::copy_construct(const data_type& src,
     			const bookkeeping_type& src_bkp,
     			data_type& dst,
 				bookkeeping_type& dst_bkp)
 		noexcept(std::is_nothrow_copy_assignable<T>::value)
         {
-        	dst = src;
+        	detail::copy_elements(src, dst, 0, src_bkp);
         	dst_bkp = src_bkp;
         }
 
         template <typename T, std::size_t N>
-    	void array_storage<T, N>::move_construct(data_type&& src,
+    	MIXME_CONSTEXPR20 void array_storage<T, N>::move_construct(data_type&& src,
     			bookkeeping_type&& src_bkp,
     			data_type& dst,
 				bookkeeping_type& dst_bkp)
 		noexcept(std::is_nothrow_move_assignable<T>::value)
     	{
-        	dst = std::move(src);
+        	detail::move_elements(src, dst, 0, src_bkp);
         	dst_bkp = std::move(src_bkp);
     	}
 
         template <typename T, std::size_t N>
-    	void array_storage<T, N>::copy_assign(const data_type& src,
+    	MIXME_CONSTEXPR20 void array_storage<T, N>::copy_assign(const data_type& src,
     			const bookkeeping_type& src_bkp,
     			data_type& dst,
 				bookkeeping_type& dst_bkp)
@@ -391,7 +868,7 @@ namespace mixme
         }
 
         template <typename T, std::size_t N>
-    	void array_storage<T, N>::move_assign(data_type&& src,
+    	MIXME_CONSTEXPR20 void array_storage<T, N>::move_assign(data_type&& src,
     			bookkeeping_type&& src_bkp,
     			data_type& dst,
 				bookkeeping_type& dst_bkp)
@@ -401,21 +878,257 @@ namespace mixme
     	}
 
         template <typename T, std::size_t N>
-        void array_storage<T, N>::store(T& value, data_type& data, bookkeeping_type& bkp)
+        MIXME_CONSTEXPR20 void array_storage<T, N>::store(T& value, data_type& data, bookkeeping_type& bkp)
         {
-        	detail::copy_or_move(value, data[bkp]);
         	if (bkp < max_size(bkp))
         	{
+        		detail::copy_or_move(value, data[bkp]);
         		bkp++;
         	}
+        	else
+        	{
+        		// Full: overwrite the most recent element
+        		detail::copy_or_move(value, data[bkp - 1]);
+        	}
+        }
+
+        template <typename T, std::size_t N>
+        MIXME_CONSTEXPR20 void array_storage<T, N>::restore(T& value, data_type& data, bookkeeping_type& bkp)
+        noexcept(std::is_nothrow_move_assignable<T>::value)
+        {
+        	detail::restore_element(value, data[bkp - 1]);
+        	bkp--;
+        }
+
+        template <typename T, std::size_t N>
+        MIXME_CONSTEXPR20 void array_storage<T, N>::exchange(T& value,
+        		data_type& from,
+				bookkeeping_type& from_bkp,
+				data_type& to,
+				bookkeeping_type& to_bkp)
+        {
+        	// Full: overwrite the most recent element
+        	if (to_bkp < N)
+        	{
+        		to_bkp++;
+        	}
+        	detail::exchange_elements(value, from[from_bkp - 1], to[to_bkp - 1]);
+        	from_bkp--;
+        }
+
+        template <typename T, std::size_t N>
+        MIXME_CONSTEXPR20 void array_storage<T, N>::move_store(T& value, data_type& data, bookkeeping_type& bkp)
+        noexcept(std::is_nothrow_move_assignable<T>::value)
+        {
+        	// Full: overwrite the most recent element
+        	if (bkp < N)
+        	{
+        		bkp++;
+        	}
+        	detail::restore_element(data[bkp - 1], value);
+        }
+
+        template <typename T, std::size_t N>
+        MIXME_CONSTEXPR20 void array_storage<T, N>::clear(data_type& data, bookkeeping_type& bkp)
+        {
+        	detail::release_elements(data, 0, bkp);
+        	bkp = 0;
+        }
+
+        template <typename T, std::size_t N>
+    	MIXME_CONSTEXPR20 void ring_storage<T, N>::copy_construct(const data_type& src,
+    			const bookkeeping_type& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp)
+		noexcept(std::is_nothrow_copy_assignable<T>::value)
+        {
+        	detail::copy_elements(src, dst, src_bkp.first, src_bkp.count);
+        	dst_bkp = src_bkp;
+        }
+
+        template <typename T, std::size_t N>
+    	MIXME_CONSTEXPR20 void ring_storage<T, N>::move_construct(data_type&& src,
+    			bookkeeping_type&& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp)
+		noexcept(std::is_nothrow_move_assignable<T>::value)
+    	{
+        	detail::move_elements(src, dst, src_bkp.first, src_bkp.count);
+        	dst_bkp = std::move(src_bkp);
+    	}
+
+        template <typename T, std::size_t N>
+    	MIXME_CONSTEXPR20 void ring_storage<T, N>::copy_assign(const data_type& src,
+    			const bookkeeping_type& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp)
+		noexcept(std::is_nothrow_copy_assignable<T>::value)
+        {
+        	copy_construct(src, src_bkp, dst, dst_bkp);
+        }
+
+        template <typename T, std::size_t N>
+    	MIXME_CONSTEXPR20 void ring_storage<T, N>::move_assign(data_type&& src,
+    			bookkeeping_type&& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp)
+		noexcept(std::is_nothrow_move_assignable<T>::value)
+    	{
+        	move_construct(std::move(src), std::move(src_bkp), dst, dst_bkp);
+    	}
+
+        template <typename T, std::size_t N>
+        MIXME_CONSTEXPR20 void ring_storage<T, N>::store(T& value, data_type& data, bookkeeping_type& bkp)
+        {
+        	if (bkp.count < N)
+        	{
+        		detail::copy_or_move(value, data[slot(bkp.first + bkp.count)]);
+        		bkp.count++;
+        	}
+        	else
+        	{
+        		// Full: the oldest element becomes the newest
+        		detail::copy_or_move(value, data[bkp.first]);
+        		bkp.first = slot(bkp.first + 1);
+        	}
+        }
+
+        template <typename T, std::size_t N>
+        MIXME_CONSTEXPR20 void ring_storage<T, N>::restore(T& value, data_type& data, bookkeeping_type& bkp)
+        noexcept(std::is_nothrow_move_assignable<T>::value)
+        {
+        	detail::restore_element(value, data[slot(bkp.first + bkp.count - 1)]);
+        	bkp.count--;
+        }
+
+        template <typename T, std::size_t N>
+        MIXME_CONSTEXPR20 void ring_storage<T, N>::exchange(T& value,
+        		data_type& from,
+				bookkeeping_type& from_bkp,
+				data_type& to,
+				bookkeeping_type& to_bkp)
+        {
+        	T& last = from[slot(from_bkp.first + from_bkp.count - 1)];
+        	if (to_bkp.count < N)
+        	{
+        		detail::exchange_elements(value, last, to[slot(to_bkp.first + to_bkp.count)]);
+        		to_bkp.count++;
+        	}
+        	else
+        	{
+        		detail::exchange_elements(value, last, to[to_bkp.first]);
+        		to_bkp.first = slot(to_bkp.first + 1);
+        	}
+        	from_bkp.count--;
         }
 
         template <typename T, std::size_t N>
-        void array_storage<T, N>::restore(T& value, data_type& data, bookkeeping_type& bkp)
+        MIXME_CONSTEXPR20 void ring_storage<T, N>::move_store(T& value, data_type& data, bookkeeping_type& bkp)
+        noexcept(std::is_nothrow_move_assignable<T>::value)
         {
-        	value = std::move(data[bkp - 1]);
+        	if (bkp.count < N)
+        	{
+        		detail::restore_element(data[slot(bkp.first + bkp.count)], value);
+        		bkp.count++;
+        	}
+        	else
+        	{
+        		detail::restore_element(data[bkp.first], value);
+        		bkp.first = slot(bkp.first + 1);
+        	}
+        }
+
+        template <typename T, std::size_t N>
+        MIXME_CONSTEXPR20 void ring_storage<T, N>::clear(data_type& data, bookkeeping_type& bkp)
+        {
+        	detail::release_elements(data, bkp.first, bkp.count);
+        	bkp = bookkeeping_type();
+        }
+
+        template <typename T, typename Alloc>
+    	void vector_storage<T, Alloc>::copy_construct(const data_type& src,
+    			const bookkeeping_type& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp)
+        {
+        	// dst is still empty: rebuild it with the allocator the copy would select
+        	data_type copy(src, std::allocator_traits<Alloc>::select_on_container_copy_construction(src.get_allocator()));
+        	dst.~data_type();
+        	new (&dst) data_type(std::move(copy));
+        	dst_bkp = src_bkp;
+        }
+
+        template <typename T, typename Alloc>
+    	void vector_storage<T, Alloc>::move_construct(data_type&& src,
+    			bookkeeping_type&& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp) noexcept
+    	{
+        	dst.~data_type();
+        	new (&dst) data_type(std::move(src));
+        	dst_bkp = src_bkp;
+        	src.clear();
+        	src_bkp = 0;
+    	}
+
+        template <typename T, typename Alloc>
+    	void vector_storage<T, Alloc>::copy_assign(const data_type& src,
+    			const bookkeeping_type& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp)
+        {
+        	dst = src;
+        	dst_bkp = src_bkp;
+        }
+
+        template <typename T, typename Alloc>
+    	void vector_storage<T, Alloc>::move_assign(data_type&& src,
+    			bookkeeping_type&& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp)
+		noexcept(std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+				std::allocator_traits<Alloc>::is_always_equal::value)
+    	{
+        	dst = std::move(src);
+        	dst_bkp = src_bkp;
+        	src.clear();
+        	src_bkp = 0;
+    	}
+
+        template <typename T, typename Alloc>
+        void vector_storage<T, Alloc>::store(T& value, data_type& data, bookkeeping_type& bkp)
+        {
+        	data.push_back(detail::copy_or_move_ref(value));
+        	bkp++;
+        }
+
+        template <typename T, typename Alloc>
+        void vector_storage<T, Alloc>::restore(T& value, data_type& data, bookkeeping_type& bkp)
+        noexcept(std::is_nothrow_move_assignable<T>::value)
+        {
+        	value = std::move(data.back());
+        	data.pop_back();
         	bkp--;
         }
+
+        template <typename T, typename Alloc>
+        void vector_storage<T, Alloc>::exchange(T& value,
+        		data_type& from,
+				bookkeeping_type& from_bkp,
+				data_type& to,
+				bookkeeping_type& to_bkp)
+        {
+        	to.push_back(std::move(value));
+        	to_bkp++;
+        	restore(value, from, from_bkp);
+        }
+
+        template <typename T, typename Alloc>
+        void vector_storage<T, Alloc>::move_store(T& value, data_type& data, bookkeeping_type& bkp)
+        {
+        	data.push_back(std::move(value));
+        	bkp++;
+        }
     }
 }
 
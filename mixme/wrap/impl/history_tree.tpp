@@ -0,0 +1,245 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_HISTORY_TREE_TPP_
+#define MIXME_WRAP_HISTORY_TREE_TPP_
+
+namespace mixme
+{
+    namespace wrap
+    {
+        template <typename T, typename Pruning_policy>
+        constexpr typename history_tree<T, Pruning_policy>::node_id history_tree<T, Pruning_policy>::no_node;
+
+        template <typename T, typename Pruning_policy>
+        template <typename... Args>
+        history_tree<T, Pruning_policy>::history_tree(std::piecewise_construct_t, Args&&... args)
+		: value_(std::make_shared<T>(std::forward<Args>(args)...))
+        {
+        	node& root = nodes_.emplace(root_, node{value_, no_node, {}, no_node, clock_, {}}).first->second;
+        	root.leaf = leaves_.emplace(clock_, root_).first;
+        }
+
+        template <typename T, typename Pruning_policy>
+        history_tree<T, Pruning_policy>::history_tree(const history_tree& other)
+		: nodes_(other.nodes_),
+		  value_(other.dirty_ ? std::make_shared<T>(*other.value_) : other.value_),
+		  current_(other.current_),
+		  root_(other.root_),
+		  next_id_(other.next_id_),
+		  clock_(other.clock_),
+		  dirty_(other.dirty_)
+        {
+        	// The copied nodes point to the leaves of other
+        	for (auto& i : nodes_)
+        	{
+        		if (i.second.children.empty())
+        		{
+        			i.second.leaf = leaves_.emplace(i.second.visited, i.first).first;
+        		}
+        	}
+        }
+
+        template <typename T, typename Pruning_policy>
+        history_tree<T, Pruning_policy>& history_tree<T, Pruning_policy>::operator=(const history_tree& other)
+        {
+        	if (this != &other)
+        	{
+        		history_tree copy(other);
+        		*this = std::move(copy);
+        	}
+        	return *this;
+        }
+
+        template <typename T, typename Pruning_policy>
+        template <typename U, typename std::enable_if_t<!std::is_same<history_tree<T, Pruning_policy>, std::decay_t<U>>::value>*>
+        history_tree<T, Pruning_policy>& history_tree<T, Pruning_policy>::operator=(U&& value)
+        {
+        	value_ = std::make_shared<T>(std::forward<U>(value));
+        	dirty_ = true;
+        	return *this;
+        }
+
+        template <typename T, typename Pruning_policy>
+        T& history_tree<T, Pruning_policy>::value()
+        {
+        	if (!dirty_)
+        	{
+        		value_ = std::make_shared<T>(*value_);
+        		dirty_ = true;
+        	}
+        	return *value_;
+        }
+
+        template <typename T, typename Pruning_policy>
+        typename history_tree<T, Pruning_policy>::node_id history_tree<T, Pruning_policy>::save()
+        {
+        	if (!dirty_)
+        	{
+        		return current_;
+        	}
+        	node& parent = nodes_.at(current_);
+        	parent.children.reserve(parent.children.size() + 1);
+        	const node_id id = next_id_;
+        	// The new node is the most recently visited
+        	const typename leaf_map::iterator leaf = leaves_.emplace_hint(leaves_.end(), clock_ + 1, id);
+        	try
+        	{
+        		nodes_.emplace(id, node{value_, current_, {}, no_node, ++clock_, leaf});
+        	}
+        	catch (...)
+        	{
+        		leaves_.erase(leaf);
+        		throw;
+        	}
+        	// Rehashing doesn't invalidate references to the elements
+        	if (parent.children.empty())
+        	{
+        		leaves_.erase(parent.leaf);
+        	}
+        	parent.children.push_back(id);
+        	parent.last_child = id;
+        	next_id_++;
+        	current_ = id;
+        	dirty_ = false;
+        	prune();
+        	return current_;
+        }
+
+        template <typename T, typename Pruning_policy>
+        bool history_tree<T, Pruning_policy>::undo()
+        {
+        	save();
+        	const node_id parent = nodes_.at(current_).parent;
+        	if (parent == no_node)
+        	{
+        		return false;
+        	}
+        	nodes_.at(parent).last_child = current_;
+        	move_to(parent);
+        	return true;
+        }
+
+        template <typename T, typename Pruning_policy>
+        bool history_tree<T, Pruning_policy>::redo()
+        {
+        	save();
+        	const node_id child = nodes_.at(current_).last_child;
+        	if (child == no_node)
+        	{
+        		return false;
+        	}
+        	move_to(child);
+        	return true;
+        }
+
+        template <typename T, typename Pruning_policy>
+        bool history_tree<T, Pruning_policy>::redo(std::size_t branch)
+        {
+        	save();
+        	node& current = nodes_.at(current_);
+        	if (branch >= current.children.size())
+        	{
+        		return false;
+        	}
+        	current.last_child = current.children[branch];
+        	move_to(current.last_child);
+        	return true;
+        }
+
+        template <typename T, typename Pruning_policy>
+        bool history_tree<T, Pruning_policy>::go_to(node_id id)
+        {
+        	if (!contains(id))
+        	{
+        		return false;
+        	}
+        	// Saving may prune the target
+        	save();
+        	if (!contains(id))
+        	{
+        		return false;
+        	}
+        	move_to(id);
+        	return true;
+        }
+
+        template <typename T, typename Pruning_policy>
+        typename history_tree<T, Pruning_policy>::node_id history_tree<T, Pruning_policy>::parent(node_id id) const
+        {
+        	return nodes_.at(id).parent;
+        }
+
+        template <typename T, typename Pruning_policy>
+        const std::vector<typename history_tree<T, Pruning_policy>::node_id>&
+		history_tree<T, Pruning_policy>::children(node_id id) const
+        {
+        	return nodes_.at(id).children;
+        }
+
+        template <typename T, typename Pruning_policy>
+        void history_tree<T, Pruning_policy>::move_to(node_id id)
+        {
+        	node& target = nodes_.at(id);
+        	// The states are never modified: mutable access copies them first
+        	value_ = std::const_pointer_cast<T>(target.value);
+        	target.visited = ++clock_;
+        	if (target.children.empty())
+        	{
+        		leaves_.erase(target.leaf);
+        		target.leaf = leaves_.emplace_hint(leaves_.end(), target.visited, id);
+        	}
+        	current_ = id;
+        	dirty_ = false;
+        }
+
+        template <typename T, typename Pruning_policy>
+        void history_tree<T, Pruning_policy>::prune()
+        {
+        	while (Pruning_policy::over(nodes_.size()))
+        	{
+        		// Every leaf but the current state is on another branch. The current state was visited last
+        		const node_id victim = leaves_.begin()->second;
+        		if (victim != current_)
+        		{
+        			const node& leaf = nodes_.at(victim);
+        			node& parent = nodes_.at(leaf.parent);
+        			if (parent.children.size() == 1)
+        			{
+        				parent.leaf = leaves_.emplace(parent.visited, leaf.parent).first;
+        			}
+        			parent.children.erase(std::find(parent.children.begin(), parent.children.end(), victim));
+        			if (parent.last_child == victim)
+        			{
+        				parent.last_child = (parent.children.empty()) ? no_node : parent.children.back();
+        			}
+        			leaves_.erase(leaf.leaf);
+        			nodes_.erase(victim);
+        		}
+        		else if (root_ != current_)
+        		{
+        			// Only the current branch is left: the oldest state goes
+        			const node_id child = nodes_.at(root_).children.front();
+        			nodes_.at(child).parent = no_node;
+        			nodes_.erase(root_);
+        			root_ = child;
+        		}
+        		else
+        		{
+        			break;
+        		}
+        	}
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,185 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_INSTRUMENTATION_TPP_
+#define MIXME_WRAP_INSTRUMENTATION_TPP_
+
+#include <utility>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	inline history_stats& history_stats::operator+=(const history_stats& other) noexcept
+    	{
+    		saves += other.saves;
+    		undos += other.undos;
+    		redos += other.redos;
+    		dropped += other.dropped;
+    		estimated_history_bytes += other.estimated_history_bytes;
+    		for (std::size_t i = 0; i < save_latency.size(); ++i)
+    		{
+    			save_latency[i] += other.save_latency[i];
+    			undo_latency[i] += other.undo_latency[i];
+    			redo_latency[i] += other.redo_latency[i];
+    		}
+    		return *this;
+    	}
+
+    	inline void detail::spin_mutex::lock() noexcept
+    	{
+    		while (flag_.test_and_set(std::memory_order_acquire))
+    		{
+    			std::this_thread::yield();
+    		}
+    	}
+
+    	inline counting_instrumentation::counting_instrumentation() noexcept
+    	{
+    		instrumentation_registry::instance().add(*this);
+    	}
+
+    	inline counting_instrumentation::~counting_instrumentation()
+    	{
+    		instrumentation_registry::instance().remove(*this);
+    	}
+
+    	template <typename F>
+    	void counting_instrumentation::leave(history_event event, clock::time_point start, bool kept, F&& estimated_history_bytes) noexcept
+    	{
+    		const clock::duration latency = clock::now() - start;
+    		switch (event)
+    		{
+    		case history_event::save:
+    			saves_.fetch_add(1, std::memory_order_relaxed);
+    			record(save_latency_, latency);
+    			break;
+    		case history_event::undo:
+    			undos_.fetch_add(1, std::memory_order_relaxed);
+    			record(undo_latency_, latency);
+    			break;
+    		case history_event::redo:
+    			redos_.fetch_add(1, std::memory_order_relaxed);
+    			record(redo_latency_, latency);
+    			break;
+    		}
+    		if (!kept)
+    		{
+    			dropped_.fetch_add(1, std::memory_order_relaxed);
+    		}
+    		estimated_history_bytes_.store(std::forward<F>(estimated_history_bytes)(), std::memory_order_relaxed);
+    	}
+
+    	inline void counting_instrumentation::record(std::array<counter, 32>& histogram, clock::duration latency) noexcept
+    	{
+    		std::uint64_t nanoseconds = static_cast<std::uint64_t>(
+    				std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+    		std::size_t bucket = 0;
+    		while (nanoseconds > 1 && bucket + 1 < histogram.size())
+    		{
+    			nanoseconds >>= 1;
+    			++bucket;
+    		}
+    		histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    	}
+
+    	inline history_stats counting_instrumentation::stats() const noexcept
+    	{
+    		history_stats result;
+    		result.saves = saves_.load(std::memory_order_relaxed);
+    		result.undos = undos_.load(std::memory_order_relaxed);
+    		result.redos = redos_.load(std::memory_order_relaxed);
+    		result.dropped = dropped_.load(std::memory_order_relaxed);
+    		result.estimated_history_bytes = estimated_history_bytes_.load(std::memory_order_relaxed);
+    		for (std::size_t i = 0; i < result.save_latency.size(); ++i)
+    		{
+    			result.save_latency[i] = save_latency_[i].load(std::memory_order_relaxed);
+    			result.undo_latency[i] = undo_latency_[i].load(std::memory_order_relaxed);
+    			result.redo_latency[i] = redo_latency_[i].load(std::memory_order_relaxed);
+    		}
+    		return result;
+    	}
+
+    	inline instrumentation_registry& instrumentation_registry::instance() noexcept
+    	{
+    		// Never destroyed, instances may outlive static destruction
+    		static instrumentation_registry* registry = new instrumentation_registry();
+    		return *registry;
+    	}
+
+    	inline std::size_t instrumentation_registry::size() const
+    	{
+    		std::lock_guard<detail::spin_mutex> lock(mutex_);
+    		std::size_t count = 0;
+    		for (const counting_instrumentation* i = first_; i; i = i->next_)
+    		{
+    			++count;
+    		}
+    		return count;
+    	}
+
+    	inline history_stats instrumentation_registry::total() const
+    	{
+    		std::lock_guard<detail::spin_mutex> lock(mutex_);
+    		history_stats result = retired_;
+    		for (const counting_instrumentation* i = first_; i; i = i->next_)
+    		{
+    			result += i->stats();
+    		}
+    		return result;
+    	}
+
+    	template <typename F>
+    	void instrumentation_registry::for_each(F&& f) const
+    	{
+    		std::lock_guard<detail::spin_mutex> lock(mutex_);
+    		for (const counting_instrumentation* i = first_; i; i = i->next_)
+    		{
+    			f(i->stats());
+    		}
+    	}
+
+    	inline void instrumentation_registry::add(counting_instrumentation& instance) noexcept
+    	{
+    		std::lock_guard<detail::spin_mutex> lock(mutex_);
+    		instance.next_ = first_;
+    		if (first_)
+    		{
+    			first_->previous_ = &instance;
+    		}
+    		first_ = &instance;
+    	}
+
+    	inline void instrumentation_registry::remove(counting_instrumentation& instance) noexcept
+    	{
+    		// A destroyed instance holds no history
+    		history_stats stats = instance.stats();
+    		stats.estimated_history_bytes = 0;
+    		std::lock_guard<detail::spin_mutex> lock(mutex_);
+    		retired_ += stats;
+    		if (instance.previous_)
+    		{
+    			instance.previous_->next_ = instance.next_;
+    		}
+    		else
+    		{
+    			first_ = instance.next_;
+    		}
+    		if (instance.next_)
+    		{
+    			instance.next_->previous_ = instance.previous_;
+    		}
+    	}
+    }
+}
+
+#endif
@@ -0,0 +1,283 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef MIXME_WRAP_JOURNALED_TPP_
+#define MIXME_WRAP_JOURNALED_TPP_
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	namespace detail
+		{
+    		template <typename T>
+    		template <typename Operation>
+    		struct journal_entry<T>::model
+			{
+    			static_assert(std::is_copy_constructible<Operation>::value, "journaled operations must be copy constructible");
+
+    			using inverse_type = std::decay_t<decltype(std::declval<Operation>()(std::declval<T&>()))>;
+
+    			static_assert(!std::is_void<inverse_type>::value, "journaled operations must return their inverse");
+
+    			static Operation& get(storage_type& storage) noexcept { return get(storage, is_inline<Operation>()); }
+
+    			static Operation& get(storage_type& storage, std::true_type) noexcept
+    			{
+    				return *reinterpret_cast<Operation*>(&storage);
+    			}
+
+    			static Operation& get(storage_type& storage, std::false_type) noexcept
+    			{
+    				return **reinterpret_cast<Operation**>(&storage);
+    			}
+
+    			template <typename U>
+    			static void create(storage_type& storage, U&& operation, std::true_type)
+    			{
+    				::new (static_cast<void*>(&storage)) Operation(std::forward<U>(operation));
+    			}
+
+    			template <typename U>
+    			static void create(storage_type& storage, U&& operation, std::false_type)
+    			{
+    				::new (static_cast<void*>(&storage)) Operation*(new Operation(std::forward<U>(operation)));
+    			}
+
+    			static void copy(const storage_type& src, storage_type& dst)
+    			{
+    				create(dst, static_cast<const Operation&>(get(const_cast<storage_type&>(src))), is_inline<Operation>());
+    			}
+
+    			static void move(storage_type& src, storage_type& dst) noexcept
+    			{
+    				if (is_inline<Operation>::value)
+    				{
+    					create(dst, std::move(get(src)), is_inline<Operation>());
+    					get(src).~Operation();
+    				}
+    				else
+    				{
+    					// Only the pointer moves
+    					std::memcpy(&dst, &src, sizeof(Operation*));
+    				}
+    			}
+
+    			static void destroy(storage_type& storage) noexcept
+    			{
+    				if (is_inline<Operation>::value)
+    				{
+    					get(storage).~Operation();
+    				}
+    				else
+    				{
+    					delete &get(storage);
+    				}
+    			}
+
+    			static journal_entry apply(storage_type& storage, T& value)
+    			{
+    				return journal_entry(std::move(get(storage))(value));
+    			}
+
+    			static const operations* table() noexcept
+    			{
+    				static const operations ops = {&copy, &move, &destroy, &apply};
+    				return &ops;
+    			}
+			};
+
+    		template <typename T>
+    		template <typename Operation, typename std::enable_if_t<!std::is_same<journal_entry<T>, std::decay_t<Operation>>::value>*>
+    		journal_entry<T>::journal_entry(Operation&& operation)
+    		{
+    			using model_type = model<std::decay_t<Operation>>;
+    			model_type::create(storage_, std::forward<Operation>(operation), is_inline<std::decay_t<Operation>>());
+    			ops_ = model_type::table();
+    		}
+
+    		template <typename T>
+    		journal_entry<T>::journal_entry(const journal_entry& other)
+    		{
+    			if (other.ops_)
+    			{
+    				other.ops_->copy(other.storage_, storage_);
+    				ops_ = other.ops_;
+    			}
+    		}
+
+    		template <typename T>
+    		journal_entry<T>::journal_entry(journal_entry&& other) noexcept
+    		{
+    			if (other.ops_)
+    			{
+    				other.ops_->move(other.storage_, storage_);
+    				ops_ = other.ops_;
+    				other.ops_ = nullptr;
+    			}
+    		}
+
+    		template <typename T>
+    		journal_entry<T>& journal_entry<T>::operator=(const journal_entry& other)
+    		{
+    			if (this != &other)
+    			{
+    				journal_entry copy(other);
+    				*this = std::move(copy);
+    			}
+    			return *this;
+    		}
+
+    		template <typename T>
+    		journal_entry<T>& journal_entry<T>::operator=(journal_entry&& other) noexcept
+    		{
+    			if (this != &other)
+    			{
+    				if (ops_)
+    				{
+    					ops_->destroy(storage_);
+    					ops_ = nullptr;
+    				}
+    				if (other.ops_)
+    				{
+    					other.ops_->move(other.storage_, storage_);
+    					ops_ = other.ops_;
+    					other.ops_ = nullptr;
+    				}
+    			}
+    			return *this;
+    		}
+
+    		template <typename T>
+    		journal_entry<T>::~journal_entry()
+    		{
+    			if (ops_)
+    			{
+    				ops_->destroy(storage_);
+    			}
+    		}
+
+    		template <typename T>
+    		journal_entry<T> journal_entry<T>::apply(T& value)
+    		{
+    			return ops_->apply(storage_, value);
+    		}
+		}
+
+        template <typename T>
+        journaled<T>::journaled(journaled&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+		: base<T>(std::move(other)),
+		  undo_log_(std::move(other.undo_log_)),
+		  redo_log_(std::move(other.redo_log_)),
+		  saves_(other.saves_),
+		  edits_(other.edits_)
+        {
+        	other.undo_log_.clear();
+        	other.redo_log_.clear();
+        	other.saves_ = 0;
+        	other.edits_ = 0;
+        }
+
+        template <typename T>
+        journaled<T>& journaled<T>::operator=(journaled&& other) noexcept(std::is_nothrow_move_assignable<T>::value)
+        {
+        	if (this != &other)
+        	{
+        		base<T>::operator=(std::move(other));
+        		undo_log_ = std::move(other.undo_log_);
+        		redo_log_ = std::move(other.redo_log_);
+        		saves_ = other.saves_;
+        		edits_ = other.edits_;
+        		other.undo_log_.clear();
+        		other.redo_log_.clear();
+        		other.saves_ = 0;
+        		other.edits_ = 0;
+        	}
+        	return *this;
+        }
+
+        template <typename T>
+        template <typename Operation>
+        void journaled<T>::execute(Operation&& operation)
+        {
+        	T& value = base<T>::value();
+        	auto inverse = std::forward<Operation>(operation)(value);
+        	redo_log_.clear();
+        	edits_ = 0;
+        	if (has_save())
+        	{
+        		try
+        		{
+        			undo_log_.emplace_back(std::move(inverse));
+        		}
+        		catch (...)
+        		{
+        			// Without its inverse the operation couldn't be undone
+        			std::move(inverse)(value);
+        			throw;
+        		}
+        	}
+        }
+
+        template <typename T>
+        void journaled<T>::save()
+        {
+        	undo_log_.emplace_back();
+        	saves_++;
+        	redo_log_.clear();
+        	edits_ = 0;
+        }
+
+        template <typename T>
+        bool journaled<T>::undo()
+        {
+        	if (!has_save())
+        	{
+        		return false;
+        	}
+        	redo_log_.emplace_back();
+        	replay(base<T>::value(), undo_log_, redo_log_);
+        	saves_--;
+        	edits_++;
+        	return true;
+        }
+
+        template <typename T>
+        bool journaled<T>::redo()
+        {
+        	if (!has_edit())
+        	{
+        		return false;
+        	}
+        	undo_log_.emplace_back();
+        	replay(base<T>::value(), redo_log_, undo_log_);
+        	edits_--;
+        	saves_++;
+        	return true;
+        }
+
+        template <typename T>
+        void journaled<T>::replay(T& value, std::vector<entry_type>& from, std::vector<entry_type>& to)
+        {
+        	while (!from.back().marker())
+        	{
+        		entry_type entry = std::move(from.back());
+        		from.pop_back();
+        		to.push_back(entry.apply(value));
+        	}
+        	from.pop_back();
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,153 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_POOLED_STORAGE_TPP_
+#define MIXME_WRAP_POOLED_STORAGE_TPP_
+
+#include <utility>
+#include <vector>
+#include <mixme/wrap/history.hpp>
+
+namespace mixme
+{
+    namespace wrap
+    {
+        template <typename T, std::size_t N>
+        template <typename U>
+        typename pooled_storage<T, N>::node* pooled_storage<T, N>::push(U&& value, node* previous)
+        {
+        	void* memory = pool::allocate();
+        	try
+        	{
+        		return new (memory) node(std::forward<U>(value), previous);
+        	}
+        	catch (...)
+        	{
+        		pool::deallocate(memory);
+        		throw;
+        	}
+        }
+
+        template <typename T, std::size_t N>
+        typename pooled_storage<T, N>::node* pooled_storage<T, N>::pop(node* top) noexcept
+        {
+        	node* previous = top->previous;
+        	top->~node();
+        	pool::deallocate(top);
+        	return previous;
+        }
+
+        template <typename T, std::size_t N>
+        typename pooled_storage<T, N>::node* pooled_storage<T, N>::clone(const node* top)
+        {
+        	// Walks the chain iteratively: deep histories would overflow the stack if recursing
+        	std::vector<const node*> chain;
+        	chain.reserve((top) ? top->depth : 0);
+        	for (; top; top = top->previous)
+        	{
+        		chain.push_back(top);
+        	}
+        	node* copy = nullptr;
+        	try
+        	{
+        		for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+        		{
+        			copy = push((*it)->value, copy);
+        		}
+        	}
+        	catch (...)
+        	{
+        		data_type none;
+        		dispose(none, copy);
+        		throw;
+        	}
+        	return copy;
+        }
+
+        template <typename T, std::size_t N>
+    	void pooled_storage<T, N>::copy_construct(const data_type&,
+    			const bookkeeping_type& src_bkp,
+    			data_type&,
+				bookkeeping_type& dst_bkp)
+        {
+        	dst_bkp = clone(src_bkp);
+        }
+
+        template <typename T, std::size_t N>
+    	void pooled_storage<T, N>::move_construct(data_type&&,
+    			bookkeeping_type&& src_bkp,
+    			data_type&,
+				bookkeeping_type& dst_bkp) noexcept
+    	{
+        	dst_bkp = src_bkp;
+        	src_bkp = nullptr;
+    	}
+
+        template <typename T, std::size_t N>
+    	void pooled_storage<T, N>::copy_assign(const data_type& src,
+    			const bookkeeping_type& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp)
+        {
+        	node* copy = clone(src_bkp);
+        	dispose(dst, dst_bkp);
+        	dst_bkp = copy;
+        }
+
+        template <typename T, std::size_t N>
+    	void pooled_storage<T, N>::move_assign(data_type&& src,
+    			bookkeeping_type&& src_bkp,
+    			data_type& dst,
+				bookkeeping_type& dst_bkp) noexcept
+    	{
+        	if (&src_bkp != &dst_bkp)
+        	{
+        		dispose(dst, dst_bkp);
+        		dst_bkp = src_bkp;
+        		src_bkp = nullptr;
+        	}
+    	}
+
+        template <typename T, std::size_t N>
+        void pooled_storage<T, N>::dispose(data_type&, bookkeeping_type bkp) noexcept
+        {
+        	while (bkp)
+        	{
+        		bkp = pop(bkp);
+        	}
+        }
+
+        template <typename T, std::size_t N>
+        void pooled_storage<T, N>::store(T& value, data_type&, bookkeeping_type& bkp)
+        {
+        	if (size(bkp) < N)
+        	{
+        		bkp = push(detail::copy_or_move_ref(value), bkp);
+        	}
+        	else
+        	{
+        		// Full: overwrite the most recent element
+        		detail::copy_or_move(value, bkp->value);
+        	}
+        }
+
+        template <typename T, std::size_t N>
+        void pooled_storage<T, N>::restore(T& value, data_type&, bookkeeping_type& bkp)
+        noexcept(std::is_nothrow_move_assignable<T>::value)
+        {
+        	value = std::move(bkp->value);
+        	bkp = pop(bkp);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,145 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_TIERED_STORAGE_TPP_
+#define MIXME_WRAP_TIERED_STORAGE_TPP_
+
+#include <utility>
+#include <mixme/wrap/history.hpp>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	namespace detail
+		{
+			template <typename T, std::size_t N, std::size_t Hot, typename Traits, typename Cold>
+			std::vector<unsigned char>& tiered_storage<T, N, Hot, Traits, Cold>::scratch()
+			{
+				thread_local std::vector<unsigned char> buffer;
+				buffer.clear();
+				return buffer;
+			}
+
+			template <typename T, std::size_t N, std::size_t Hot, typename Traits, typename Cold>
+			void tiered_storage<T, N, Hot, Traits, Cold>::copy_construct(const data_type& src,
+					const bookkeeping_type& src_bkp,
+					data_type& dst,
+					bookkeeping_type& dst_bkp)
+			{
+				dst = src;
+				dst_bkp = src_bkp;
+			}
+
+			template <typename T, std::size_t N, std::size_t Hot, typename Traits, typename Cold>
+			void tiered_storage<T, N, Hot, Traits, Cold>::move_construct(data_type&& src,
+					bookkeeping_type&& src_bkp,
+					data_type& dst,
+					bookkeeping_type& dst_bkp) noexcept
+			{
+				dst = std::move(src);
+				dst_bkp = src_bkp;
+				src.cold.clear();
+				src.hot.clear();
+				src_bkp = bookkeeping_type();
+			}
+
+			template <typename T, std::size_t N, std::size_t Hot, typename Traits, typename Cold>
+			void tiered_storage<T, N, Hot, Traits, Cold>::copy_assign(const data_type& src,
+					const bookkeeping_type& src_bkp,
+					data_type& dst,
+					bookkeeping_type& dst_bkp)
+			{
+				copy_construct(src, src_bkp, dst, dst_bkp);
+			}
+
+			template <typename T, std::size_t N, std::size_t Hot, typename Traits, typename Cold>
+			void tiered_storage<T, N, Hot, Traits, Cold>::move_assign(data_type&& src,
+					bookkeeping_type&& src_bkp,
+					data_type& dst,
+					bookkeeping_type& dst_bkp) noexcept
+			{
+				move_construct(std::move(src), std::move(src_bkp), dst, dst_bkp);
+			}
+
+			template <typename T, std::size_t N, std::size_t Hot, typename Traits, typename Cold>
+			void tiered_storage<T, N, Hot, Traits, Cold>::store(T& value, data_type& data, bookkeeping_type& bkp)
+			{
+				if (bkp.count == N && data.cold.empty())
+				{
+					// Only with Hot == N: the oldest element is evicted rather than serialized
+					data.hot.push_back(detail::copy_or_move_ref(value));
+					data.hot.pop_front();
+					return;
+				}
+				if (data.hot.size() < Hot)
+				{
+					data.hot.push_back(detail::copy_or_move_ref(value));
+				}
+				else
+				{
+					// The oldest hot element, or the new one if none is kept, cools down.
+					// Everything that may throw happens before the history changes
+					std::vector<unsigned char>& raw = scratch();
+					Traits::serialize((Hot > 0) ? data.hot.front() : value, raw);
+					typename Cold::block_type block = Cold::prepare(raw);
+					const std::size_t block_bytes = Cold::bytes(block);
+					data.cold.push_back(std::move(block));
+					if (Hot > 0)
+					{
+						try
+						{
+							data.hot.push_back(detail::copy_or_move_ref(value));
+						}
+						catch (...)
+						{
+							data.cold.pop_back();
+							throw;
+						}
+						data.hot.pop_front();
+					}
+					bkp.cold_bytes += block_bytes;
+				}
+				if (bkp.count < N)
+				{
+					bkp.count++;
+				}
+				else
+				{
+					bkp.cold_bytes -= data.cold.front_bytes();
+					data.cold.pop_front();
+				}
+			}
+
+			template <typename T, std::size_t N, std::size_t Hot, typename Traits, typename Cold>
+			void tiered_storage<T, N, Hot, Traits, Cold>::restore(T& value, data_type& data, bookkeeping_type& bkp)
+			{
+				if (!data.hot.empty())
+				{
+					value = std::move(data.hot.back());
+					data.hot.pop_back();
+				}
+				else
+				{
+					std::size_t size = 0;
+					const unsigned char* bytes = data.cold.back(scratch(), size);
+					Traits::deserialize(bytes, size, value);
+					bkp.cold_bytes -= data.cold.back_bytes();
+					data.cold.pop_back();
+				}
+				bkp.count--;
+			}
+		}
+    }
+}
+
+#endif
@@ -0,0 +1,142 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_TRACKED_TPP_
+#define MIXME_WRAP_TRACKED_TPP_
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	namespace detail
+		{
+    		template <auto Member>
+    		using member_constant = std::integral_constant<decltype(Member), Member>;
+		}
+
+        template <typename T, auto... Members>
+        template <auto Member>
+        constexpr std::size_t tracked<T, Members...>::index_of() noexcept
+        {
+        	constexpr bool matches[] = {std::is_same<detail::member_constant<Member>, detail::member_constant<Members>>::value...};
+        	std::size_t i = 0;
+        	while (i < size && !matches[i])
+        	{
+        		++i;
+        	}
+        	return i;
+        }
+
+        template <typename T, auto... Members>
+        template <typename F, std::size_t... I>
+        void tracked<T, Members...>::for_each(const mask_type& mask, F&& f, std::index_sequence<I...>)
+        {
+        	((mask[I] ? f(std::integral_constant<std::size_t, I>()) : void()), ...);
+        }
+
+        template <typename T, auto... Members>
+        template <typename U, typename std::enable_if_t<!std::is_same<tracked<T, Members...>, std::decay_t<U>>::value>*>
+        tracked<T, Members...>& tracked<T, Members...>::operator=(U&& value)
+        {
+        	value_ = std::forward<U>(value);
+        	dirty_.set();
+        	return *this;
+        }
+
+        template <typename T, auto... Members>
+        template <auto Member, typename U>
+        void tracked<T, Members...>::set(U&& value)
+        {
+        	static_assert(index_of<Member>() < size, "the member isn't tracked");
+        	value_.*Member = std::forward<U>(value);
+        	dirty_.set(index_of<Member>());
+        }
+
+        template <typename T, auto... Members>
+        template <auto Member, typename F>
+        void tracked<T, Members...>::modify(F&& f)
+        {
+        	static_assert(index_of<Member>() < size, "the member isn't tracked");
+        	// Marked first, f may have written before throwing
+        	dirty_.set(index_of<Member>());
+        	std::forward<F>(f)(value_.*Member);
+        }
+
+        template <typename T, auto... Members>
+        bool tracked<T, Members...>::save()
+        {
+        	records_.reserve(records_.size() + 1);
+        	// The shadow becomes the new save state, keeping what it replaces. Each member is copied before
+        	// anything is modified, so that a throwing copy leaves a consistent save of the members before it
+        	mask_type saved;
+        	try
+        	{
+        		for_each(dirty_, [this, &saved](auto index)
+				{
+        			constexpr std::size_t i = decltype(index)::value;
+        			constexpr auto member = member_at<i>();
+        			auto& previous = std::get<i>(previous_);
+        			if (previous.size() == previous.capacity())
+        			{
+        				previous.reserve(2 * previous.size() + 1);
+        			}
+        			member_type<member> copy = value_.*member;
+        			previous.push_back(std::move(shadow_.*member));
+        			shadow_.*member = std::move(copy);
+        			saved.set(i);
+				});
+        	}
+        	catch (...)
+        	{
+        		records_.push_back(saved);
+        		dirty_ &= ~saved;
+        		throw;
+        	}
+        	records_.push_back(saved);
+        	dirty_.reset();
+        	return true;
+        }
+
+        template <typename T, auto... Members>
+        bool tracked<T, Members...>::undo()
+        {
+        	if (!has_save())
+        	{
+        		return false;
+        	}
+        	const mask_type record = records_.back();
+        	// The value gets the last save state, which the shadow then gives up for the previous one
+        	for_each(dirty_ | record, [this, &record](auto index)
+			{
+        		constexpr std::size_t i = decltype(index)::value;
+        		constexpr auto member = member_at<i>();
+        		if (!record[i])
+        		{
+        			value_.*member = shadow_.*member;
+        			return;
+        		}
+        		if (dirty_[i])
+        		{
+        			value_.*member = std::move(shadow_.*member);
+        		}
+        		auto& previous = std::get<i>(previous_);
+        		shadow_.*member = std::move(previous.back());
+        		previous.pop_back();
+			});
+        	records_.pop_back();
+        	dirty_ = record;
+        	return true;
+        }
+    }
+}
+
+#endif
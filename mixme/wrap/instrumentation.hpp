@@ -0,0 +1,193 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_INSTRUMENTATION_HPP_
+#define MIXME_WRAP_INSTRUMENTATION_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <mixme/detail/types.hpp>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	enum class history_event { save, undo, redo };
+
+    	/**
+    	 * Latencies, bucketed by powers of two: bucket i counts the operations taking [2^i, 2^(i+1)) nanoseconds,
+    	 * bucket 0 also the faster ones
+    	 */
+    	using latency_histogram = std::array<std::uint64_t, 32>;
+
+    	/**
+    	 * Snapshot of the activity of one or more history wrappers
+    	 */
+    	struct history_stats
+		{
+    		std::uint64_t saves = 0;
+    		std::uint64_t undos = 0;
+    		std::uint64_t redos = 0;
+    		std::uint64_t dropped = 0; // states overwritten or evicted by saves and undos
+    		/**
+    		 * Shallow estimate of the bytes held by the saved and edit states after the last operation: sizeof(T)
+    		 * per state, not counting the memory they own indirectly. Policies reporting bytes_used, as
+    		 * budget_storage does, give their own count instead
+    		 */
+    		std::size_t estimated_history_bytes = 0;
+    		latency_histogram save_latency = {};
+    		latency_histogram undo_latency = {};
+    		latency_histogram redo_latency = {};
+
+    		history_stats& operator+=(const history_stats& other) noexcept;
+		};
+
+    	/**
+    	 * Instrumentation policy of undoable and redoable recording nothing, at no cost.
+    	 *
+    	 * An instrumentation policy must provide:
+    	 * - enter(history_event), called before storing or restoring a state and returning a token
+    	 * - leave(history_event, token, bool kept, F estimated_history_bytes), called after, where kept is false if
+    	 *   a state was overwritten or evicted and estimated_history_bytes() computes
+    	 *   history_stats::estimated_history_bytes
+    	 * - stats(), returning the recorded history_stats
+    	 * The wrappers default construct their instrumentation, also when copied or moved.
+    	 */
+    	struct no_instrumentation
+		{
+    		constexpr mixme::detail::no_type enter(history_event) const noexcept { return {}; }
+
+    		template <typename F>
+    		constexpr void leave(history_event, mixme::detail::no_type, bool, F&&) const noexcept {}
+
+    		history_stats stats() const noexcept { return history_stats(); }
+		};
+
+    	class instrumentation_registry;
+
+    	namespace detail
+		{
+    		/**
+    		 * Lock that never throws, unlike std::mutex, so that instances can register from noexcept
+    		 * constructors and destructors. Waiting threads yield
+    		 */
+    		class spin_mutex
+			{
+    		public:
+    			void lock() noexcept;
+
+    			void unlock() noexcept { flag_.clear(std::memory_order_release); }
+    		private:
+    			std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
+			};
+		}
+
+    	/**
+    	 * Instrumentation policy counting operations, dropped states and estimated history bytes, and timing the
+    	 * storing and restoring of states. Each instance registers itself in instrumentation_registry.
+    	 *
+    	 * Recording is thread safe, so that stats can be scraped while the wrapper is used.
+    	 */
+    	class counting_instrumentation
+		{
+    	public:
+    		using clock = std::chrono::steady_clock;
+
+    		counting_instrumentation() noexcept;
+
+    		/** Counting starts over for copies */
+    		counting_instrumentation(const counting_instrumentation&) noexcept : counting_instrumentation() {}
+
+    		counting_instrumentation& operator=(const counting_instrumentation&) noexcept { return *this; }
+
+    		~counting_instrumentation();
+
+    		clock::time_point enter(history_event) const noexcept { return clock::now(); }
+
+    		template <typename F>
+    		void leave(history_event event, clock::time_point start, bool kept, F&& estimated_history_bytes) noexcept;
+
+    		history_stats stats() const noexcept;
+    	private:
+    		friend class instrumentation_registry;
+
+    		using counter = std::atomic<std::uint64_t>;
+
+    		static void record(std::array<counter, 32>& histogram, clock::duration latency) noexcept;
+
+    		counter saves_{0};
+    		counter undos_{0};
+    		counter redos_{0};
+    		counter dropped_{0};
+    		std::atomic<std::size_t> estimated_history_bytes_{0};
+    		std::array<counter, 32> save_latency_ = {};
+    		std::array<counter, 32> undo_latency_ = {};
+    		std::array<counter, 32> redo_latency_ = {};
+
+    		// Registration, guarded by the registry
+    		counting_instrumentation* previous_ = nullptr;
+    		counting_instrumentation* next_ = nullptr;
+		};
+
+    	/**
+    	 * Process-wide list of the live counting_instrumentation instances, keeping the counters
+    	 * of the destroyed ones so that the totals never go backwards
+    	 */
+    	class instrumentation_registry
+		{
+    	public:
+    		static instrumentation_registry& instance() noexcept;
+
+    		instrumentation_registry(const instrumentation_registry&) = delete;
+
+    		instrumentation_registry& operator=(const instrumentation_registry&) = delete;
+
+    		/**
+    		 * @returns The number of live instances
+    		 */
+    		std::size_t size() const;
+
+    		/**
+    		 * @returns The sum of the stats of all instances, live and destroyed.
+    		 * The estimated history bytes are only those of the live instances
+    		 */
+    		history_stats total() const;
+
+    		/**
+    		 * Calls f with the stats of each live instance. f must not create or destroy instances
+    		 */
+    		template <typename F>
+    		void for_each(F&& f) const;
+    	private:
+    		friend class counting_instrumentation;
+
+    		instrumentation_registry() = default;
+
+    		void add(counting_instrumentation& instance) noexcept;
+
+    		void remove(counting_instrumentation& instance) noexcept;
+
+    		mutable detail::spin_mutex mutex_;
+    		counting_instrumentation* first_ = nullptr;
+    		history_stats retired_; // counters of the destroyed instances
+		};
+    }
+}
+
+#include <mixme/wrap/impl/instrumentation.tpp>
+
+#endif
@@ -0,0 +1,224 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef MIXME_WRAP_JOURNALED_HPP_
+#define MIXME_WRAP_JOURNALED_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <mixme/wrap/base.hpp>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	namespace detail
+		{
+    		/**
+    		 * Type erased operation on a T, applied at most once. Small operations are stored inline.
+    		 * A default constructed entry holds no operation and marks a save in a journal.
+    		 */
+    		template <typename T>
+    		class journal_entry
+			{
+    		public:
+    			journal_entry() noexcept = default;
+
+    			template <typename Operation,
+					typename std::enable_if_t<!std::is_same<journal_entry, std::decay_t<Operation>>::value>* = nullptr>
+    			explicit journal_entry(Operation&& operation);
+
+    			journal_entry(const journal_entry& other);
+
+    			journal_entry(journal_entry&& other) noexcept;
+
+    			journal_entry& operator=(const journal_entry& other);
+
+    			journal_entry& operator=(journal_entry&& other) noexcept;
+
+    			~journal_entry();
+
+    			bool marker() const noexcept { return ops_ == nullptr; }
+
+    			/**
+    			 * Applies the operation to value, consuming it
+    			 *
+    			 * @returns The inverse returned by the operation
+    			 */
+    			journal_entry apply(T& value);
+    		private:
+    			static constexpr std::size_t inline_size = 3 * sizeof(void*);
+
+    			using storage_type = std::aligned_storage_t<inline_size, alignof(void*)>;
+
+    			template <typename Operation>
+    			using is_inline = std::integral_constant<bool, sizeof(Operation) <= inline_size
+    					&& alignof(Operation) <= alignof(void*)
+						&& std::is_nothrow_move_constructible<Operation>::value>;
+
+    			struct operations
+				{
+    				void (*copy)(const storage_type&, storage_type&);
+    				void (*move)(storage_type&, storage_type&) noexcept;
+    				void (*destroy)(storage_type&) noexcept;
+    				journal_entry (*apply)(storage_type&, T&);
+				};
+
+    			template <typename Operation>
+    			struct model;
+
+    			const operations* ops_ = nullptr;
+    			storage_type storage_;
+			};
+		}
+
+    	/**
+    	 * Wraps a class giving it the possibility of saving and restoring its state, recording the operations
+    	 * applied to it instead of copies of the state. Saving, undoing and redoing cost as much as the operations
+    	 * executed since, regardless of the size of the value.
+    	 *
+    	 * The value can only be modified through execute. An operation is a callable taking a T& and
+    	 * returning its inverse, which must itself be an operation, whose inverse is an operation, and so on.
+    	 * Operations must be copy constructible, and inverses shouldn't throw: if one does while undoing or redoing,
+    	 * the value and the history are left in a valid but unspecified state.
+    	 * Not thread safe.
+    	 */
+        template <typename T>
+        class journaled : private base<T>
+        {
+        public:
+            using value_type = T;
+
+            journaled() = default;
+
+            journaled(const journaled&) = default;
+
+            journaled(journaled&& other) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+            template <typename U, typename std::enable_if_t<!std::is_same<journaled, std::decay_t<U>>::value>* = nullptr>
+            journaled(U&& value) : base<T>(std::forward<U>(value)) {}
+
+            template <typename... Args, typename std::enable_if_t<(sizeof...(Args) > 1)>* = nullptr>
+            journaled(Args&&... args) : base<T>(std::forward<Args>(args)...) {}
+
+            journaled& operator=(const journaled&) = default;
+
+            journaled& operator=(journaled&& other) noexcept(std::is_nothrow_move_assignable<T>::value);
+
+            const T* operator->() const noexcept { return &value(); }
+
+            const T& operator*() const & noexcept { return value(); }
+
+            const T& value() const noexcept { return base<T>::value(); }
+
+            /**
+             * Applies operation to the value and records its inverse. Discards the edit states.
+             * If operation throws, nothing is recorded. If there's no saved state, the inverse is not recorded.
+             */
+            template <typename Operation>
+            void execute(Operation&& operation);
+
+            /**
+             * Saves the current state, recording only a marker in the journal
+             */
+            void save();
+
+            /**
+             * @returns Whether there's a valid saved state, that a call to undo will restore
+             */
+            bool has_save() const noexcept { return saves_ > 0; }
+
+            /**
+             * @returns The current number of stored save states
+             */
+            std::size_t saves() const noexcept { return saves_; }
+
+            /**
+             * Restores the last saved state, if present, applying the inverses of the operations executed since.
+             * The current state becomes an edit state.
+             *
+             * @returns True if a saved state has been restored
+             */
+            bool undo();
+
+            /**
+             * @returns Whether there's a valid edit state, that a call to redo will restore
+             */
+            bool has_edit() const noexcept { return edits_ > 0; }
+
+            /**
+             * @returns The current number of stored edit states
+             */
+            std::size_t edits() const noexcept { return edits_; }
+
+            /**
+             * Restores the last edit state, if present, executing again the operations undone.
+             * The current state becomes a save state.
+             *
+             * @returns True if an edit state has been restored
+             */
+            bool redo();
+
+            /**
+             * @returns The number of operations recorded in the journal, saves included
+             */
+            std::size_t journal_size() const noexcept { return undo_log_.size() + redo_log_.size(); }
+
+            friend void swap(journaled& lhs, journaled& rhs) noexcept(noexcept(std::swap(std::declval<T&>(), std::declval<T&>())))
+            {
+            	using std::swap;
+            	swap(static_cast<base<T>&>(lhs).value(), static_cast<base<T>&>(rhs).value());
+            	swap(lhs.undo_log_, rhs.undo_log_);
+            	swap(lhs.redo_log_, rhs.redo_log_);
+            	swap(lhs.saves_, rhs.saves_);
+            	swap(lhs.edits_, rhs.edits_);
+            }
+        private:
+            using entry_type = detail::journal_entry<T>;
+
+            /// Applies the entries of from down to the first marker, recording their inverses in to
+            static void replay(T& value, std::vector<entry_type>& from, std::vector<entry_type>& to);
+
+            std::vector<entry_type> undo_log_;
+            std::vector<entry_type> redo_log_;
+            std::size_t saves_ = 0;
+            std::size_t edits_ = 0;
+        };
+
+        template <typename T>
+        bool operator==(const journaled<T>& lhs, const journaled<T>& rhs) { return lhs.value() == rhs.value(); }
+
+        template <typename T>
+        bool operator==(const journaled<T>& lhs, const T& rhs) { return lhs.value() == rhs; }
+
+        template <typename T>
+        bool operator==(const T& lhs, const journaled<T>& rhs) { return lhs == rhs.value(); }
+
+        template <typename T>
+        bool operator!=(const journaled<T>& lhs, const journaled<T>& rhs) { return lhs.value() != rhs.value(); }
+
+        template <typename T>
+        bool operator!=(const journaled<T>& lhs, const T& rhs) { return lhs.value() != rhs; }
+
+        template <typename T>
+        bool operator!=(const T& lhs, const journaled<T>& rhs) { return lhs != rhs.value(); }
+    }
+}
+
+#include <mixme/wrap/impl/journaled.tpp>
+
+#endif
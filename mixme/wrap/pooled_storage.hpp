@@ -0,0 +1,103 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_POOLED_STORAGE_HPP_
+#define MIXME_WRAP_POOLED_STORAGE_HPP_
+
+#include <cstddef>
+#include <type_traits>
+#include <mixme/detail/types.hpp>
+#include <mixme/detail/slab_pool.hpp>
+
+namespace mixme
+{
+    namespace wrap
+    {
+		/**
+		 * Storage keeping elements in a process wide pool shared by all storages of the same size class.
+		 * Holds up to N elements; when full, storing overwrites the most recent element.
+		 *
+		 * A storage without elements costs a single pointer, thus memory scales with the number of
+		 * stored elements rather than with the number of wrapped objects.
+		 */
+		template <typename T, std::size_t N = 1>
+		struct pooled_storage
+		{
+			static_assert(N > 0, "pooled_storage must be able to hold at least one element");
+		protected:
+			struct node
+			{
+				template <typename U>
+				node(U&& value, node* previous)
+				: value(std::forward<U>(value)), previous(previous), depth((previous) ? previous->depth + 1 : 1) {}
+
+				T value;
+				node* previous;
+				std::size_t depth;
+			};
+
+			using pool = mixme::detail::slab_pool<sizeof(node), alignof(node)>;
+
+			using data_type = mixme::detail::no_type;
+			using bookkeeping_type = node*; // most recent element
+
+			static bool has_data(bookkeeping_type bkp) { return bkp != nullptr; }
+
+			static std::size_t max_size(bookkeeping_type bkp) { return N; }
+
+			static std::size_t size(bookkeeping_type bkp) { return (bkp) ? bkp->depth : 0; }
+
+        	static void copy_construct(const data_type& src,
+        			const bookkeeping_type& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp);
+
+        	static void move_construct(data_type&& src,
+        			bookkeeping_type&& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp) noexcept;
+
+        	static void copy_assign(const data_type& src,
+        			const bookkeeping_type& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp);
+
+        	static void move_assign(data_type&& src,
+        			bookkeeping_type&& src_bkp,
+        			data_type& dst,
+					bookkeeping_type& dst_bkp) noexcept;
+
+        	static void dispose(data_type&, bookkeeping_type) noexcept;
+
+        	static void clear(data_type& data, bookkeeping_type& bkp) noexcept
+        	{
+        		dispose(data, bkp);
+        		bkp = nullptr;
+        	}
+
+			static void store(T&, data_type&, bookkeeping_type&);
+
+			static void restore(T&, data_type&, bookkeeping_type&) noexcept(std::is_nothrow_move_assignable<T>::value);
+		private:
+			template <typename U>
+			static node* push(U&& value, node* previous);
+
+			static node* pop(node* top) noexcept;
+
+			static node* clone(const node* top);
+		};
+    }
+}
+
+#include <mixme/wrap/impl/pooled_storage.tpp>
+
+#endif
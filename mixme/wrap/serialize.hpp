@@ -0,0 +1,57 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_SERIALIZE_HPP_
+#define MIXME_WRAP_SERIALIZE_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+
+namespace mixme
+{
+	/**
+	 * Customization point converting values of T from and to bytes.
+	 *
+	 * Specializations must provide:
+	 * - static void serialize(const T& value, std::vector<unsigned char>& out), appending the bytes to out
+	 * - static void deserialize(const unsigned char* data, std::size_t size, T& value)
+	 *
+	 * An implementation copying the object representation is provided for trivially copyable types.
+	 */
+	template <typename T, typename = void>
+	struct serialize_traits;
+
+	template <typename T>
+	struct serialize_traits<T, std::enable_if_t<std::is_trivially_copyable<T>::value>>
+	{
+		static void serialize(const T& value, std::vector<unsigned char>& out)
+		{
+			const std::size_t offset = out.size();
+			out.resize(offset + sizeof(T));
+			std::memcpy(out.data() + offset, static_cast<const void*>(&value), sizeof(T));
+		}
+
+		static void deserialize(const unsigned char* data, std::size_t size, T& value)
+		{
+			if (size != sizeof(T))
+			{
+				throw std::runtime_error("mixme: serialized size mismatch");
+			}
+			std::memcpy(static_cast<void*>(&value), data, sizeof(T));
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,96 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef MIXME_WRAP_SPILL_STORAGE_HPP_
+#define MIXME_WRAP_SPILL_STORAGE_HPP_
+
+#include <mixme/detail/config.hpp>
+
+#ifdef MIXME_HAS_MMAP
+
+#include <cstddef>
+#include <vector>
+#include <mixme/detail/spill_file.hpp>
+#include <mixme/wrap/serialize.hpp>
+#include <mixme/wrap/tiered_storage.hpp>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	namespace detail
+		{
+    		/** Cold tier of spill_storage: records of a spill file, which take no memory */
+    		class spilled_records
+			{
+    		public:
+    			/// The serialized bytes, written to the file as they are
+    			struct block_type
+				{
+    				const unsigned char* data;
+    				std::size_t size;
+				};
+
+    			static block_type prepare(const std::vector<unsigned char>& raw) noexcept
+    			{
+    				return block_type{raw.data(), raw.size()};
+    			}
+
+    			static std::size_t bytes(const block_type&) noexcept { return 0; }
+
+    			void push_back(block_type&& block) { file_.push_back(block.data, block.size); }
+
+    			void pop_front() noexcept { file_.pop_front(); }
+
+    			void pop_back() noexcept { file_.pop_back(); }
+
+    			std::size_t front_bytes() const noexcept { return 0; }
+
+    			std::size_t back_bytes() const noexcept { return 0; }
+
+    			const unsigned char* back(std::vector<unsigned char>&, std::size_t& size) const noexcept
+    			{
+    				size = file_.back_size();
+    				return file_.back_data();
+    			}
+
+    			bool empty() const noexcept { return file_.empty(); }
+
+    			void clear() noexcept { file_.clear(); }
+    		private:
+    			mixme::detail::spill_file file_; // oldest first
+			};
+		}
+
+		/**
+		 * Storage holding up to N elements, of which the most recent Hot are kept in memory and the older ones
+		 * are serialized to a memory mapped temporary file. When full, the oldest element is evicted.
+		 *
+		 * Spilled elements are deserialized in place from the mapping: with the default traits, restoring one
+		 * is a single memcpy. The file only grows with the number of spilled elements, as evicted and restored
+		 * ones are compacted away. bytes_used counts only the elements kept in memory.
+		 *
+		 * Traits must satisfy the requirements of serialize_traits. Requires a POSIX system.
+		 */
+		template <typename T, std::size_t N, std::size_t Hot = 1, typename Traits = serialize_traits<T>>
+		struct spill_storage : detail::tiered_storage<T, N, Hot, Traits, detail::spilled_records>
+		{
+			static_assert(N > 0, "spill_storage must be able to hold at least one element");
+			static_assert(Hot <= N, "spill_storage can't keep more elements in memory than its size");
+		};
+    }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,110 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_TIERED_STORAGE_HPP_
+#define MIXME_WRAP_TIERED_STORAGE_HPP_
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	namespace detail
+		{
+			/**
+			 * Storage holding up to N elements, of which the most recent Hot are kept as they are and the older
+			 * ones are serialized with Traits into a Cold sequence. When full, the oldest element is evicted.
+			 * Saving either succeeds or leaves the history unchanged.
+			 *
+			 * Cold must provide:
+			 * - block_type, what serialized bytes become once prepared for storage
+			 * - static block_type prepare(const std::vector<unsigned char>& raw)
+			 * - static std::size_t bytes(const block_type&), the bytes the block will take in memory
+			 * - void push_back(block_type&&), leaving the sequence unchanged if it throws
+			 * - void pop_front() noexcept and void pop_back() noexcept
+			 * - std::size_t front_bytes() const noexcept and std::size_t back_bytes() const noexcept
+			 * - const unsigned char* back(std::vector<unsigned char>& scratch, std::size_t& size) const,
+			 *   the serialized bytes of the most recent element, possibly decoded into scratch
+			 * - bool empty() const noexcept and void clear() noexcept
+			 */
+			template <typename T, std::size_t N, std::size_t Hot, typename Traits, typename Cold>
+			struct tiered_storage
+			{
+			protected:
+				struct data_type
+				{
+					Cold cold; // oldest first
+					std::deque<T> hot; // all more recent than the cold ones
+				};
+
+				struct bookkeeping_type
+				{
+					std::size_t count = 0;
+					std::size_t cold_bytes = 0; // memory taken by the cold elements
+				};
+
+				static bool has_data(bookkeeping_type bkp) { return bkp.count > 0; }
+
+				static std::size_t max_size(bookkeeping_type bkp) { return N; }
+
+				static std::size_t size(bookkeeping_type bkp) { return bkp.count; }
+
+				static std::size_t bytes_used(bookkeeping_type bkp)
+				{
+					return bkp.cold_bytes + (bkp.count < Hot ? bkp.count : Hot) * sizeof(T);
+				}
+
+				static void copy_construct(const data_type& src,
+						const bookkeeping_type& src_bkp,
+						data_type& dst,
+						bookkeeping_type& dst_bkp);
+
+				static void move_construct(data_type&& src,
+						bookkeeping_type&& src_bkp,
+						data_type& dst,
+						bookkeeping_type& dst_bkp) noexcept;
+
+				static void copy_assign(const data_type& src,
+						const bookkeeping_type& src_bkp,
+						data_type& dst,
+						bookkeeping_type& dst_bkp);
+
+				static void move_assign(data_type&& src,
+						bookkeeping_type&& src_bkp,
+						data_type& dst,
+						bookkeeping_type& dst_bkp) noexcept;
+
+				static void dispose(data_type&, bookkeeping_type) noexcept {}
+
+				static void clear(data_type& data, bookkeeping_type& bkp) noexcept
+				{
+					data.cold.clear();
+					data.hot.clear();
+					bkp = bookkeeping_type();
+				}
+
+				static void store(T&, data_type&, bookkeeping_type&);
+
+				static void restore(T&, data_type&, bookkeeping_type&);
+			private:
+				static std::vector<unsigned char>& scratch();
+			};
+		}
+    }
+}
+
+#include <mixme/wrap/impl/tiered_storage.tpp>
+
+#endif
@@ -0,0 +1,154 @@
+// Copyright (C) 2017 Andrea Spurio. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef MIXME_WRAP_TRACKED_HPP_
+#define MIXME_WRAP_TRACKED_HPP_
+
+#include <mixme/detail/config.hpp>
+
+#ifdef MIXME_HAS_AUTO_TEMPLATE_PARAMETER
+
+#include <bitset>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mixme
+{
+    namespace wrap
+    {
+    	/**
+    	 * Wraps a class giving it the possibility of saving and restoring its state, undoing all modifications.
+    	 * Writes go through typed setters, which mark the written members dirty, so that saving and undoing
+    	 * copy only the members changed since the last save.
+    	 *
+    	 * Members lists the pointers to the data members making up the state: the other members are not
+    	 * restored. Requires C++17.
+    	 */
+        template <typename T, auto... Members>
+        class tracked
+        {
+        	static_assert(sizeof...(Members) > 0, "tracked requires at least one member");
+
+        	template <auto Member>
+        	using member_type = std::remove_reference_t<decltype(std::declval<T&>().*Member)>;
+
+        	using mask_type = std::bitset<sizeof...(Members)>;
+        public:
+            using value_type = T;
+
+            tracked() : value_(), shadow_(value_) {}
+
+            tracked(const tracked&) = default;
+
+            tracked(tracked&&) = default;
+
+            template <typename U, typename std::enable_if_t<!std::is_same<tracked, std::decay_t<U>>::value>* = nullptr>
+            tracked(U&& value) : value_(std::forward<U>(value)), shadow_(value_) {}
+
+            template <typename... Args, typename std::enable_if_t<(sizeof...(Args) > 1)>* = nullptr>
+            tracked(Args&&... args) : value_(std::forward<Args>(args)...), shadow_(value_) {}
+
+            tracked& operator=(const tracked&) = default;
+
+            tracked& operator=(tracked&&) = default;
+
+            /**
+             * Replaces the value, marking every member dirty
+             */
+            template <typename U, typename std::enable_if_t<!std::is_same<tracked, std::decay_t<U>>::value>* = nullptr>
+            tracked& operator=(U&& value);
+
+            const T* operator->() const noexcept { return &value_; }
+
+            const T& operator*() const noexcept { return value_; }
+
+            const T& value() const noexcept { return value_; }
+
+            template <auto Member>
+            const member_type<Member>& get() const noexcept { return value_.*Member; }
+
+            /**
+             * Assigns the member, marking it dirty
+             */
+            template <auto Member, typename U>
+            void set(U&& value);
+
+            /**
+             * Calls f with a reference to the member, marking it dirty
+             */
+            template <auto Member, typename F>
+            void modify(F&& f);
+
+            /**
+             * @returns Whether the member has been written since the last save or undo
+             */
+            template <auto Member>
+            bool dirty() const noexcept { return dirty_[index_of<Member>()]; }
+
+            /**
+             * @returns Whether any member has been written since the last save or undo
+             */
+            bool dirty() const noexcept { return dirty_.any(); }
+
+            /**
+             * Saves the current state, copying only the dirty members.
+             * If a copy throws, the members copied so far are saved and the others stay dirty
+             *
+             * @returns True, the history is unbounded
+             */
+            bool save();
+
+            bool has_save() const noexcept { return !records_.empty(); }
+
+            std::size_t saves() const noexcept { return records_.size(); }
+
+            /**
+             * Restores the last saved state, if present, copying only the dirty members
+             *
+             * @returns True if a saved state has been restored
+             */
+            bool undo();
+        private:
+            static constexpr std::size_t size = sizeof...(Members);
+
+            template <auto Member>
+            static constexpr std::size_t index_of() noexcept;
+
+            template <std::size_t I>
+            static constexpr auto member_at() noexcept { return std::get<I>(std::make_tuple(Members...)); }
+
+            template <typename F, std::size_t... I>
+            static void for_each(const mask_type& mask, F&& f, std::index_sequence<I...>);
+
+            template <typename F>
+            static void for_each(const mask_type& mask, F&& f)
+            {
+            	for_each(mask, std::forward<F>(f), std::make_index_sequence<size>());
+            }
+
+            T value_;
+            T shadow_; // the last saved state, or the initial one if there's none
+            mask_type dirty_;
+            std::vector<mask_type> records_; // members of each save differing from the previous state
+            std::tuple<std::vector<member_type<Members>>...> previous_; // their previous values
+        };
+    }
+}
+
+#include <mixme/wrap/impl/tracked.tpp>
+
+#endif
+
+#endif
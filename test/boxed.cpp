@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <mixme/wrap/boxed.hpp>
+#include <mixme/wrap/history.hpp>
+#include <string>
+
+using namespace mixme::wrap;
+
+namespace
+{
+	struct Big_state
+	{
+		static int copies;
+		static int moves;
+
+		Big_state(int i = 0) : i(i) {}
+		Big_state(const Big_state& other) : i(other.i) { copies++; }
+		Big_state(Big_state&& other) noexcept : i(other.i) { moves++; }
+		Big_state& operator=(const Big_state& other) { i = other.i; copies++; return *this; }
+		Big_state& operator=(Big_state&& other) noexcept { i = other.i; moves++; return *this; }
+
+		int i;
+		char payload[1024];
+	};
+
+	int Big_state::copies = 0;
+	int Big_state::moves = 0;
+
+	bool operator==(const Big_state& lhs, const Big_state& rhs) { return lhs.i == rhs.i; }
+
+	bool operator!=(const Big_state& lhs, const Big_state& rhs) { return lhs.i != rhs.i; }
+
+	typedef boxed<Big_state> Box_t;
+}
+
+TEST(BOXED, STORAGE)
+{
+	EXPECT_TRUE(boxed<int>::is_inline);
+	EXPECT_FALSE(Box_t::is_inline);
+	EXPECT_EQ(sizeof(void*), sizeof(Box_t));
+	EXPECT_TRUE(mixme::gift::is_trivially_relocatable<Box_t>::value);
+	EXPECT_FALSE((mixme::gift::is_trivially_relocatable<boxed<std::string, sizeof(std::string)>>::value));
+	EXPECT_TRUE(mixme::gift::is_trivially_relocatable<boxed<std::string>>::value);
+}
+
+TEST(BOXED, VALUE)
+{
+	Box_t box(1);
+	EXPECT_EQ(1, box->i);
+	EXPECT_EQ(Big_state(1), box);
+
+	// Copies are deep
+	Box_t copy = box;
+	copy->i = 2;
+	EXPECT_EQ(1, box->i);
+	EXPECT_NE(box, copy);
+
+	// Assignments reuse the allocation
+	const Big_state* address = &*copy;
+	copy = box;
+	EXPECT_EQ(address, &*copy);
+	copy = Big_state(3);
+	EXPECT_EQ(address, &*copy);
+	EXPECT_EQ(3, copy->i);
+
+	// Moves steal the allocation
+	Big_state::moves = 0;
+	Box_t moved = std::move(copy);
+	EXPECT_EQ(address, &*moved);
+	EXPECT_FALSE(copy.has_value());
+	copy = Big_state(4);
+	EXPECT_TRUE(copy.has_value());
+	EXPECT_EQ(4, copy->i);
+
+	swap(copy, moved);
+	EXPECT_EQ(address, &*copy);
+	EXPECT_EQ(4, moved->i);
+	EXPECT_EQ(1, Big_state::moves); // Only assigning the temporary
+}
+
+TEST(BOXED, HISTORY)
+{
+	typedef redoable<Box_t, array_storage<Box_t, 4>> Redo_t;
+	Redo_t value = Box_t(0);
+	value.save();
+	(*value)->i = 1;
+	value.save();
+	(*value)->i = 2;
+	const Big_state* current = &**value;
+
+	// Undo and redo exchange the allocations, without touching the values
+	Big_state::copies = 0;
+	Big_state::moves = 0;
+	EXPECT_EQ(true, value.undo());
+	EXPECT_EQ(1, (*value)->i);
+	EXPECT_EQ(true, value.undo());
+	EXPECT_EQ(0, (*value)->i);
+	EXPECT_EQ(true, value.redo());
+	EXPECT_EQ(true, value.redo());
+	EXPECT_EQ(2, (*value)->i);
+	EXPECT_EQ(current, &**value);
+	EXPECT_EQ(0, Big_state::copies);
+	EXPECT_EQ(0, Big_state::moves);
+}
+
+TEST(BOXED, FOOTPRINT)
+{
+	Box_t box;
+	EXPECT_EQ(sizeof(Box_t) + sizeof(Big_state), mixme::footprint(box));
+	boxed<std::string> text(std::string(100, 'x'));
+	EXPECT_EQ(mixme::footprint(*text) + sizeof(void*), mixme::footprint(text));
+}
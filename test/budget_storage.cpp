@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <mixme/wrap/history.hpp>
+#include <mixme/wrap/budget_storage.hpp>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <limits>
+
+using namespace mixme::wrap;
+
+TEST(BUDGET_STORAGE, FOOTPRINT)
+{
+	EXPECT_EQ(sizeof(int), mixme::footprint(5));
+
+	const std::vector<int> v(100);
+	EXPECT_EQ(sizeof(v) + v.capacity() * sizeof(int), mixme::footprint(v));
+
+	const std::string small = "a";
+	const std::string large(1000, 'a');
+	EXPECT_LE(sizeof(small), mixme::footprint(small));
+	EXPECT_LT(sizeof(small) + 1000, mixme::footprint(large));
+
+	const std::vector<std::string> nested(2, large);
+	EXPECT_LT(2 * mixme::footprint(large), mixme::footprint(nested));
+
+	const std::map<int, std::string> m = {{1, large}};
+	EXPECT_LT(mixme::footprint(large), mixme::footprint(m));
+}
+
+TEST(BUDGET_STORAGE, EVICTION)
+{
+	typedef redoable<std::vector<char>, budget_storage<std::vector<char>, 4096>> Redo_buffer_t;
+	Redo_buffer_t buffer;
+	const std::size_t kilobyte = mixme::footprint(std::vector<char>(1000));
+
+	EXPECT_EQ(0u, buffer.bytes_used());
+	EXPECT_EQ(2 * 4096u, buffer.bytes_budget());
+
+	// Four kilobyte-sized saves fit, the fifth evicts the oldest
+	for (int n = 0; n < 4; ++n)
+	{
+		buffer->assign(1000, static_cast<char>('a' + n));
+		buffer->shrink_to_fit();
+		EXPECT_EQ(true, buffer.save());
+	}
+	EXPECT_EQ(4 * kilobyte, buffer.bytes_used());
+	buffer->assign(1000, 'e');
+	EXPECT_EQ(false, buffer.save());
+	EXPECT_EQ(4u, buffer.saves());
+	EXPECT_GE(4096u, buffer.bytes_used());
+
+	// A large save evicts several
+	buffer->assign(2500, 'f');
+	buffer->shrink_to_fit();
+	EXPECT_EQ(false, buffer.save());
+	EXPECT_EQ(2u, buffer.saves());
+	EXPECT_GE(4096u, buffer.bytes_used());
+
+	// The most recent save is kept even when over budget
+	buffer->assign(5000, 'g');
+	EXPECT_EQ(false, buffer.save());
+	EXPECT_EQ(1u, buffer.saves());
+	buffer->clear();
+
+	EXPECT_EQ(true, buffer.undo());
+	EXPECT_EQ(5000u, buffer->size());
+	EXPECT_EQ(false, buffer.has_save());
+	EXPECT_EQ(true, buffer.has_edit());
+	EXPECT_LT(0u, buffer.bytes_used());
+
+	Redo_buffer_t moved = std::move(buffer);
+	EXPECT_EQ(0u, buffer.bytes_used());
+	EXPECT_EQ(true, moved.redo());
+	EXPECT_EQ(true, moved->empty());
+	EXPECT_EQ(0u, moved.bytes_used());
+}
+
+TEST(BUDGET_STORAGE, RUNTIME_BUDGET)
+{
+	typedef redoable<std::vector<char>, budget_storage<std::vector<char>>> Redo_buffer_t;
+	Redo_buffer_t buffer(std::vector<char>(1000));
+	const std::size_t kilobyte = mixme::footprint(*buffer);
+	EXPECT_EQ(std::numeric_limits<std::size_t>::max(), buffer.bytes_budget());
+
+	for (int n = 0; n < 4; ++n)
+	{
+		EXPECT_EQ(true, buffer.save());
+	}
+	EXPECT_EQ(true, buffer.undo());
+	EXPECT_EQ(true, buffer.undo());
+
+	// Lowering the budget evicts the oldest saves and edits
+	buffer.set_bytes_budget(kilobyte);
+	EXPECT_EQ(2 * kilobyte, buffer.bytes_budget());
+	EXPECT_EQ(1u, buffer.saves());
+	EXPECT_EQ(1u, buffer.edits());
+
+	// Copies and moves keep the budget
+	Redo_buffer_t copy = buffer;
+	EXPECT_EQ(2 * kilobyte, copy.bytes_budget());
+	Redo_buffer_t moved = std::move(copy);
+	EXPECT_EQ(2 * kilobyte, moved.bytes_budget());
+	EXPECT_EQ(2 * kilobyte, copy.bytes_budget());
+
+	// Saving clears the edits and evicts the previous save
+	EXPECT_EQ(false, moved.save());
+	EXPECT_EQ(1u, moved.saves());
+	EXPECT_EQ(0u, moved.edits());
+	EXPECT_EQ(2 * kilobyte, moved.bytes_budget());
+}
+
+namespace
+{
+	/// Tracks the live instances when copied
+	struct Counted
+	{
+		Counted() { live++; }
+		Counted(const Counted&) { peak = std::max(peak, ++live); }
+		Counted& operator=(const Counted&) = default;
+		~Counted() { live--; }
+
+		static std::size_t live;
+		static std::size_t peak;
+	};
+
+	std::size_t Counted::live = 0;
+	std::size_t Counted::peak = 0;
+}
+
+TEST(BUDGET_STORAGE, EVICTION_BEFORE_STORE)
+{
+	undoable<Counted, budget_storage<Counted, 2 * sizeof(Counted)>> value;
+	value.save();
+	value.save();
+	EXPECT_EQ(3u, Counted::live);
+
+	// The oldest save is gone before the new one is copied
+	Counted::peak = 0;
+	EXPECT_EQ(false, value.save());
+	EXPECT_EQ(3u, Counted::peak);
+	EXPECT_EQ(3u, Counted::live);
+}
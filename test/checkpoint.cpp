@@ -0,0 +1,298 @@
+#include <gtest/gtest.h>
+#include <mixme/wrap/checkpoint.hpp>
+#include <mixme/wrap/pooled_storage.hpp>
+#include <mixme/wrap/delta_storage.hpp>
+#include <stdexcept>
+#include <string>
+
+using namespace mixme::wrap;
+
+namespace
+{
+	// Throws on the fuse-th copy, if the fuse is lit, or on every copy while broken
+	struct Fragile
+	{
+		static int fuse;
+		static bool broken;
+
+		Fragile(int i = 0) : i(i) {}
+		Fragile(const Fragile& other) : i(other.i) { burn(); }
+		Fragile(Fragile&&) noexcept = default;
+		Fragile& operator=(const Fragile& other) { burn(); i = other.i; return *this; }
+		Fragile& operator=(Fragile&&) noexcept = default;
+
+		static void burn()
+		{
+			if (broken || (fuse > 0 && --fuse == 0))
+			{
+				throw std::runtime_error("copy failed");
+			}
+		}
+
+		int i;
+	};
+
+	int Fragile::fuse = 0;
+	bool Fragile::broken = false;
+
+	/// Deltas are the values to restore
+	struct Fragile_diff
+	{
+		using delta_type = int;
+
+		static delta_type diff(const Fragile&, const Fragile& to) { return to.i; }
+
+		static void apply(Fragile& value, delta_type delta) { value.i = delta; }
+	};
+
+	// Copies throw while armed, then every Fragile copy does, as when running out of memory
+	struct Exhausting
+	{
+		static bool armed;
+
+		Exhausting() = default;
+		Exhausting(const Exhausting&) { exhaust(); }
+		Exhausting(Exhausting&&) noexcept = default;
+		Exhausting& operator=(const Exhausting&) { exhaust(); return *this; }
+		Exhausting& operator=(Exhausting&&) noexcept = default;
+
+		static void exhaust()
+		{
+			if (armed)
+			{
+				Fragile::broken = true;
+				throw std::runtime_error("copy failed");
+			}
+		}
+	};
+
+	bool Exhausting::armed = false;
+}
+
+TEST(CHECKPOINT, SAVE_UNDO_REDO)
+{
+	undoable<int> number = 1;
+	redoable<std::string, vector_storage<std::string>> text = std::string("a");
+	redoable<std::string, vector_storage<std::string>> title = std::string("x");
+
+	checkpoint_group group;
+	group.add(number);
+	group.add(text);
+	group.add(title);
+	EXPECT_EQ(3u, group.size());
+
+	EXPECT_EQ(true, group.save_all());
+	*number = 2;
+	*text = "b";
+	*title = "y";
+	// The single element storage overwrites its save
+	EXPECT_EQ(false, group.save_all());
+	*number = 3;
+	*text = "c";
+
+	EXPECT_EQ(true, group.undo_all());
+	EXPECT_EQ(2, *number);
+	EXPECT_EQ("b", *text);
+	EXPECT_EQ("y", *title);
+
+	// The single element storage has no further save
+	EXPECT_EQ(false, group.undo_all());
+	EXPECT_EQ(2, *number);
+	EXPECT_EQ("b", *text);
+
+	// Undoable objects can't redo
+	EXPECT_EQ(false, group.redo_all());
+	EXPECT_EQ(true, group.remove(number));
+	EXPECT_EQ(false, group.remove(number));
+	EXPECT_EQ(true, group.redo_all());
+	EXPECT_EQ("c", *text);
+	EXPECT_EQ("y", *title);
+	EXPECT_EQ(false, group.redo_all());
+
+	EXPECT_EQ(true, group.undo_all());
+	EXPECT_EQ("a", *text);
+	EXPECT_EQ("x", *title);
+	EXPECT_EQ(false, group.undo_all());
+
+	group.clear();
+	EXPECT_EQ(0u, group.size());
+	EXPECT_EQ(true, group.undo_all());
+}
+
+TEST(CHECKPOINT, OVERWRITE)
+{
+	undoable<int> number = 1;
+	undoable<int, vector_storage<int>> counter = 1;
+	checkpoint_group group;
+	group.add(number);
+	group.add(counter);
+
+	EXPECT_EQ(true, group.save_all());
+	*number = 2;
+	*counter = 2;
+	EXPECT_EQ(false, group.save_all());
+	EXPECT_EQ(1u, number.saves());
+	EXPECT_EQ(2u, counter.saves());
+}
+
+TEST(CHECKPOINT, SAVE_ROLLBACK)
+{
+	redoable<int, vector_storage<int>> number = 1;
+	undoable<Fragile> full = Fragile(1);
+	redoable<Fragile, vector_storage<Fragile>> first = Fragile(1);
+	redoable<Fragile, vector_storage<Fragile>> second = Fragile(1);
+	full.save();
+	first.save();
+	second.save();
+	full->i = 2;
+	first->i = 2;
+	second->i = 2;
+
+	checkpoint_group group;
+	group.add(number);
+	group.add(full);
+	group.add(first);
+	group.add(second);
+
+	// Backing up the full history copies, then each save copies: the fourth copy fails
+	Fragile::fuse = 4;
+	EXPECT_THROW(group.save_all(), std::runtime_error);
+	Fragile::fuse = 0;
+
+	EXPECT_EQ(0u, number.saves());
+	EXPECT_EQ(1u, full.saves());
+	EXPECT_EQ(1u, first.saves());
+	EXPECT_EQ(1u, second.saves());
+	EXPECT_EQ(2, full->i);
+	EXPECT_EQ(true, full.undo());
+	EXPECT_EQ(1, full->i);
+	EXPECT_EQ(true, first.undo());
+	EXPECT_EQ(1, first->i);
+}
+
+TEST(CHECKPOINT, UNDO_ROLLBACK)
+{
+	// Policies without move_store are backed up before undoing, then copy the value to the edits
+	redoable<int, vector_storage<int>> number = 1;
+	redoable<Fragile, pooled_storage<Fragile, 4>> first = Fragile(1);
+	redoable<Fragile, pooled_storage<Fragile, 4>> second = Fragile(1);
+
+	checkpoint_group group;
+	group.add(number);
+	group.add(first);
+	group.add(second);
+	EXPECT_EQ(true, group.save_all());
+	*number = 2;
+	first->i = 2;
+	second->i = 2;
+
+	// Backing up copies the value and the save, undoing copies the value: the second backup fails
+	Fragile::fuse = 4;
+	EXPECT_THROW(group.undo_all(), std::runtime_error);
+	Fragile::fuse = 0;
+
+	EXPECT_EQ(2, *number);
+	EXPECT_EQ(2, first->i);
+	EXPECT_EQ(2, second->i);
+	EXPECT_EQ(1u, number.saves());
+	EXPECT_EQ(1u, first.saves());
+	EXPECT_EQ(0u, number.edits());
+	EXPECT_EQ(0u, first.edits());
+	EXPECT_EQ(0u, second.edits());
+
+	EXPECT_EQ(true, group.undo_all());
+	EXPECT_EQ(1, *number);
+	EXPECT_EQ(1, first->i);
+	EXPECT_EQ(1, second->i);
+
+	// Nothing is redone unless every object can redo
+	undoable<Fragile> plain = Fragile(5);
+	plain.save();
+	group.add(plain);
+	EXPECT_EQ(false, group.redo_all());
+	EXPECT_EQ(1, first->i);
+	EXPECT_EQ(true, group.remove(plain));
+	EXPECT_EQ(true, group.redo_all());
+	EXPECT_EQ(2, *number);
+	EXPECT_EQ(2, first->i);
+	EXPECT_EQ(2, second->i);
+}
+
+TEST(CHECKPOINT, ROLLBACK_WITHOUT_COPIES)
+{
+	// Reverting moves the values back, so it never copies even if copies throw
+	redoable<Fragile, vector_storage<Fragile>> first = Fragile(1);
+	undoable<Fragile> plain = Fragile(1);
+	// Policies without move_store are backed up, which copies
+	redoable<Fragile, pooled_storage<Fragile, 4>> last = Fragile(1);
+
+	checkpoint_group group;
+	group.add(first);
+	group.add(plain);
+	group.add(last);
+	EXPECT_EQ(true, group.save_all());
+	first->i = 2;
+	plain->i = 2;
+	last->i = 2;
+
+	Fragile::broken = true;
+	EXPECT_THROW(group.undo_all(), std::runtime_error);
+	Fragile::broken = false;
+
+	EXPECT_EQ(2, first->i);
+	EXPECT_EQ(2, plain->i);
+	EXPECT_EQ(2, last->i);
+	EXPECT_EQ(1u, first.saves());
+	EXPECT_EQ(1u, plain.saves());
+	EXPECT_EQ(0u, first.edits());
+
+	group.remove(plain);
+	EXPECT_EQ(true, group.undo_all());
+	EXPECT_EQ(1, first->i);
+	EXPECT_EQ(1, last->i);
+
+	Fragile::broken = true;
+	EXPECT_THROW(group.redo_all(), std::runtime_error);
+	Fragile::broken = false;
+
+	EXPECT_EQ(1, first->i);
+	EXPECT_EQ(1u, first.edits());
+	EXPECT_EQ(true, group.redo_all());
+	EXPECT_EQ(2, first->i);
+	EXPECT_EQ(2, last->i);
+
+	EXPECT_EQ(true, plain.undo());
+	EXPECT_EQ(1, plain->i);
+}
+
+TEST(CHECKPOINT, ROLLBACK_WITHOUT_RESTORE)
+{
+	// Restoring from a delta history copies, so its saves and undos are reverted from a backup
+	redoable<Fragile, delta_storage<Fragile, Fragile_diff>> first = Fragile(1);
+	redoable<Exhausting, pooled_storage<Exhausting, 4>> last;
+	first.save();
+	first->i = 2;
+	last.save();
+
+	checkpoint_group group;
+	group.add(first);
+	group.add(last);
+
+	Exhausting::armed = true;
+	EXPECT_THROW(group.save_all(), std::runtime_error);
+	Fragile::broken = false;
+	EXPECT_EQ(2, first->i);
+	EXPECT_EQ(1u, first.saves());
+	EXPECT_EQ(1u, last.saves());
+
+	EXPECT_THROW(group.undo_all(), std::runtime_error);
+	Exhausting::armed = false;
+	Fragile::broken = false;
+	EXPECT_EQ(2, first->i);
+	EXPECT_EQ(1u, first.saves());
+	EXPECT_EQ(0u, first.edits());
+	EXPECT_EQ(1u, last.saves());
+
+	EXPECT_EQ(true, first.undo());
+	EXPECT_EQ(1, first->i);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <mixme/gift/comparison.hpp>
 #include <mixme/detail/check/comparison.hpp>
+#include <string>
 
 using namespace mixme::gift;
 
@@ -65,6 +66,60 @@ namespace
     	int i = 0;
 	};
     bool operator<=(const Composite& lhs, const Composite& rhs) { return lhs.i <= rhs.i; }
+
+    struct Got_compare : comparison::three_way<Got_compare>
+	{
+    	Got_compare(const char* name) : name(name) {}
+    	int compare(const Got_compare& other) const { ++calls; return name.compare(other.name); }
+    	std::string name;
+    	static int calls;
+	};
+    int Got_compare::calls = 0;
+
+    struct Got_compare_equal_to : comparison::eq<Got_compare_equal_to>, comparison::ne<Got_compare_equal_to>
+	{
+    	Got_compare_equal_to(int i) : i(i) {}
+    	int compare(const Got_compare_equal_to& other) const { ++calls; return i - other.i; }
+    	int i = 0;
+    	static int calls;
+	};
+    int Got_compare_equal_to::calls = 0;
+
+#ifdef MIXME_HAS_THREE_WAY_COMPARISON
+    struct Got_three_way : comparison::three_way<Got_three_way>
+	{
+    	Got_three_way(int i) : i(i) {}
+    	std::strong_ordering operator<=>(const Got_three_way& other) const { ++calls; return i <=> other.i; }
+    	int i = 0;
+    	static int calls;
+	};
+    int Got_three_way::calls = 0;
+#endif
+
+    template <typename T>
+    void test_single_evaluation(const T& one, const T& two)
+    {
+    	T::calls = 0;
+    	EXPECT_TRUE(one == one);
+    	EXPECT_EQ(1, T::calls);
+    	EXPECT_TRUE(one != two);
+    	EXPECT_EQ(2, T::calls);
+    	EXPECT_TRUE(one < two);
+    	EXPECT_EQ(3, T::calls);
+    	EXPECT_TRUE(one <= one);
+    	EXPECT_EQ(4, T::calls);
+    	EXPECT_TRUE(two > one);
+    	EXPECT_EQ(5, T::calls);
+    	EXPECT_TRUE(two >= one);
+    	EXPECT_EQ(6, T::calls);
+
+    	EXPECT_FALSE(one == two);
+    	EXPECT_FALSE(one != one);
+    	EXPECT_FALSE(two < one);
+    	EXPECT_FALSE(two <= one);
+    	EXPECT_FALSE(one > one);
+    	EXPECT_FALSE(one >= two);
+    }
 }
 
 TEST(COMPARISON, CHECKS_LAX)
@@ -87,6 +142,14 @@ TEST(COMPARISON, CHECKS)
 	EXPECT_EQ(true, ne<Got_not_equal_to>{}());
 	EXPECT_EQ(true, le<Got_less_than_equal_to>{}());
 	EXPECT_EQ(true, ge<Got_greater_than_equal_to>{}());
+	EXPECT_EQ(true, compare<Got_compare>{}());
+	EXPECT_EQ(true, compare<std::string>{}());
+	EXPECT_EQ(false, compare<Got_less_than>{}());
+	EXPECT_EQ(false, three_way<Got_compare>{}());
+#ifdef MIXME_HAS_THREE_WAY_COMPARISON
+	EXPECT_EQ(true, three_way<Got_three_way>{}());
+	EXPECT_EQ(true, three_way<int>{}());
+#endif
 }
 
 TEST(COMPARISON, GOT_LESS_THAN)
@@ -156,6 +219,8 @@ TEST(COMPARISON, GOT_GREATER_THAN_EQUAL_TO)
     EXPECT_EQ(one, one);
     EXPECT_NE(one, two);
     EXPECT_LT(one, three);
+    EXPECT_FALSE(two < two);
+    EXPECT_FALSE(three < one);
     EXPECT_LE(one, two);
     EXPECT_LE(two, two);
     EXPECT_GT(two, one);
@@ -176,3 +241,25 @@ TEST(COMPARISON, COMPOSITION)
 	Composite one(1), two(2);
 	EXPECT_GT(two, one);
 }
+
+TEST(COMPARISON, GOT_COMPARE)
+{
+	test_single_evaluation(Got_compare("alpha"), Got_compare("beta"));
+}
+
+TEST(COMPARISON, GOT_COMPARE_EQUAL_TO)
+{
+	Got_compare_equal_to one(1), two(2);
+
+	Got_compare_equal_to::calls = 0;
+	EXPECT_EQ(one, one);
+	EXPECT_NE(one, two);
+	EXPECT_EQ(2, Got_compare_equal_to::calls);
+}
+
+#ifdef MIXME_HAS_THREE_WAY_COMPARISON
+TEST(COMPARISON, GOT_THREE_WAY)
+{
+	test_single_evaluation(Got_three_way(1), Got_three_way(2));
+}
+#endif
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <mixme/wrap/history.hpp>
+#include <mixme/wrap/compressed_storage.hpp>
+#include <mixme/detail/compression.hpp>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace mixme::wrap;
+
+namespace
+{
+	typedef std::array<int, 4096> Grid_t;
+
+	struct Text_traits
+	{
+		static void serialize(const std::string& value, std::vector<unsigned char>& out)
+		{
+			out.insert(out.end(), value.begin(), value.end());
+		}
+
+		static void deserialize(const unsigned char* data, std::size_t size, std::string& value)
+		{
+			value.assign(reinterpret_cast<const char*>(data), size);
+		}
+	};
+
+	/// Counts the serializations, and fails them on demand
+	struct Failing_traits
+	{
+		static int serializations;
+		static bool fail;
+
+		static void serialize(const std::string& value, std::vector<unsigned char>& out)
+		{
+			serializations++;
+			if (fail)
+			{
+				throw std::runtime_error("serialization failed");
+			}
+			Text_traits::serialize(value, out);
+		}
+
+		static void deserialize(const unsigned char* data, std::size_t size, std::string& value)
+		{
+			Text_traits::deserialize(data, size, value);
+		}
+	};
+
+	int Failing_traits::serializations = 0;
+	bool Failing_traits::fail = false;
+}
+
+TEST(COMPRESSED_STORAGE, CODEC)
+{
+	std::vector<std::vector<unsigned char>> inputs;
+	inputs.emplace_back();
+	inputs.emplace_back(1, 'x');
+	inputs.emplace_back(100000, 0);
+	std::vector<unsigned char> mixed;
+	for (unsigned n = 0; n < 20000; ++n)
+	{
+		mixed.push_back(static_cast<unsigned char>((n * 2654435761u) >> 24));
+		if (n % 7 == 0)
+		{
+			mixed.insert(mixed.end(), mixed.end() - std::min<std::size_t>(mixed.size(), 300), mixed.end());
+		}
+	}
+	inputs.push_back(mixed);
+
+	for (const auto& input : inputs)
+	{
+		std::vector<unsigned char> compressed;
+		mixme::detail::compress(input.data(), input.size(), compressed);
+		std::vector<unsigned char> output;
+		mixme::detail::decompress(compressed.data(), compressed.size(), output);
+		EXPECT_EQ(input, output);
+	}
+
+	std::vector<unsigned char> zeros;
+	mixme::detail::compress(inputs[2].data(), inputs[2].size(), zeros);
+	EXPECT_GT(64u, zeros.size());
+
+	std::vector<unsigned char> garbage = zeros;
+	garbage.resize(garbage.size() - 1);
+	std::vector<unsigned char> output;
+	EXPECT_THROW(mixme::detail::decompress(garbage.data(), garbage.size(), output), std::runtime_error);
+
+	// A raw size with more continuation bytes than a size_t can hold
+	const std::vector<unsigned char> endless(16, 0x80);
+	EXPECT_THROW(mixme::detail::decompress(endless.data(), endless.size(), output), std::runtime_error);
+	std::vector<unsigned char> wide(9, 0xFF);
+	wide.push_back(0x7F);
+	EXPECT_THROW(mixme::detail::decompress(wide.data(), wide.size(), output), std::runtime_error);
+}
+
+TEST(COMPRESSED_STORAGE, SPARSE_GRID)
+{
+	typedef redoable<Grid_t, compressed_storage<Grid_t, 8, 2>> Redo_grid_t;
+	Redo_grid_t grid;
+	grid->fill(0);
+
+	for (int n = 0; n < 8; ++n)
+	{
+		(*grid)[n * 100] = n + 1;
+		EXPECT_EQ(true, grid.save());
+	}
+	EXPECT_EQ(8u, grid.saves());
+
+	// Six compressed saves of a mostly empty grid take less than one more grid
+	EXPECT_GT(3 * sizeof(Grid_t), grid.bytes_used());
+
+	(*grid)[800] = 9;
+	EXPECT_EQ(false, grid.save());
+	EXPECT_EQ(8u, grid.saves());
+	(*grid)[900] = 10;
+
+	for (int n = 8; n > 0; --n)
+	{
+		EXPECT_EQ(true, grid.undo());
+		EXPECT_EQ(n + 1, (*grid)[n * 100]);
+		EXPECT_EQ(0, (*grid)[(n + 1) * 100]);
+		EXPECT_EQ(n - 1u, grid.saves());
+	}
+	EXPECT_EQ(false, grid.undo());
+	EXPECT_EQ(1, (*grid)[0]);
+
+	for (int n = 2; n <= 9; ++n)
+	{
+		EXPECT_EQ(true, grid.redo());
+		EXPECT_EQ(n + 1, (*grid)[n * 100]);
+	}
+	EXPECT_EQ(false, grid.redo());
+}
+
+TEST(COMPRESSED_STORAGE, CUSTOM_TRAITS)
+{
+	typedef redoable<std::string, compressed_storage<std::string, 3, 0, Text_traits>> Redo_text_t;
+	Redo_text_t text("a");
+	text.save();
+	*text = std::string(1000, 'b');
+	text.save();
+	*text = "c";
+
+	Redo_text_t copy = text;
+	EXPECT_EQ(true, copy.undo());
+	EXPECT_EQ(std::string(1000, 'b'), *copy);
+	EXPECT_EQ(true, copy.undo());
+	EXPECT_EQ("a", *copy);
+	EXPECT_EQ(true, copy.redo());
+	EXPECT_EQ(true, copy.redo());
+	EXPECT_EQ("c", *copy);
+	EXPECT_EQ(2u, text.saves());
+}
+
+TEST(COMPRESSED_STORAGE, FAILED_SAVE)
+{
+	typedef redoable<std::string, compressed_storage<std::string, 4, 2, Failing_traits>> Redo_text_t;
+	Redo_text_t text("a");
+	for (const char* next : {"b", "c"})
+	{
+		text.save();
+		*text = next;
+	}
+	const std::size_t bytes = text.bytes_used();
+
+	// A failed save leaves the history as it was
+	Failing_traits::fail = true;
+	EXPECT_THROW(text.save(), std::runtime_error);
+	Failing_traits::fail = false;
+	EXPECT_EQ(2u, text.saves());
+	EXPECT_EQ(bytes, text.bytes_used());
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ("b", *text);
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ("a", *text);
+	EXPECT_EQ(false, text.undo());
+}
+
+TEST(COMPRESSED_STORAGE, EVICTION_WITHOUT_COMPRESSION)
+{
+	// Nothing is ever compressed when all the elements are kept uncompressed
+	typedef undoable<std::string, compressed_storage<std::string, 2, 2, Failing_traits>> Undo_text_t;
+	Undo_text_t text("a");
+	Failing_traits::serializations = 0;
+	for (const char* next : {"b", "c", "d", "e"})
+	{
+		text.save();
+		*text = next;
+	}
+	EXPECT_EQ(0, Failing_traits::serializations);
+	EXPECT_EQ(2u, text.saves());
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ("d", *text);
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ("c", *text);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <mixme/wrap/concurrent.hpp>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mixme::wrap;
+
+TEST(CONCURRENT, UNDO_REDO)
+{
+	typedef concurrent_redoable<std::string> Redo_string_t;
+	Redo_string_t s(std::string("first"));
+
+	EXPECT_EQ(false, s.undo());
+	EXPECT_EQ(false, s.redo());
+	EXPECT_EQ(true, s.save());
+	s.set(std::string("second"));
+	EXPECT_EQ(true, s.save());
+	s.modify([](std::string& value) { value += "!"; });
+	EXPECT_EQ("second!", *s);
+	EXPECT_EQ(2u, s.saves());
+
+	EXPECT_EQ(true, s.undo());
+	EXPECT_EQ("second", *s);
+	EXPECT_EQ(1u, s.saves());
+	EXPECT_EQ(1u, s.edits());
+	EXPECT_EQ(true, s.undo());
+	EXPECT_EQ("first", *s);
+	EXPECT_EQ(false, s.undo());
+	EXPECT_EQ(true, s.redo());
+	EXPECT_EQ("second", *s);
+	EXPECT_EQ(true, s.redo());
+	EXPECT_EQ("second!", *s);
+	EXPECT_EQ(false, s.redo());
+
+	// Nothing pins old versions
+	EXPECT_EQ(0u, s.retired());
+}
+
+TEST(CONCURRENT, SNAPSHOT)
+{
+	typedef concurrent_redoable<std::string, 2> Redo_string_t;
+	Redo_string_t s(std::string("first"));
+	s.save();
+	s.set(std::string("second"));
+
+	Redo_string_t::snapshot view = s.read();
+	s.undo();
+	s.set(std::string("third"));
+	EXPECT_EQ("third", *s);
+	EXPECT_EQ(0u, s.saves());
+	EXPECT_EQ(1u, s.edits());
+
+	// The snapshot still sees the state it was taken in
+	EXPECT_EQ("second", *view);
+	EXPECT_EQ(1u, view.undo_history().size());
+	EXPECT_EQ("first", view.undo_history().front());
+	EXPECT_EQ(true, view.redo_history().empty());
+	EXPECT_EQ(2u, s.retired());
+
+	Redo_string_t::snapshot latest = s.read();
+	EXPECT_EQ("third", *latest);
+	std::vector<std::string> edits(latest.redo_history().begin(), latest.redo_history().end());
+	EXPECT_EQ(std::vector<std::string>{"second"}, edits);
+
+	view = std::move(latest);
+	{
+		Redo_string_t::snapshot released = std::move(view);
+	}
+	s.collect();
+	EXPECT_EQ(0u, s.retired());
+}
+
+TEST(CONCURRENT, READERS)
+{
+	// Each version is a vector of equal elements, so a torn read would show different ones
+	typedef concurrent_redoable<std::vector<int>, 4> Redo_vector_t;
+	Redo_vector_t v(std::vector<int>(64, 0));
+	std::atomic<bool> done{false};
+	std::atomic<long> reads{0};
+
+	auto check = [](const std::vector<int>& value)
+	{
+		for (int i : value)
+		{
+			if (i != value.front())
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	std::vector<std::thread> readers;
+	for (int n = 0; n < 6; ++n)
+	{
+		readers.emplace_back([&]
+		{
+			while (!done.load())
+			{
+				Redo_vector_t::snapshot view = v.read();
+				EXPECT_TRUE(check(*view));
+				std::size_t count = 0;
+				for (const std::vector<int>& saved : view.undo_history())
+				{
+					EXPECT_TRUE(check(saved));
+					count++;
+				}
+				EXPECT_EQ(view.undo_history().size(), count);
+				reads++;
+			}
+		});
+	}
+
+	while (reads.load() == 0)
+	{
+		std::this_thread::yield();
+	}
+	for (int n = 1; n < 2000; ++n)
+	{
+		v.modify([n](std::vector<int>& value) { std::fill(value.begin(), value.end(), n); });
+		if (n % 3 == 0)
+		{
+			v.save();
+		}
+		if (n % 7 == 0)
+		{
+			v.undo();
+		}
+		if (n % 11 == 0)
+		{
+			v.redo();
+		}
+	}
+	done = true;
+	for (std::thread& reader : readers)
+	{
+		reader.join();
+	}
+	v.collect();
+	EXPECT_EQ(0u, v.retired());
+	EXPECT_LT(0, reads.load());
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <mixme/wrap/cow.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mixme::wrap;
+
+namespace
+{
+	struct Counted
+	{
+		static int copies;
+
+		Counted(int i) : i(i) {}
+		Counted(const Counted& other) : i(other.i) { copies++; }
+		Counted& operator=(const Counted& other) { i = other.i; copies++; return *this; }
+		int i;
+	};
+
+	int Counted::copies = 0;
+
+	bool operator==(const Counted& lhs, const Counted& rhs) { return lhs.i == rhs.i; }
+}
+
+TEST(COW, UNDO)
+{
+	typedef cow_undoable<std::string> Undo_string_t;
+	Undo_string_t s = std::string("first");
+
+	EXPECT_EQ(false, s.undo());
+	EXPECT_EQ(false, s.has_save());
+	EXPECT_EQ(1u, s.max_saves());
+	EXPECT_EQ(true, s.save());
+	EXPECT_EQ(1u, s.saves());
+	s->append(" edit");
+	EXPECT_EQ("first edit", *s);
+	EXPECT_EQ(true, s.undo());
+	EXPECT_EQ("first", *s);
+	EXPECT_EQ(false, s.has_save());
+
+	EXPECT_EQ(true, s.save());
+	s = std::string("second");
+	EXPECT_EQ(false, s.save());
+	s = std::string("third");
+	EXPECT_EQ(true, s.undo());
+	EXPECT_EQ("second", *s);
+}
+
+TEST(COW, LAZY_COPY)
+{
+	typedef cow_undoable<Counted> Undo_counted_t;
+	Counted::copies = 0;
+	Undo_counted_t c(1);
+	const Undo_counted_t& const_c = c;
+
+	// Saves not followed by writes cost nothing
+	for (int n = 0; n < 10; ++n)
+	{
+		c.save();
+		EXPECT_EQ(1, const_c->i);
+		EXPECT_EQ(Counted(1), *const_c);
+	}
+	EXPECT_EQ(0, Counted::copies);
+	EXPECT_EQ(true, c.shared());
+
+	// The first write copies, later ones don't
+	c->i = 2;
+	EXPECT_EQ(1, Counted::copies);
+	EXPECT_EQ(false, c.shared());
+	c->i = 3;
+	c.value().i = 4;
+	EXPECT_EQ(1, Counted::copies);
+
+	// Undo is a pointer exchange
+	EXPECT_EQ(true, c.undo());
+	EXPECT_EQ(1, const_c->i);
+	EXPECT_EQ(1, Counted::copies);
+
+	// Whole assignment of a shared value doesn't copy the old one
+	c.save();
+	c = Counted(5);
+	EXPECT_EQ(2, Counted::copies);
+	EXPECT_EQ(true, c.undo());
+	EXPECT_EQ(1, const_c->i);
+
+	// Copies of the wrapper share everything
+	c.save();
+	Undo_counted_t d = c;
+	Undo_counted_t e = std::move(d);
+	EXPECT_EQ(2, Counted::copies);
+	EXPECT_EQ(c, e);
+	EXPECT_EQ(true, e.has_save());
+	EXPECT_EQ(false, d.has_save());
+	e->i = 6;
+	EXPECT_EQ(3, Counted::copies);
+	EXPECT_EQ(1, const_c->i);
+	EXPECT_EQ(true, e.undo());
+	EXPECT_EQ(c, e);
+}
+
+TEST(COW, THREADED_COPIES)
+{
+	typedef cow_undoable<std::vector<int>> Undo_vector_t;
+	Undo_vector_t original = std::vector<int>(64, 0);
+	original.save();
+
+	// Each thread copies and writes its own copies, sharing the representation with the others
+	auto work = [&original](int id)
+	{
+		for (int n = 0; n < 1000; ++n)
+		{
+			Undo_vector_t copy = original;
+			copy.save();
+			copy->at(0) = id;
+			Undo_vector_t other = copy;
+			EXPECT_EQ(true, other.undo());
+			EXPECT_EQ(0, other->at(0));
+			EXPECT_EQ(id, copy->at(0));
+		}
+	};
+	std::thread first(work, 1);
+	std::thread second(work, 2);
+	first.join();
+	second.join();
+
+	EXPECT_EQ(0, original->at(0));
+	EXPECT_EQ(true, original.undo());
+	EXPECT_EQ(0, original->at(0));
+}
@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include <mixme/wrap/history.hpp>
+#include <mixme/wrap/delta_storage.hpp>
+#include <string>
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace mixme::wrap;
+
+namespace
+{
+	struct Document
+	{
+		std::array<int, 1024> cells{};
+	};
+
+	bool operator==(const Document& lhs, const Document& rhs) { return lhs.cells == rhs.cells; }
+
+	struct Text
+	{
+		Text(const char* s) : s(s) {}
+		std::string s;
+	};
+
+	bool operator==(const Text& lhs, const Text& rhs) { return lhs.s == rhs.s; }
+
+	// Copies throw while broken
+	struct Fragile
+	{
+		static bool broken;
+
+		Fragile(int i = 0) : i(i) {}
+		Fragile(const Fragile& other) : i(other.i) { burn(); }
+		Fragile(Fragile&&) noexcept = default;
+		Fragile& operator=(const Fragile& other) { burn(); i = other.i; return *this; }
+		Fragile& operator=(Fragile&&) noexcept = default;
+
+		static void burn()
+		{
+			if (broken)
+			{
+				throw std::runtime_error("copy failed");
+			}
+		}
+
+		int i;
+	};
+
+	bool Fragile::broken = false;
+
+	/// Deltas are the values to restore, applying them throws while broken
+	struct Fragile_diff
+	{
+		using delta_type = int;
+
+		static bool broken;
+
+		static delta_type diff(const Fragile&, const Fragile& to) { return to.i; }
+
+		static void apply(Fragile& value, delta_type delta)
+		{
+			if (broken)
+			{
+				throw std::runtime_error("apply failed");
+			}
+			value.i = delta;
+		}
+	};
+
+	bool Fragile_diff::broken = false;
+
+	/// Replaces the span between the common prefix and the common suffix
+	struct Text_delta
+	{
+		std::size_t prefix;
+		std::size_t erase;
+		std::string insert;
+	};
+}
+
+namespace mixme
+{
+	template <>
+	struct diff_traits<Text>
+	{
+		using delta_type = Text_delta;
+
+		static delta_type diff(const Text& from, const Text& to)
+		{
+			const auto max = std::min(from.s.size(), to.s.size());
+			std::size_t prefix = 0;
+			while (prefix < max && from.s[prefix] == to.s[prefix]) prefix++;
+			std::size_t suffix = 0;
+			while (suffix < max - prefix && from.s[from.s.size() - suffix - 1] == to.s[to.s.size() - suffix - 1]) suffix++;
+			return {prefix, from.s.size() - prefix - suffix, to.s.substr(prefix, to.s.size() - prefix - suffix)};
+		}
+
+		static void apply(Text& value, const delta_type& delta)
+		{
+			value.s.replace(delta.prefix, delta.erase, delta.insert);
+		}
+	};
+}
+
+TEST(DELTA_STORAGE, BYTE_DIFF)
+{
+	unsigned char a[64] = {};
+	unsigned char b[64] = {};
+	b[3] = 1;
+	b[5] = 2;
+	b[40] = 3;
+	const auto delta = mixme::detail::diff_bytes(a, b, sizeof(a));
+	EXPECT_EQ(2u, delta.runs.size()); // close changes are merged
+	EXPECT_EQ(4u, delta.bytes.size());
+	mixme::detail::patch_bytes(a, delta);
+	EXPECT_EQ(0, std::memcmp(a, b, sizeof(a)));
+
+	EXPECT_TRUE(mixme::detail::diff_bytes(a, b, sizeof(a)).runs.empty());
+}
+
+TEST(DELTA_STORAGE, TRIVIALLY_COPYABLE)
+{
+	typedef redoable<Document, delta_storage<Document>> Redo_document_t;
+	Redo_document_t doc;
+
+	std::vector<Document> states;
+	for (int n = 0; n < 10; ++n)
+	{
+		states.push_back(*doc);
+		EXPECT_EQ(true, doc.save());
+		doc->cells[n * 7] = n + 1;
+	}
+	EXPECT_EQ(10u, doc.saves());
+	const Document last = *doc;
+
+	Redo_document_t copy = doc;
+	for (int n = 9; n >= 0; --n)
+	{
+		EXPECT_EQ(true, doc.undo());
+		EXPECT_EQ(states[n], *doc);
+	}
+	EXPECT_EQ(false, doc.undo());
+
+	for (int n = 1; n < 10; ++n)
+	{
+		EXPECT_EQ(true, doc.redo());
+		EXPECT_EQ(states[n], *doc);
+	}
+	EXPECT_EQ(true, doc.redo());
+	EXPECT_EQ(last, *doc);
+
+	// The copy kept its own history
+	EXPECT_EQ(true, copy.undo());
+	EXPECT_EQ(states[9], *copy);
+	EXPECT_EQ(9u, copy.saves());
+}
+
+TEST(DELTA_STORAGE, CUSTOM_TRAITS)
+{
+	typedef undoable<Text, delta_storage<Text>> Undo_text_t;
+	Undo_text_t text("hello world");
+
+	text.save();
+	text->s = "hello brave world";
+	text.save();
+	text->s = "hello brave new world";
+	text.save();
+	text->s = "goodbye";
+
+	Undo_text_t moved = std::move(text);
+	EXPECT_EQ(0u, text.saves());
+	EXPECT_EQ(true, moved.undo());
+	EXPECT_EQ(Text("hello brave new world"), *moved);
+	EXPECT_EQ(true, moved.undo());
+	EXPECT_EQ(Text("hello brave world"), *moved);
+
+	// Saving again after undoing keeps the chain consistent
+	moved->s = "hello cruel world";
+	moved.save();
+	moved->s = "";
+	EXPECT_EQ(true, moved.undo());
+	EXPECT_EQ(Text("hello cruel world"), *moved);
+	EXPECT_EQ(true, moved.undo());
+	EXPECT_EQ(Text("hello world"), *moved);
+	EXPECT_EQ(false, moved.has_save());
+}
+
+TEST(DELTA_STORAGE, EXCEPTION_SAFETY)
+{
+	undoable<Fragile, delta_storage<Fragile, Fragile_diff>> value = Fragile(1);
+	value.save();
+	value->i = 2;
+	value.save();
+	value->i = 3;
+
+	// A failed save leaves the history as it was
+	Fragile::broken = true;
+	EXPECT_THROW(value.save(), std::runtime_error);
+	EXPECT_EQ(2u, value.saves());
+
+	// A failed undo leaves the value and the history as they were
+	EXPECT_THROW(value.undo(), std::runtime_error);
+	Fragile::broken = false;
+	Fragile_diff::broken = true;
+	EXPECT_THROW(value.undo(), std::runtime_error);
+	Fragile_diff::broken = false;
+	EXPECT_EQ(3, value->i);
+	EXPECT_EQ(2u, value.saves());
+
+	EXPECT_EQ(true, value.undo());
+	EXPECT_EQ(2, value->i);
+	EXPECT_EQ(true, value.undo());
+	EXPECT_EQ(1, value->i);
+	EXPECT_EQ(false, value.undo());
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <mixme/wrap/element_undoable.hpp>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace mixme::wrap;
+
+namespace
+{
+	struct Counted
+	{
+		static int copies;
+
+		Counted(int i = 0) : i(i) {}
+		Counted(const Counted& other) : i(other.i) { copies++; }
+		Counted(Counted&&) noexcept = default;
+		Counted& operator=(const Counted& other) { i = other.i; copies++; return *this; }
+		Counted& operator=(Counted&&) noexcept = default;
+
+		int i;
+	};
+
+	int Counted::copies = 0;
+}
+
+TEST(ELEMENT_UNDOABLE, VECTOR)
+{
+	typedef element_undoable<std::vector<Counted>> Undo_vector_t;
+	Undo_vector_t v(std::vector<Counted>(100000));
+	for (int n = 0; n < 100000; ++n)
+	{
+		v.set(n, n);
+	}
+
+	// Saving, undoing and redoing don't copy the vector
+	Counted::copies = 0;
+	EXPECT_EQ(true, v.save());
+	v.set(5, -5);
+	v.push_back(100000);
+	v.insert(0, -1);
+	v.erase(2);
+	EXPECT_EQ(true, v.save());
+	v.pop_back();
+	v.pop_back();
+	EXPECT_EQ(99999u, v.size());
+	EXPECT_EQ(2u, v.saves());
+
+	EXPECT_EQ(true, v.undo());
+	EXPECT_EQ(100001u, v.size());
+	EXPECT_EQ(-1, v[0].i);
+	EXPECT_EQ(0, v[1].i);
+	EXPECT_EQ(2, v[2].i);
+	EXPECT_EQ(-5, v[5].i);
+	EXPECT_EQ(100000, v[100000].i);
+
+	EXPECT_EQ(true, v.undo());
+	EXPECT_EQ(100000u, v.size());
+	for (int n = 0; n < 100000; ++n)
+	{
+		ASSERT_EQ(n, v[n].i);
+	}
+	EXPECT_EQ(false, v.undo());
+
+	EXPECT_EQ(true, v.redo());
+	EXPECT_EQ(true, v.redo());
+	EXPECT_EQ(99999u, v.size());
+	EXPECT_EQ(99998, v[99998].i);
+	EXPECT_EQ(false, v.redo());
+	EXPECT_EQ(0, Counted::copies);
+}
+
+TEST(ELEMENT_UNDOABLE, MAP)
+{
+	typedef element_undoable<std::map<std::string, int>> Undo_map_t;
+	Undo_map_t m;
+	m.set("a", 1);
+	m.set("b", 2);
+	m.save();
+
+	m.set("a", 10);
+	EXPECT_EQ(false, m.insert("b", 20));
+	EXPECT_EQ(true, m.insert("c", 3));
+	EXPECT_EQ(true, m.erase("b"));
+	EXPECT_EQ(false, m.erase("d"));
+	EXPECT_EQ((std::map<std::string, int>{{"a", 10}, {"c", 3}}), *m);
+
+	EXPECT_EQ(true, m.undo());
+	EXPECT_EQ((std::map<std::string, int>{{"a", 1}, {"b", 2}}), *m);
+	EXPECT_EQ(true, m.redo());
+	EXPECT_EQ(10, m.at("a"));
+	EXPECT_EQ(0u, m.count("b"));
+}
+
+TEST(ELEMENT_UNDOABLE, UNORDERED_MAP)
+{
+	typedef element_undoable<std::unordered_map<int, std::string>> Undo_map_t;
+	Undo_map_t m(std::unordered_map<int, std::string>{{1, "one"}});
+	m.save();
+	m.set(2, "two");
+	m.erase(1);
+	m.save();
+	m.set(2, "deux");
+
+	Undo_map_t copy = m;
+	EXPECT_EQ(true, m.undo());
+	EXPECT_EQ("two", m.at(2));
+	EXPECT_EQ(true, m.undo());
+	EXPECT_EQ((std::unordered_map<int, std::string>{{1, "one"}}), *m);
+
+	EXPECT_EQ("deux", copy.at(2));
+	EXPECT_EQ(true, copy.undo());
+	EXPECT_EQ(true, copy.undo());
+	EXPECT_EQ(1u, copy.size());
+}
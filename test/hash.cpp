@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <mixme/gift/hash.hpp>
+
+#ifdef MIXME_HAS_AUTO_TEMPLATE_PARAMETER
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace mixme::gift;
+
+namespace
+{
+	struct Point_fields
+	{
+		std::int32_t x;
+		std::int32_t y;
+	};
+
+	struct Point : Point_fields,
+			comparison::memberwise<Point, &Point_fields::x, &Point_fields::y>,
+			hash<Point>
+	{
+		Point(std::int32_t x, std::int32_t y) : Point_fields{x, y} {}
+	};
+
+	struct Person_fields
+	{
+		std::string name;
+		std::uint16_t id;
+		std::uint16_t group;
+		double height;
+		Point home;
+	};
+
+	struct Person : Person_fields,
+			comparison::memberwise<Person, &Person_fields::name, &Person_fields::id, &Person_fields::group,
+					&Person_fields::height, &Person_fields::home>,
+			hash<Person, &Person_fields::id, &Person_fields::group, &Person_fields::name, &Person_fields::home>
+	{
+		Person(const char* name, std::uint16_t id, double height)
+			: Person_fields{name, id, 7, height, Point(id, -id)} {}
+	};
+
+	/// Compared by its own operator, hashing the members it compares
+	struct Label_fields
+	{
+		std::string text;
+		float weight;
+	};
+
+	struct Label : Label_fields, hash<Label, &Label_fields::text, &Label_fields::weight>
+	{
+		Label(const char* text, float weight) : Label_fields{text, weight} {}
+	};
+
+	bool operator==(const Label& lhs, const Label& rhs) { return lhs.text == rhs.text && lhs.weight == rhs.weight; }
+}
+
+MIXME_GIFT_STD_HASH(Point)
+MIXME_GIFT_STD_HASH(Person)
+
+TEST(HASH, BYTES)
+{
+	const std::string text(200, 'x');
+	std::set<std::uint64_t> hashes;
+	for (std::size_t size = 0; size <= text.size(); ++size)
+	{
+		hashes.insert(mixme::detail::hash_bytes(text.data(), size));
+	}
+	EXPECT_EQ(text.size() + 1, hashes.size());
+
+	// Every single bit flip changes the hash, whatever the length
+	for (std::size_t size : {1, 3, 4, 8, 16, 17, 48, 49, 200})
+	{
+		std::string flipped = text.substr(0, size);
+		const std::uint64_t hash = mixme::detail::hash_bytes(flipped.data(), size);
+		for (std::size_t bit = 0; bit < size * 8; ++bit)
+		{
+			flipped[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+			EXPECT_NE(hash, mixme::detail::hash_bytes(flipped.data(), size));
+			flipped[bit / 8] ^= static_cast<char>(1 << (bit % 8));
+		}
+	}
+	EXPECT_NE(mixme::detail::hash_bytes(text.data(), 8, 1), mixme::detail::hash_bytes(text.data(), 8, 2));
+}
+
+TEST(HASH, BLOCK)
+{
+	// The members are contiguous, hashed as a single block
+	const Point point(3, -4);
+	EXPECT_EQ(mixme::detail::hash_bytes(&point.x, 2 * sizeof(std::int32_t)), point.hash_code());
+	EXPECT_EQ(point.hash_code(), std::hash<Point>{}(point));
+	EXPECT_EQ(Point(3, -4).hash_code(), point.hash_code());
+	EXPECT_NE(Point(-4, 3).hash_code(), point.hash_code());
+}
+
+TEST(HASH, MEMBERS)
+{
+	const Person ada("ada", 1, 1.5);
+	EXPECT_EQ(Person("ada", 1, 1.75).hash_code(), ada.hash_code()); // the height isn't hashed
+	EXPECT_NE(Person("bob", 1, 1.5).hash_code(), ada.hash_code());
+	EXPECT_NE(Person("ada", 2, 1.5).hash_code(), ada.hash_code());
+	EXPECT_EQ(hasher<std::string>{}("ada"), mixme::detail::hash_bytes("ada", 3));
+
+	EXPECT_EQ(Label("a", 0.0f).hash_code(), Label("a", -0.0f).hash_code());
+	EXPECT_NE(Label("a", 1.0f).hash_code(), Label("b", 1.0f).hash_code());
+}
+
+TEST(HASH, UNORDERED)
+{
+	std::unordered_set<Point> points;
+	std::unordered_set<Label, hasher<Label>> labels;
+	for (std::int32_t i = 0; i < 1000; ++i)
+	{
+		points.insert(Point(i % 100, i / 100));
+		points.insert(Point(i % 100, i / 100));
+		labels.insert(Label(std::to_string(i % 10).c_str(), 1.0f));
+	}
+	EXPECT_EQ(1000u, points.size());
+	EXPECT_EQ(10u, labels.size());
+	EXPECT_EQ(1u, points.count(Point(99, 9)));
+	EXPECT_EQ(0u, points.count(Point(100, 9)));
+
+	// Consecutive keys spread over the buckets
+	std::vector<std::size_t> buckets(64);
+	for (std::int32_t i = 0; i < 6400; ++i)
+	{
+		buckets[std::hash<Point>{}(Point(i, 0)) % buckets.size()]++;
+	}
+	for (std::size_t count : buckets)
+	{
+		EXPECT_LT(count, 200u);
+	}
+}
+
+#endif
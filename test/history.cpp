@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <mixme/wrap/history.hpp>
+#include <array>
+#include <string>
+#include <vector>
 
 using namespace mixme::wrap;
 
@@ -318,3 +321,463 @@ TEST(HISTORY, ARRAY_STORAGE)
 	EXPECT_EQ(false, i.has_edit());
 	EXPECT_EQ(0u, i.edits());
 }
+
+TEST(HISTORY, ARRAY_STORAGE_FULL)
+{
+	typedef undoable<int, array_storage<int, 2>> Undo_int_t;
+	Undo_int_t i = 1;
+
+	EXPECT_EQ(true, i.save());
+	i = 2;
+	EXPECT_EQ(true, i.save());
+	i = 3;
+	EXPECT_EQ(false, i.save()); // overwrites the most recent save
+	EXPECT_EQ(2u, i.saves());
+	i = 4;
+
+	const Undo_int_t copy = i;
+	EXPECT_EQ(true, i.undo());
+	EXPECT_EQ(3, i);
+	EXPECT_EQ(true, i.undo());
+	EXPECT_EQ(1, i);
+	EXPECT_EQ(false, i.undo());
+
+	i = copy;
+	EXPECT_EQ(2u, i.saves());
+	EXPECT_EQ(true, i.undo());
+	EXPECT_EQ(3, i);
+}
+
+TEST(HISTORY, RING_STORAGE)
+{
+	typedef redoable<int, ring_storage<int, 3>> Redo_int_t;
+	Redo_int_t i = 0;
+
+	EXPECT_EQ(3u, i.max_saves());
+	EXPECT_EQ(false, i.has_save());
+	for (int n = 1; n <= 3; ++n)
+	{
+		EXPECT_EQ(true, i.save());
+		EXPECT_EQ(static_cast<std::size_t>(n), i.saves());
+		i = n;
+	}
+
+	// Saving on a full history evicts the oldest save
+	EXPECT_EQ(false, i.save());
+	EXPECT_EQ(3u, i.saves());
+	i = 4;
+	EXPECT_EQ(false, i.save());
+	EXPECT_EQ(3u, i.saves());
+	i = 5;
+
+	EXPECT_EQ(true, i.undo());
+	EXPECT_EQ(4, i);
+	EXPECT_EQ(true, i.undo());
+	EXPECT_EQ(3, i);
+	EXPECT_EQ(true, i.undo());
+	EXPECT_EQ(2, i);
+	EXPECT_EQ(false, i.has_save());
+	EXPECT_EQ(false, i.undo());
+	EXPECT_EQ(2, i);
+
+	// Test redo
+	EXPECT_EQ(3u, i.edits());
+	EXPECT_EQ(true, i.redo());
+	EXPECT_EQ(3, i);
+	EXPECT_EQ(true, i.redo());
+	EXPECT_EQ(4, i);
+	EXPECT_EQ(true, i.redo());
+	EXPECT_EQ(5, i);
+	EXPECT_EQ(false, i.has_edit());
+
+	// Copies preserve the order of the saves
+	for (int n = 6; n <= 9; ++n)
+	{
+		i.save();
+		i = n;
+	}
+	Redo_int_t copy = i;
+	EXPECT_EQ(true, copy.undo());
+	EXPECT_EQ(8, copy);
+	EXPECT_EQ(true, copy.undo());
+	EXPECT_EQ(7, copy);
+	EXPECT_EQ(true, copy.undo());
+	EXPECT_EQ(6, copy);
+	EXPECT_EQ(false, copy.undo());
+}
+
+TEST(HISTORY, VECTOR_STORAGE)
+{
+	typedef redoable<Move_only_type, vector_storage<Move_only_type>> Redo_move_only_t;
+	Redo_move_only_t m(1, 2.0f);
+	EXPECT_EQ(true, m.save());
+	m->i = 2;
+	EXPECT_EQ(true, m.save());
+	m->i = 3;
+	EXPECT_EQ(true, m.undo());
+	EXPECT_EQ(Move_only_type(2, 2.0f), *m);
+	EXPECT_EQ(true, m.undo());
+	EXPECT_EQ(Move_only_type(1, 2.0f), *m);
+	EXPECT_EQ(true, m.redo());
+	EXPECT_EQ(Move_only_type(2, 2.0f), *m);
+
+	typedef redoable<std::string, vector_storage<std::string>> Redo_string_t;
+	Redo_string_t s = std::string("0");
+	s.reserve(100);
+	for (int n = 1; n <= 100; ++n)
+	{
+		EXPECT_EQ(true, s.save());
+		s = std::to_string(n);
+	}
+	EXPECT_EQ(100u, s.saves());
+
+	const Redo_string_t copy = s;
+	Redo_string_t moved = std::move(s);
+	EXPECT_EQ(0u, s.saves());
+	EXPECT_EQ(100u, copy.saves());
+	EXPECT_EQ(100u, moved.saves());
+
+	for (int n = 99; n >= 0; --n)
+	{
+		EXPECT_EQ(true, moved.undo());
+		EXPECT_EQ(std::to_string(n), *moved);
+	}
+	EXPECT_EQ(false, moved.undo());
+	EXPECT_EQ(100u, moved.edits());
+	moved.shrink_to_fit();
+	EXPECT_EQ(true, moved.redo());
+	EXPECT_EQ("1", *moved);
+	EXPECT_EQ(99u, moved.edits());
+
+	// Saving discards the edits, which don't follow from the new state
+	moved = std::string("branch");
+	EXPECT_EQ(true, moved.save());
+	EXPECT_EQ(0u, moved.edits());
+	EXPECT_EQ(false, moved.redo());
+	EXPECT_EQ(true, moved.undo());
+	EXPECT_EQ("branch", *moved);
+	EXPECT_EQ(1u, moved.edits());
+}
+
+#ifdef MIXME_HAS_MEMORY_RESOURCE
+namespace
+{
+	class Counting_resource : public std::pmr::memory_resource
+	{
+	public:
+		std::size_t allocations = 0;
+	private:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override
+		{
+			++allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+		{
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	};
+}
+
+TEST(HISTORY, VECTOR_STORAGE_PMR)
+{
+	typedef redoable<int, pmr::vector_storage<int>> Redo_int_t;
+	Counting_resource resource;
+	Redo_int_t i(std::allocator_arg, &resource, 0);
+
+	i.reserve(16);
+	const auto warm = resource.allocations;
+	EXPECT_EQ(2u, warm);
+	for (int n = 1; n <= 16; ++n)
+	{
+		i.save();
+		i = n;
+	}
+	for (int n = 15; n >= 0; --n)
+	{
+		EXPECT_EQ(true, i.undo());
+		EXPECT_EQ(n, i);
+	}
+	EXPECT_EQ(true, i.redo());
+	EXPECT_EQ(1, i);
+	EXPECT_EQ(warm, resource.allocations);
+
+	// Copies select the default resource, moves keep the original one
+	Redo_int_t copy = i;
+	EXPECT_EQ(warm, resource.allocations);
+	EXPECT_EQ(true, copy.redo());
+	EXPECT_EQ(2, copy);
+	Redo_int_t moved = std::move(i);
+	EXPECT_EQ(true, moved.save());
+	EXPECT_EQ(warm, resource.allocations);
+}
+#endif
+
+namespace
+{
+	struct Copy_counted
+	{
+		static int copies;
+
+		Copy_counted(int i = 0) : i(i) {}
+		Copy_counted(const Copy_counted& other) : i(other.i) { copies++; }
+		Copy_counted(Copy_counted&&) noexcept = default;
+		Copy_counted& operator=(const Copy_counted& other) { i = other.i; copies++; return *this; }
+		Copy_counted& operator=(Copy_counted&&) noexcept = default;
+
+		int i;
+	};
+
+	int Copy_counted::copies = 0;
+
+	template <typename T>
+	void test_undo_moves()
+	{
+		T value = Copy_counted(0);
+		for (int n = 1; n <= 3; ++n)
+		{
+			value.save();
+			value->i = n;
+		}
+
+		// Only saving copies: the value is moved to the edits when undoing
+		Copy_counted::copies = 0;
+		EXPECT_EQ(true, value.undo());
+		EXPECT_EQ(2, value->i);
+		EXPECT_EQ(true, value.undo());
+		EXPECT_EQ(1, value->i);
+		EXPECT_EQ(true, value.redo());
+		EXPECT_EQ(2, value->i);
+		EXPECT_EQ(true, value.undo());
+		EXPECT_EQ(0, value->i);
+		EXPECT_EQ(true, value.redo());
+		EXPECT_EQ(2, value->i);
+		EXPECT_EQ(true, value.redo());
+		EXPECT_EQ(3, value->i);
+		EXPECT_EQ(false, value.redo());
+		EXPECT_EQ(0, Copy_counted::copies);
+	}
+}
+
+TEST(HISTORY, UNDO_MOVES)
+{
+	test_undo_moves<redoable<Copy_counted, array_storage<Copy_counted, 3>>>();
+	test_undo_moves<redoable<Copy_counted, ring_storage<Copy_counted, 3>>>();
+	test_undo_moves<redoable<Copy_counted, vector_storage<Copy_counted>>>();
+
+	redoable<Copy_counted> single = Copy_counted(0);
+	single.save();
+	single->i = 1;
+	Copy_counted::copies = 0;
+	EXPECT_EQ(true, single.undo());
+	EXPECT_EQ(0, single->i);
+	EXPECT_EQ(true, single.redo());
+	EXPECT_EQ(1, single->i);
+	EXPECT_EQ(0, Copy_counted::copies);
+}
+
+namespace
+{
+	struct Default_counted
+	{
+		static int defaults;
+
+		Default_counted() : text("default") { defaults++; }
+		Default_counted(const std::string& text) : text(text) {}
+
+		std::string text;
+	};
+
+	int Default_counted::defaults = 0;
+
+	template <typename T>
+	void test_clear_edits()
+	{
+		T value = Default_counted("a");
+		value.save();
+		value->text = "b";
+		value.save();
+		value->text = "c";
+		EXPECT_EQ(true, value.undo());
+		EXPECT_EQ(true, value.undo());
+		EXPECT_EQ(2u, value.edits());
+
+		// Saving drops the edits, releasing only the stored ones
+		Default_counted::defaults = 0;
+		value->text = "d";
+		value.save();
+		EXPECT_EQ(0u, value.edits());
+		EXPECT_EQ(false, value.redo());
+		EXPECT_LE(Default_counted::defaults, 2);
+		EXPECT_EQ(true, value.undo());
+		EXPECT_EQ("d", value->text);
+		EXPECT_EQ(1u, value.edits());
+	}
+}
+
+TEST(HISTORY, CLEAR_EDITS)
+{
+	test_clear_edits<redoable<Default_counted, array_storage<Default_counted, 64>>>();
+	test_clear_edits<redoable<Default_counted, ring_storage<Default_counted, 64>>>();
+	test_clear_edits<redoable<Default_counted, vector_storage<Default_counted>>>();
+}
+
+namespace
+{
+	struct Relocatable : mixme::gift::trivially_relocatable<Relocatable>
+	{
+		static int moves;
+		static int live;
+
+		Relocatable(int i = 0) : i(new int(i)) { live++; }
+		Relocatable(const Relocatable& other) : i(new int(*other.i)) { live++; }
+		Relocatable(Relocatable&& other) noexcept : i(std::move(other.i)) { live++; moves++; }
+		Relocatable& operator=(const Relocatable& other) { i.reset(new int(*other.i)); return *this; }
+		Relocatable& operator=(Relocatable&& other) noexcept { i = std::move(other.i); moves++; return *this; }
+		~Relocatable() { live--; }
+
+		std::unique_ptr<int> i;
+	};
+
+	int Relocatable::moves = 0;
+	int Relocatable::live = 0;
+
+	template <typename T>
+	void test_relocation()
+	{
+		{
+			T value = Relocatable(0);
+			value.save();
+			*value->i = 1;
+			value.save();
+			*value->i = 2;
+
+			// Undo and redo relocate the elements instead of moving them
+			Relocatable::moves = 0;
+			EXPECT_EQ(true, value.undo());
+			EXPECT_EQ(1, *value->i);
+			EXPECT_EQ(true, value.redo());
+			EXPECT_EQ(2, *value->i);
+			value.save();
+			*value->i = 3;
+			EXPECT_EQ(true, value.undo());
+			EXPECT_EQ(2, *value->i);
+			EXPECT_EQ(0, Relocatable::moves);
+
+			// Only the current value is moved with the history
+			T moved = std::move(value);
+			EXPECT_EQ(1, Relocatable::moves);
+			EXPECT_EQ(2, *moved->i);
+			EXPECT_EQ(true, moved.redo());
+			EXPECT_EQ(3, *moved->i);
+			value = std::move(moved);
+			EXPECT_EQ(3, *value->i);
+		}
+		// Every element was destroyed once
+		EXPECT_EQ(0, Relocatable::live);
+	}
+}
+
+TEST(HISTORY, RELOCATION)
+{
+	test_relocation<redoable<Relocatable>>();
+	test_relocation<redoable<Relocatable, array_storage<Relocatable, 3>>>();
+	test_relocation<redoable<Relocatable, ring_storage<Relocatable, 3>>>();
+
+	base<Relocatable> one(1), two(2);
+	Relocatable::moves = 0;
+	swap(one, two);
+	EXPECT_EQ(2, *one->i);
+	EXPECT_EQ(1, *two->i);
+	EXPECT_EQ(0, Relocatable::moves);
+}
+
+#ifdef MIXME_HAS_CONSTEXPR_HISTORY
+namespace
+{
+	typedef std::array<int, 8> Board_t; // column of the queen on each row
+
+	template <typename History>
+	constexpr int place_queens(History& board, int row, int n)
+	{
+		if (row == n)
+		{
+			return 1;
+		}
+		int solutions = 0;
+		for (int column = 0; column < n; ++column)
+		{
+			bool safe = true;
+			for (int other = 0; other < row; ++other)
+			{
+				const int distance = (*board)[other] - column;
+				safe = safe && distance != 0 && distance != other - row && distance != row - other;
+			}
+			if (safe)
+			{
+				board.save();
+				(*board)[row] = column;
+				solutions += place_queens(board, row + 1, n);
+				board.undo();
+			}
+		}
+		return solutions;
+	}
+
+	template <typename History>
+	constexpr int count_queens(int n)
+	{
+		History board = Board_t{};
+		return place_queens(board, 0, n);
+	}
+
+	struct Literal_type
+	{
+		constexpr Literal_type(int i = 0) : i(i) {}
+		constexpr Literal_type(const Literal_type& other) : i(other.i) {}
+		constexpr Literal_type& operator=(const Literal_type& other) { i = other.i; return *this; }
+		int i;
+	};
+
+	template <typename History>
+	constexpr int undo_redo()
+	{
+		History value = Literal_type(1);
+		value.save();
+		value = Literal_type(2);
+		value.save();
+		value = Literal_type(3);
+		value.undo();
+		value.undo();
+		const int undone = value->i;
+		value.redo();
+		value.redo();
+		return undone * 10 + value->i;
+	}
+}
+
+TEST(HISTORY, CONSTEXPR)
+{
+	static_assert(count_queens<undoable<Board_t, array_storage<Board_t, 8>>>(6) == 4, "");
+	static_assert(count_queens<redoable<Board_t, ring_storage<Board_t, 8>>>(8) == 92, "");
+	static_assert(undo_redo<redoable<Literal_type, array_storage<Literal_type, 2>>>() == 13, "");
+	static_assert(undo_redo<redoable<Literal_type, ring_storage<Literal_type, 2>>>() == 13, "");
+
+	constexpr redoable<int> single = []
+	{
+		redoable<int> value = 1;
+		value.save();
+		value = 2;
+		value.undo();
+		value.redo();
+		return value;
+	}();
+	static_assert(*single == 2 && !single.has_save() && !single.has_edit(), "");
+
+	EXPECT_EQ(4, (count_queens<undoable<Board_t, array_storage<Board_t, 8>>>(6)));
+	EXPECT_EQ(13, (undo_redo<redoable<Literal_type, array_storage<Literal_type, 2>>>()));
+}
+#endif
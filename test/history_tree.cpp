@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <mixme/wrap/history_tree.hpp>
+#include <string>
+
+using namespace mixme::wrap;
+
+TEST(HISTORY_TREE, BRANCHES)
+{
+	typedef history_tree<std::string> Tree_t;
+	Tree_t text = std::string("a");
+	const Tree_t& view = text;
+	const Tree_t::node_id root = text.current();
+	EXPECT_EQ(false, text.undo());
+	EXPECT_EQ(false, text.redo());
+
+	*text = "ab";
+	const Tree_t::node_id ab = text.save();
+	EXPECT_NE(root, ab);
+	EXPECT_EQ(ab, text.save());
+	*text = "abc";
+	EXPECT_EQ(true, text.dirty());
+
+	// Undoing saves the modifications first
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ("ab", *view);
+	EXPECT_EQ(false, text.dirty());
+	const Tree_t::node_id abc = text.children(ab).front();
+	EXPECT_EQ("abc", text.state(abc));
+
+	// A new branch keeps the old one
+	*text = "abd";
+	const Tree_t::node_id abd = text.save();
+	EXPECT_EQ(4u, text.size());
+	EXPECT_EQ(2u, text.children(ab).size());
+	EXPECT_EQ(ab, text.parent(abd));
+
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ(true, text.redo(0));
+	EXPECT_EQ("abc", *view);
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ(true, text.redo());
+	EXPECT_EQ("abc", *view);
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ(false, text.redo(2));
+	EXPECT_EQ(true, text.redo(1));
+	EXPECT_EQ("abd", *view);
+
+	EXPECT_EQ(true, text.go_to(root));
+	EXPECT_EQ("a", *view);
+	EXPECT_EQ(true, text.redo());
+	EXPECT_EQ("ab", *view);
+	EXPECT_EQ(true, text.redo());
+	EXPECT_EQ("abd", *view);
+	EXPECT_EQ(false, text.go_to(1000));
+}
+
+TEST(HISTORY_TREE, SHARING)
+{
+	typedef history_tree<std::string> Tree_t;
+	Tree_t text = std::string("a");
+	const Tree_t& view = text;
+	*text = "b";
+	const Tree_t::node_id b = text.save();
+
+	// Moving around shares the states instead of copying them
+	EXPECT_EQ(&text.state(b), &*view);
+	text.undo();
+	text.redo();
+	EXPECT_EQ(&text.state(b), &*view);
+
+	// Mutable access copies
+	text->append("c");
+	EXPECT_NE(&text.state(b), &*view);
+	EXPECT_EQ("b", text.state(b));
+
+	Tree_t copy = text;
+	copy->append("d");
+	EXPECT_EQ("bc", *view);
+	EXPECT_EQ("bcd", *static_cast<const Tree_t&>(copy));
+	// The pending modifications are saved before moving to the parent
+	copy.undo();
+	EXPECT_EQ("b", *static_cast<const Tree_t&>(copy));
+	EXPECT_EQ(&copy.state(copy.current()), &*static_cast<const Tree_t&>(copy));
+}
+
+TEST(HISTORY_TREE, PRUNING)
+{
+	typedef history_tree<int, max_nodes<4>> Tree_t;
+	Tree_t value = 0;
+	const Tree_t::node_id root = value.root();
+	*value = 1;
+	const Tree_t::node_id one = value.save();
+	*value = 2;
+	const Tree_t::node_id two = value.save();
+	value.undo();
+	*value = 3;
+	const Tree_t::node_id three = value.save();
+	EXPECT_EQ(4u, value.size());
+
+	// The least recently visited branch goes first
+	value.undo();
+	*value = 4;
+	value.save();
+	EXPECT_EQ(4u, value.size());
+	EXPECT_EQ(false, value.contains(two));
+	EXPECT_EQ(true, value.contains(three));
+
+	// Then the oldest states of the current branch
+	*value = 5;
+	value.save();
+	EXPECT_EQ(4u, value.size());
+	EXPECT_EQ(false, value.contains(three));
+	*value = 6;
+	value.save();
+	EXPECT_EQ(false, value.contains(root));
+	EXPECT_EQ(one, value.root());
+	EXPECT_EQ(Tree_t::no_node, value.parent(one));
+
+	while (value.undo())
+	{
+	}
+	EXPECT_EQ(1, static_cast<const Tree_t&>(value).value());
+}
+
+TEST(HISTORY_TREE, PRUNING_ABANDONED_BRANCHES)
+{
+	typedef history_tree<int, max_nodes<5>> Tree_t;
+	Tree_t value = 0;
+	const Tree_t::node_id root = value.root();
+	*value = 1;
+	const Tree_t::node_id one = value.save();
+	*value = 2;
+	const Tree_t::node_id two = value.save();
+	value.go_to(root);
+	*value = 3;
+	const Tree_t::node_id three = value.save();
+
+	// The copy keeps its own order of the branches
+	Tree_t copy = value;
+	value = Tree_t(0);
+
+	*copy = 4;
+	copy.save();
+	*copy = 5;
+	copy.save();
+	EXPECT_EQ(5u, copy.size());
+	EXPECT_EQ(false, copy.contains(two));
+	EXPECT_EQ(true, copy.contains(one));
+
+	// Dropping its only child made one a leaf, older than the current branch
+	*copy = 6;
+	copy.save();
+	EXPECT_EQ(5u, copy.size());
+	EXPECT_EQ(false, copy.contains(one));
+	EXPECT_EQ(root, copy.root());
+	EXPECT_EQ(1u, copy.children(root).size());
+	EXPECT_EQ(three, copy.children(root).front());
+
+	copy.go_to(root);
+	EXPECT_EQ(true, copy.redo());
+	EXPECT_EQ(three, copy.current());
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <mixme/wrap/history.hpp>
+#include <mixme/wrap/instrumentation.hpp>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mixme::wrap;
+
+namespace
+{
+	std::uint64_t samples(const latency_histogram& histogram)
+	{
+		return std::accumulate(histogram.begin(), histogram.end(), std::uint64_t(0));
+	}
+}
+
+TEST(INSTRUMENTATION, DISABLED)
+{
+	undoable<int> value = 1;
+	value.save();
+	value.undo();
+	const history_stats stats = value.stats();
+	EXPECT_EQ(0u, stats.saves);
+	EXPECT_EQ(0u, stats.undos);
+	EXPECT_TRUE(std::is_empty<no_instrumentation>::value);
+}
+
+TEST(INSTRUMENTATION, COUNTERS)
+{
+	typedef redoable<int, array_storage<int, 2>, counting_instrumentation> Redo_int_t;
+	Redo_int_t value = 1;
+
+	EXPECT_EQ(true, value.save());
+	EXPECT_EQ(true, value.save());
+	EXPECT_EQ(false, value.save());
+	EXPECT_EQ(true, value.undo());
+	EXPECT_EQ(true, value.redo());
+	EXPECT_EQ(false, value.redo());
+
+	const history_stats stats = value.stats();
+	EXPECT_EQ(3u, stats.saves);
+	EXPECT_EQ(1u, stats.undos);
+	EXPECT_EQ(1u, stats.redos);
+	EXPECT_EQ(1u, stats.dropped);
+	EXPECT_EQ(sizeof(int), stats.estimated_history_bytes);
+	EXPECT_EQ(3u, samples(stats.save_latency));
+	EXPECT_EQ(1u, samples(stats.undo_latency));
+	EXPECT_EQ(1u, samples(stats.redo_latency));
+
+	// Copies count from scratch
+	Redo_int_t copy = value;
+	EXPECT_EQ(0u, copy.stats().saves);
+	copy = value;
+	EXPECT_EQ(0u, copy.stats().saves);
+}
+
+TEST(INSTRUMENTATION, REGISTRY)
+{
+	instrumentation_registry& registry = instrumentation_registry::instance();
+	const std::size_t instances = registry.size();
+	const history_stats before = registry.total();
+	{
+		undoable<std::string, vector_storage<std::string>, counting_instrumentation> first = std::string("a");
+		redoable<int, single_element_storage<int>, counting_instrumentation> second = 1;
+		EXPECT_EQ(instances + 2, registry.size());
+
+		first.save();
+		first.save();
+		second.save();
+		second.undo();
+
+		const history_stats total = registry.total();
+		EXPECT_EQ(before.saves + 3, total.saves);
+		EXPECT_EQ(before.undos + 1, total.undos);
+		EXPECT_EQ(2 * sizeof(std::string) + sizeof(int), total.estimated_history_bytes - before.estimated_history_bytes);
+
+		std::size_t visited = 0;
+		registry.for_each([&visited](const history_stats&) { visited++; });
+		EXPECT_EQ(instances + 2, visited);
+	}
+	EXPECT_EQ(instances, registry.size());
+
+	// The counters of the destroyed instances stay in the totals
+	const history_stats after = registry.total();
+	EXPECT_EQ(before.saves + 3, after.saves);
+	EXPECT_EQ(before.undos + 1, after.undos);
+	EXPECT_EQ(before.estimated_history_bytes, after.estimated_history_bytes);
+}
+
+TEST(INSTRUMENTATION, CONCURRENT_REGISTRATION)
+{
+	typedef undoable<int, single_element_storage<int>, counting_instrumentation> Undo_int_t;
+	instrumentation_registry& registry = instrumentation_registry::instance();
+	const std::size_t instances = registry.size();
+	const history_stats before = registry.total();
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+	{
+		threads.emplace_back([] {
+			for (int n = 0; n < 1000; ++n)
+			{
+				Undo_int_t value = n;
+				value.save();
+			}
+		});
+	}
+	for (int n = 0; n < 100; ++n)
+	{
+		registry.total();
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	EXPECT_EQ(instances, registry.size());
+	EXPECT_EQ(before.saves + 4000, registry.total().saves);
+}
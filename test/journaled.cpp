@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <mixme/wrap/journaled.hpp>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace mixme::wrap;
+
+namespace
+{
+	typedef std::vector<int> Vector_t;
+
+	struct Push_back;
+
+	struct Pop_back
+	{
+		Push_back operator()(Vector_t& v) const;
+	};
+
+	struct Push_back
+	{
+		int value;
+
+		Pop_back operator()(Vector_t& v) const
+		{
+			v.push_back(value);
+			return Pop_back{};
+		}
+	};
+
+	Push_back Pop_back::operator()(Vector_t& v) const
+	{
+		const int value = v.back();
+		v.pop_back();
+		return Push_back{value};
+	}
+
+	struct Set
+	{
+		std::size_t index;
+		int value;
+
+		Set operator()(Vector_t& v) const
+		{
+			Set inverse{index, v[index]};
+			v[index] = value;
+			return inverse;
+		}
+	};
+
+	// Too big to be stored inline
+	struct Fill
+	{
+		std::array<int, 16> values;
+
+		Fill operator()(Vector_t& v) const
+		{
+			Fill inverse;
+			for (std::size_t n = 0; n < values.size(); ++n)
+			{
+				inverse.values[n] = v[n];
+				v[n] = values[n];
+			}
+			return inverse;
+		}
+	};
+
+	struct Fail
+	{
+		Fail operator()(Vector_t&) const
+		{
+			throw std::runtime_error("fail");
+		}
+	};
+}
+
+TEST(JOURNALED, UNDO_REDO)
+{
+	typedef journaled<Vector_t> Journal_t;
+	Journal_t v(3, 0);
+
+	EXPECT_EQ(false, v.undo());
+	EXPECT_EQ(false, v.redo());
+
+	// Nothing to undo to: the inverse isn't recorded
+	v.execute(Push_back{1});
+	EXPECT_EQ(0u, v.journal_size());
+
+	v.save();
+	v.execute(Set{0, 5});
+	v.execute(Push_back{2});
+	v.save();
+	v.execute(Pop_back{});
+	v.execute(Pop_back{});
+	EXPECT_EQ(2u, v.saves());
+	EXPECT_EQ(6u, v.journal_size());
+	EXPECT_EQ(Vector_t({5, 0, 0}), *v);
+
+	EXPECT_EQ(true, v.undo());
+	EXPECT_EQ(Vector_t({5, 0, 0, 1, 2}), *v);
+	EXPECT_EQ(true, v.undo());
+	EXPECT_EQ(Vector_t({0, 0, 0, 1}), *v);
+	EXPECT_EQ(false, v.undo());
+	EXPECT_EQ(2u, v.edits());
+
+	EXPECT_EQ(true, v.redo());
+	EXPECT_EQ(Vector_t({5, 0, 0, 1, 2}), *v);
+	EXPECT_EQ(true, v.redo());
+	EXPECT_EQ(Vector_t({5, 0, 0}), *v);
+	EXPECT_EQ(false, v.redo());
+
+	EXPECT_EQ(true, v.undo());
+	v.execute(Set{1, 7});
+	EXPECT_EQ(false, v.has_edit());
+	EXPECT_EQ(false, v.redo());
+	EXPECT_EQ(true, v.undo());
+	EXPECT_EQ(Vector_t({0, 0, 0, 1}), *v);
+}
+
+TEST(JOURNALED, SAVES)
+{
+	journaled<Vector_t> v(Vector_t(16, 0));
+	v.save();
+	v.save();
+	EXPECT_EQ(2u, v.saves());
+	EXPECT_EQ(true, v.undo());
+	EXPECT_EQ(true, v.undo());
+	EXPECT_EQ(Vector_t(16, 0), *v);
+	EXPECT_EQ(true, v.redo());
+	EXPECT_EQ(true, v.redo());
+
+	Fill fill;
+	for (int n = 0; n < 16; ++n)
+	{
+		fill.values[n] = n;
+	}
+	v.execute(fill);
+	v.save();
+	v.execute(Set{3, 42});
+	EXPECT_THROW(v.execute(Fail{}), std::runtime_error);
+	EXPECT_EQ(42, (*v)[3]);
+
+	// Copies own their journal
+	journaled<Vector_t> copy = v;
+	EXPECT_EQ(true, v.undo());
+	EXPECT_EQ(3, (*v)[3]);
+	EXPECT_EQ(true, v.undo());
+	EXPECT_EQ(Vector_t(16, 0), *v);
+	EXPECT_EQ(42, (*copy)[3]);
+	EXPECT_EQ(3u, copy.saves());
+
+	journaled<Vector_t> moved = std::move(copy);
+	EXPECT_EQ(false, copy.undo());
+	EXPECT_EQ(true, moved.undo());
+	EXPECT_EQ(true, moved.undo());
+	EXPECT_EQ(Vector_t(16, 0), *moved);
+	EXPECT_EQ(true, moved.redo());
+	EXPECT_EQ(15, (*moved)[15]);
+
+	swap(v, moved);
+	EXPECT_EQ(15, (*v)[15]);
+	EXPECT_EQ(true, v.redo());
+	EXPECT_EQ(42, (*v)[3]);
+}
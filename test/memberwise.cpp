@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <mixme/gift/memberwise.hpp>
+
+#ifdef MIXME_HAS_AUTO_TEMPLATE_PARAMETER
+
+#include <mixme/detail/check/comparison.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+
+using namespace mixme::gift;
+
+namespace
+{
+	struct Tag_fields
+	{
+		unsigned char kind;
+		std::array<unsigned char, 7> name;
+	};
+
+	struct Tag : Tag_fields, comparison::memberwise<Tag, &Tag_fields::kind, &Tag_fields::name>
+	{
+		Tag(unsigned char kind, unsigned char first) : Tag_fields{kind, {first, 'a', 'b'}} {}
+	};
+
+	typedef comparison::detail::memberwise_layout<Tag, &Tag_fields::kind, &Tag_fields::name> Tag_layout_t;
+
+	struct Id_fields
+	{
+		std::uint32_t high;
+		std::uint32_t low;
+	};
+
+	struct Id : Id_fields, comparison::memberwise<Id, &Id_fields::high, &Id_fields::low>
+	{
+		Id(std::uint32_t high, std::uint32_t low) : Id_fields{high, low} {}
+	};
+
+	typedef comparison::detail::memberwise_layout<Id, &Id_fields::high, &Id_fields::low> Id_layout_t;
+
+	struct Low_first : Id_fields, comparison::memberwise<Low_first, &Id_fields::low, &Id_fields::high>
+	{
+		Low_first(std::uint32_t high, std::uint32_t low) : Id_fields{high, low} {}
+	};
+
+	struct Person_fields
+	{
+		std::string name;
+		char code[4];
+		double height;
+		Tag tag;
+	};
+
+	struct Person : Person_fields,
+			comparison::memberwise<Person, &Person_fields::name, &Person_fields::code, &Person_fields::height,
+					&Person_fields::tag>
+	{
+		Person(const char* name, const char* code, double height, unsigned char kind)
+			: Person_fields{name, {code[0], code[1], code[2], code[3]}, height, Tag(kind, 'x')} {}
+	};
+
+	template <typename T>
+	void test_order(const T& one, const T& two)
+	{
+		EXPECT_TRUE(one == one);
+		EXPECT_FALSE(one == two);
+		EXPECT_TRUE(one != two);
+		EXPECT_FALSE(one != one);
+		EXPECT_TRUE(one < two);
+		EXPECT_FALSE(two < one);
+		EXPECT_FALSE(one < one);
+		EXPECT_TRUE(one <= two);
+		EXPECT_TRUE(one <= one);
+		EXPECT_FALSE(two <= one);
+		EXPECT_TRUE(two > one);
+		EXPECT_FALSE(one > two);
+		EXPECT_TRUE(two >= one);
+		EXPECT_TRUE(two >= two);
+		EXPECT_FALSE(one >= two);
+		EXPECT_LT(one.compare(two), 0);
+		EXPECT_GT(two.compare(one), 0);
+		EXPECT_EQ(0, one.compare(one));
+	}
+}
+
+TEST(MEMBERWISE, CHECKS)
+{
+	using namespace mixme::detail::check::comparison;
+	EXPECT_EQ(true, eq<Tag>{}());
+	EXPECT_EQ(true, ne<Tag>{}());
+	EXPECT_EQ(true, lt<Tag>{}());
+	EXPECT_EQ(true, le<Tag>{}());
+	EXPECT_EQ(true, gt<Tag>{}());
+	EXPECT_EQ(true, ge<Tag>{}());
+	EXPECT_EQ(true, compare<Person>{}());
+}
+
+TEST(MEMBERWISE, BYTES)
+{
+	EXPECT_TRUE(Tag_layout_t::equal);
+	EXPECT_TRUE(Tag_layout_t::ordered);
+	EXPECT_EQ(8u, Tag_layout_t::size);
+
+	Tag one(1, 'z'), two(2, 'a');
+	EXPECT_NE(nullptr, Tag_layout_t::contiguous(one));
+	test_order(one, two);
+	test_order(Tag(1, 'a'), Tag(1, 'b'));
+}
+
+TEST(MEMBERWISE, INTEGERS)
+{
+	EXPECT_TRUE(Id_layout_t::equal);
+	EXPECT_NE(nullptr, Id_layout_t::contiguous(Id(0, 0)));
+
+	// Little endian bytes of 1 compare greater than the ones of 256
+	test_order(Id(0, 1), Id(0, 256));
+	test_order(Id(1, 0x7fffffff), Id(2, 0));
+	test_order(Low_first(2, 0), Low_first(1, 1));
+}
+
+TEST(MEMBERWISE, MEMBERS)
+{
+	test_order(Person("ada", "abc", 1.5, 0), Person("bob", "abc", 1.5, 0));
+	test_order(Person("ada", "abb", 1.5, 0), Person("ada", "abc", 1.5, 0));
+	test_order(Person("ada", "abc", 1.5, 0), Person("ada", "abc", 1.75, 0));
+	test_order(Person("ada", "abc", 1.5, 0), Person("ada", "abc", 1.5, 1));
+}
+
+#endif
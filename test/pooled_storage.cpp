@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <mixme/wrap/history.hpp>
+#include <mixme/wrap/pooled_storage.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mixme::wrap;
+
+namespace
+{
+	struct Component
+	{
+		Component(int i = 0) : i(i) {}
+		int i;
+		double payload[7] = {};
+	};
+}
+
+TEST(POOLED_STORAGE, UNDO_REDO)
+{
+	typedef redoable<std::string, pooled_storage<std::string, 3>> Redo_string_t;
+	Redo_string_t s = std::string("a");
+
+	EXPECT_EQ(3u, s.max_saves());
+	EXPECT_EQ(false, s.has_save());
+	for (const char* next : {"b", "c", "d"})
+	{
+		EXPECT_EQ(true, s.save());
+		s = std::string(next);
+	}
+	EXPECT_EQ(3u, s.saves());
+	EXPECT_EQ(false, s.save()); // overwrites the most recent save
+	s = std::string("e");
+
+	Redo_string_t copy = s;
+	Redo_string_t moved = std::move(s);
+	EXPECT_EQ(0u, s.saves());
+	EXPECT_EQ(3u, copy.saves());
+
+	EXPECT_EQ(true, moved.undo());
+	EXPECT_EQ("d", *moved);
+	EXPECT_EQ(true, moved.undo());
+	EXPECT_EQ("b", *moved);
+	EXPECT_EQ(true, moved.undo());
+	EXPECT_EQ("a", *moved);
+	EXPECT_EQ(false, moved.undo());
+	EXPECT_EQ(true, moved.redo());
+	EXPECT_EQ("b", *moved);
+
+	copy = moved;
+	EXPECT_EQ(0u, copy.saves());
+	EXPECT_EQ(2u, copy.edits());
+	EXPECT_EQ(true, copy.redo());
+	EXPECT_EQ("d", *copy);
+}
+
+TEST(POOLED_STORAGE, DEEP_COPY)
+{
+	// Deep enough to overflow the stack if copies recursed once per node
+	constexpr std::size_t depth = 1000000;
+	typedef undoable<int, pooled_storage<int, depth>> Undo_int_t;
+	Undo_int_t i = 0;
+	for (std::size_t n = 1; n <= depth; ++n)
+	{
+		i.save();
+		i = static_cast<int>(n);
+	}
+
+	Undo_int_t copy = i;
+	EXPECT_EQ(depth, copy.saves());
+	EXPECT_EQ(true, copy.undo());
+	EXPECT_EQ(static_cast<int>(depth - 1), *copy);
+	copy = i;
+	EXPECT_EQ(depth, copy.saves());
+}
+
+TEST(POOLED_STORAGE, FOOTPRINT)
+{
+	typedef undoable<Component, pooled_storage<Component>> Undo_component_t;
+#if defined(__has_cpp_attribute)
+#if __has_cpp_attribute(no_unique_address)
+	EXPECT_EQ(sizeof(Component) + sizeof(void*), sizeof(Undo_component_t));
+#endif
+#endif
+
+	std::vector<Undo_component_t> entities(10000);
+	for (std::size_t n = 0; n < entities.size(); n += 100)
+	{
+		entities[n].save();
+		entities[n]->i = static_cast<int>(n);
+	}
+	for (std::size_t n = 0; n < entities.size(); n += 100)
+	{
+		EXPECT_EQ(true, entities[n].undo());
+		EXPECT_EQ(0, entities[n]->i);
+	}
+}
+
+TEST(POOLED_STORAGE, THREADS)
+{
+	typedef undoable<Component, pooled_storage<Component, 4>> Undo_component_t;
+	std::vector<Undo_component_t> produced(1000);
+	for (auto& value : produced)
+	{
+		value.save();
+	}
+
+	// Saves released by another thread return to the shared pool when it exits
+	std::thread consumer([&produced]()
+	{
+		for (auto& value : produced)
+		{
+			value->i = 1;
+			value.undo();
+		}
+		std::vector<Undo_component_t> local(1000);
+		for (auto& value : local)
+		{
+			value.save();
+			value.save();
+		}
+	});
+	consumer.join();
+
+	for (const auto& value : produced)
+	{
+		EXPECT_EQ(0, value->i);
+		EXPECT_EQ(false, value.has_save());
+	}
+}
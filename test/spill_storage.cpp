@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <mixme/wrap/history.hpp>
+#include <mixme/wrap/spill_storage.hpp>
+
+#ifdef MIXME_HAS_MMAP
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace mixme::wrap;
+
+namespace
+{
+	typedef std::array<std::uint64_t, 64> Block_t;
+
+	struct Text_traits
+	{
+		static void serialize(const std::string& value, std::vector<unsigned char>& out)
+		{
+			out.insert(out.end(), value.begin(), value.end());
+		}
+
+		static void deserialize(const unsigned char* data, std::size_t size, std::string& value)
+		{
+			value.assign(reinterpret_cast<const char*>(data), size);
+		}
+	};
+
+	struct Failing_traits
+	{
+		static bool fail;
+
+		static void serialize(const std::string& value, std::vector<unsigned char>& out)
+		{
+			if (fail)
+			{
+				throw std::runtime_error("serialization failed");
+			}
+			Text_traits::serialize(value, out);
+		}
+
+		static void deserialize(const unsigned char* data, std::size_t size, std::string& value)
+		{
+			Text_traits::deserialize(data, size, value);
+		}
+	};
+
+	bool Failing_traits::fail = false;
+}
+
+TEST(SPILL_STORAGE, DEEP_HISTORY)
+{
+	typedef undoable<Block_t, spill_storage<Block_t, 100000, 4>> Undo_block_t;
+	Undo_block_t block;
+	block->fill(0);
+
+	const std::uint64_t depth = 20000;
+	for (std::uint64_t n = 1; n <= depth; ++n)
+	{
+		block->fill(n);
+		EXPECT_EQ(true, block.save());
+	}
+	EXPECT_EQ(depth, block.saves());
+	// Only the most recent elements are in memory
+	EXPECT_EQ(4 * sizeof(Block_t), block.bytes_used());
+
+	for (std::uint64_t n = depth; n > 0; --n)
+	{
+		ASSERT_EQ(true, block.undo());
+		EXPECT_EQ(n, block->front());
+		EXPECT_EQ(n, block->back());
+	}
+	EXPECT_EQ(false, block.undo());
+	EXPECT_EQ(0u, block.saves());
+}
+
+TEST(SPILL_STORAGE, EVICTION)
+{
+	typedef redoable<int, spill_storage<int, 1000, 0>> Redo_int_t;
+	Redo_int_t value = 0;
+
+	// The evicted elements are compacted away as the file grows
+	for (int n = 1; n <= 50000; ++n)
+	{
+		*value = n;
+		value.save();
+	}
+	EXPECT_EQ(1000u, value.saves());
+
+	for (int n = 50000; n > 49000; --n)
+	{
+		ASSERT_EQ(true, value.undo());
+		EXPECT_EQ(n, *value);
+	}
+	EXPECT_EQ(false, value.undo());
+
+	for (int n = 49002; n <= 50000; ++n)
+	{
+		ASSERT_EQ(true, value.redo());
+		EXPECT_EQ(n, *value);
+	}
+	// The first undo stored the unmodified value too
+	EXPECT_EQ(true, value.redo());
+	EXPECT_EQ(50000, *value);
+	EXPECT_EQ(false, value.redo());
+}
+
+TEST(SPILL_STORAGE, CUSTOM_TRAITS)
+{
+	typedef redoable<std::string, spill_storage<std::string, 8, 1, Text_traits>> Redo_text_t;
+	Redo_text_t text("a");
+	text.save();
+	*text = std::string(100000, 'b');
+	text.save();
+	*text = "c";
+	text.save();
+	*text = "d";
+
+	Redo_text_t copy = text;
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ(true, copy.undo());
+	EXPECT_EQ("c", *copy);
+	EXPECT_EQ(true, copy.undo());
+	EXPECT_EQ(std::string(100000, 'b'), *copy);
+	EXPECT_EQ(true, copy.undo());
+	EXPECT_EQ("a", *copy);
+	EXPECT_EQ(false, copy.undo());
+	EXPECT_EQ(true, copy.redo());
+	EXPECT_EQ(true, copy.redo());
+	EXPECT_EQ(true, copy.redo());
+	EXPECT_EQ("d", *copy);
+
+	Redo_text_t moved = std::move(text);
+	EXPECT_EQ(true, moved.undo());
+	EXPECT_EQ("a", *moved);
+	EXPECT_EQ(false, moved.undo());
+}
+
+TEST(SPILL_STORAGE, EMPTY_RECORDS)
+{
+	// Empty strings spill no bytes, so the file is never mapped
+	typedef redoable<std::string, spill_storage<std::string, 8, 1, Text_traits>> Redo_text_t;
+	Redo_text_t text;
+	for (int n = 0; n < 4; ++n)
+	{
+		text.save();
+	}
+	*text = "a";
+
+	Redo_text_t copy = text;
+	for (int n = 0; n < 4; ++n)
+	{
+		EXPECT_EQ(true, copy.undo());
+		EXPECT_EQ("", *copy);
+	}
+	EXPECT_EQ(false, copy.undo());
+
+	// Then records with bytes follow the empty ones
+	text.save();
+	*text = "b";
+	text.save();
+	*text = "c";
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ("b", *text);
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ("a", *text);
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ("", *text);
+	EXPECT_EQ(3u, text.saves());
+}
+
+TEST(SPILL_STORAGE, FAILED_SAVE)
+{
+	typedef redoable<std::string, spill_storage<std::string, 3, 1, Failing_traits>> Redo_text_t;
+	Redo_text_t text("a");
+	for (const char* next : {"b", "c"})
+	{
+		text.save();
+		*text = next;
+	}
+
+	// A failed save leaves the history as it was
+	Failing_traits::fail = true;
+	EXPECT_THROW(text.save(), std::runtime_error);
+	Failing_traits::fail = false;
+	EXPECT_EQ(2u, text.saves());
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ("b", *text);
+	EXPECT_EQ(true, text.undo());
+	EXPECT_EQ("a", *text);
+	EXPECT_EQ(false, text.undo());
+}
+
+#endif
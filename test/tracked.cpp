@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <mixme/wrap/tracked.hpp>
+
+#ifdef MIXME_HAS_AUTO_TEMPLATE_PARAMETER
+
+#include <string>
+
+using namespace mixme::wrap;
+
+namespace
+{
+	struct Counted
+	{
+		static int copies;
+
+		Counted(int i = 0) : i(i) {}
+		Counted(const Counted& other) : i(other.i) { copies++; }
+		Counted(Counted&&) noexcept = default;
+		Counted& operator=(const Counted& other) { i = other.i; copies++; return *this; }
+		Counted& operator=(Counted&&) noexcept = default;
+		int i;
+	};
+
+	int Counted::copies = 0;
+
+	struct Config
+	{
+		Counted width;
+		Counted height;
+		Counted depth;
+		std::string name;
+	};
+
+	typedef tracked<Config, &Config::width, &Config::height, &Config::depth, &Config::name> Tracked_config_t;
+}
+
+TEST(TRACKED, DIRTY_MEMBERS)
+{
+	Tracked_config_t config;
+	EXPECT_EQ(false, config.dirty());
+	EXPECT_EQ(false, config.undo());
+
+	config.set<&Config::width>(Counted(10));
+	EXPECT_EQ(true, config.dirty<&Config::width>());
+	EXPECT_EQ(false, config.dirty<&Config::height>());
+	EXPECT_EQ(10, config.get<&Config::width>().i);
+
+	// Saving and undoing copy the dirty member only
+	Counted::copies = 0;
+	EXPECT_EQ(true, config.save());
+	EXPECT_EQ(1, Counted::copies);
+	EXPECT_EQ(false, config.dirty());
+
+	config.modify<&Config::height>([](Counted& height) { height.i = 20; });
+	config.set<&Config::name>("box");
+	Counted::copies = 0;
+	EXPECT_EQ(true, config.save());
+	EXPECT_EQ(1, Counted::copies);
+	EXPECT_EQ(2u, config.saves());
+
+	config.set<&Config::width>(Counted(30));
+	Counted::copies = 0;
+	EXPECT_EQ(true, config.undo());
+	EXPECT_EQ(1, Counted::copies);
+	EXPECT_EQ(10, config->width.i);
+	EXPECT_EQ(20, config->height.i);
+	EXPECT_EQ("box", config->name);
+	EXPECT_EQ(true, config.dirty<&Config::height>());
+	EXPECT_EQ(false, config.dirty<&Config::width>());
+
+	EXPECT_EQ(true, config.undo());
+	EXPECT_EQ(10, config->width.i);
+	EXPECT_EQ(0, config->height.i);
+	EXPECT_EQ("", config->name);
+	EXPECT_EQ(false, config.undo());
+}
+
+TEST(TRACKED, SAVE_AFTER_UNDO)
+{
+	Tracked_config_t config;
+	config.set<&Config::depth>(Counted(1));
+	config.save();
+	config.set<&Config::depth>(Counted(2));
+	config.save();
+	config.set<&Config::name>("changed");
+
+	EXPECT_EQ(true, config.undo());
+	EXPECT_EQ(2, config->depth.i);
+	EXPECT_EQ("", config->name);
+	config.save();
+	EXPECT_EQ(2u, config.saves());
+
+	config.set<&Config::depth>(Counted(3));
+	EXPECT_EQ(true, config.undo());
+	EXPECT_EQ(2, config->depth.i);
+	EXPECT_EQ(true, config.undo());
+	EXPECT_EQ(1, config->depth.i);
+	EXPECT_EQ(false, config.undo());
+}
+
+TEST(TRACKED, ASSIGN)
+{
+	Config initial;
+	initial.width = Counted(1);
+	Tracked_config_t config = initial;
+	config.save();
+
+	Config other;
+	other.name = "other";
+	config = other;
+	EXPECT_EQ(true, config.dirty<&Config::width>());
+	EXPECT_EQ(true, config.dirty<&Config::name>());
+	config.save();
+	EXPECT_EQ(true, config.undo());
+	EXPECT_EQ("other", config->name);
+	EXPECT_EQ(true, config.undo());
+	EXPECT_EQ(1, config->width.i);
+	EXPECT_EQ("", config->name);
+}
+
+#endif
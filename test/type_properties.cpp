@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <mixme/gift/type_properties.hpp>
+#include <string>
 
 using namespace mixme::gift;
 
@@ -8,6 +9,16 @@ namespace
 	struct Copy : copy_only {};
 	struct Move : move_only {};
 	struct No : no_copy_or_move {};
+	struct Handle : trivially_relocatable<Handle>
+	{
+		Handle(Handle&&) {}
+		~Handle() {}
+	};
+
+	struct Named_handle : Handle
+	{
+		std::string name;
+	};
 }
 
 TEST(TYPE_PROPERTIES, NO_COPY_OR_MOVE)
@@ -33,3 +44,13 @@ TEST(TYPE_PROPERTIES, MOVE_ONLY)
     EXPECT_TRUE(std::is_move_assignable<Move>::value);
     EXPECT_TRUE(std::is_move_constructible<Move>::value);
 }
+
+TEST(TYPE_PROPERTIES, TRIVIALLY_RELOCATABLE)
+{
+    EXPECT_TRUE(is_trivially_relocatable<int>::value);
+    EXPECT_TRUE(is_trivially_relocatable<Move>::value);
+    EXPECT_TRUE(is_trivially_relocatable<Handle>::value);
+    // The declaration isn't inherited
+    EXPECT_FALSE(is_trivially_relocatable<Named_handle>::value);
+    EXPECT_FALSE(is_trivially_relocatable<std::string>::value);
+}